@@ -0,0 +1,137 @@
+/*
+ * Per-call cost of the parser in each build mode.
+ *
+ * Build and run with `make bench-inline`. The same loops are compiled against
+ * the library objects, with link time optimization, and with the single
+ * header `yuarel_single.h` in YUAREL_STATIC mode, so that only the way the
+ * parser reaches the caller differs.
+ */
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef BENCH_SINGLE
+#define YUAREL_STATIC
+#include "yuarel_single.h"
+#else
+#include <yuarel.h>
+#endif
+
+#define CORPUS_SIZE 4096
+
+static char *corpus[CORPUS_SIZE];
+static size_t corpus_len[CORPUS_SIZE];
+
+static double now_sec(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* Short URLs, as found in logs, where the cost of the call itself shows */
+static void corpus_init(void)
+{
+    static const char *hosts[] = {"example.com", "www.example.org", "cdn.static.example.net", "api.example.io"};
+    static const char *paths[] = {"", "index.html", "a/b/c/d", "api/v1/users/12345/items"};
+    static const char *queries[] = {"", "?q=yes", "?utm_source=news&id=42", "?a=1&b=2&c=3"};
+    int i;
+
+    for (i = 0; i < CORPUS_SIZE; i++)
+    {
+        char buf[256];
+        int n = snprintf(buf, sizeof(buf), "%s://%s/%s%s", (i & 1) ? "https" : "http", hosts[i % 4],
+                         paths[(i / 4) % 4], queries[(i / 16) % 4]);
+        corpus[i] = malloc(n + 1);
+        memcpy(corpus[i], buf, n + 1);
+        corpus_len[i] = n;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    static const char *names[] = {"(copy only)", "yuarel_parse", "yuarel_parse_host", "yuarel_split_path",
+                                  "yuarel_parse_query", "yuarel_url_decode"};
+    static const char *paths[] = {"a", "a/b", "api/v1/users", "static/js/app.min.js"};
+    static const char *queries[] = {"q=yes", "a=1&b=2", "utm_source=news&id=42", "x=%20y&z=a+b"};
+    const int iterations = 8000000;
+    struct yuarel_param params[8];
+    struct yuarel url;
+    char *parts[8];
+    char work[256];
+    double copy = 0;
+    int mode, i;
+
+    corpus_init();
+
+    printf("inline: %s build, %d short inputs x %d\n", argc > 1 ? argv[1] : "this", CORPUS_SIZE, iterations);
+    printf("  %-20s %12s\n", "function", "ns/call");
+
+    for (mode = 0; mode < 6; mode++)
+    {
+        double start = now_sec();
+        double elapsed;
+        long total = 0;
+
+        for (i = 0; i < iterations; i++)
+        {
+            int k = i & (CORPUS_SIZE - 1);
+            const char *src;
+
+            switch (mode)
+            {
+                case 3:
+                    src = paths[k & 3];
+                    break;
+                case 4:
+                case 5:
+                    src = queries[k & 3];
+                    break;
+                default:
+                    src = corpus[k];
+                    break;
+            }
+            strcpy(work, src);
+
+            switch (mode)
+            {
+                case 1:
+                    total += yuarel_parse(&url, work);
+                    break;
+                case 2:
+                    total += yuarel_parse_host(&url, work);
+                    break;
+                case 3:
+                    total += yuarel_split_path(work, parts, 8);
+                    break;
+                case 4:
+                    total += yuarel_parse_query(work, '&', params, 8);
+                    break;
+                case 5:
+                    total += yuarel_url_decode(work)[0];
+                    break;
+                default:
+                    total += work[0];
+                    break;
+            }
+        }
+
+        elapsed = (now_sec() - start) / iterations * 1e9;
+        if (0 == mode)
+        {
+            copy = elapsed;
+            printf("  %-20s %12.1f\n", names[mode], elapsed);
+        }
+        else
+        {
+            /* The copy is the same in every build, leave it out */
+            printf("  %-20s %12.1f\n", names[mode], elapsed - copy);
+        }
+        (void)total;
+    }
+
+    return 0;
+}
@@ -0,0 +1,1575 @@
+/*
+ * Micro benchmarks for libyuarel.
+ *
+ * Build and run with `make bench`. Every benchmark works on a synthetic
+ * corpus of URLs so results are reproducible without external data.
+ */
+#define _POSIX_C_SOURCE 200809L
+
+#include <ctype.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <yuarel.h>
+#include <yuarel_arena.h>
+#include <yuarel_form.h>
+#include <yuarel_idna.h>
+#include <yuarel_intern.h>
+#include <yuarel_matcher.h>
+#include <yuarel_psl.h>
+#include <yuarel_query.h>
+#include <yuarel_rewrite.h>
+#include <yuarel_stream.h>
+#include <yuarel_template.h>
+#include <yuarel_utf8.h>
+
+#define CORPUS_SIZE 4096
+#define BATCH_SIZE 1024
+
+static char *corpus[CORPUS_SIZE];
+static size_t corpus_len[CORPUS_SIZE];
+
+static double now_sec(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void corpus_init(void)
+{
+    static const char *hosts[] = {"example.com", "www.example.org", "cdn.static.example.net", "[2001:db8::1]", "user:pass@api.example.io"};
+    static const char *paths[] = {"", "index.html", "a/b/c/d", "api/v1/users/12345/items", "static/js/app.min.js"};
+    static const char *queries[] = {"", "?q=yes", "?utm_source=news&utm_medium=email&id=42", "?a=1&b=2&c=3&d=4&e=5&f=6&g=7&h=8"};
+    int i;
+
+    for (i = 0; i < CORPUS_SIZE; i++)
+    {
+        char buf[512];
+        int n = snprintf(buf, sizeof(buf), "%s://%s:%d/%s%s#frag%d",
+                         (i & 1) ? "https" : "http",
+                         hosts[i % 5],
+                         8000 + i % 100,
+                         paths[(i / 5) % 5],
+                         queries[(i / 25) % 4],
+                         i);
+        corpus[i] = malloc(n + 1);
+        memcpy(corpus[i], buf, n + 1);
+        corpus_len[i] = n;
+    }
+}
+
+/*
+ * Arena vs malloc copies
+ */
+
+struct copy_job
+{
+    int use_arena;
+    int iterations;
+    long parsed;
+};
+
+static void *copy_worker(void *arg)
+{
+    struct copy_job *job = arg;
+    struct yuarel_arena arena;
+    struct yuarel url;
+    char *batch[BATCH_SIZE];
+    int it, i;
+
+    yuarel_arena_init(&arena, 0);
+
+    for (it = 0; it < job->iterations; it++)
+    {
+        for (i = 0; i < CORPUS_SIZE; i++)
+        {
+            int b = i % BATCH_SIZE;
+
+            if (job->use_arena)
+            {
+                if (0 == yuarel_parse_copy(&arena, corpus[i], corpus_len[i], &url))
+                {
+                    job->parsed++;
+                }
+                if (BATCH_SIZE - 1 == b)
+                {
+                    yuarel_arena_reset(&arena);
+                }
+                continue;
+            }
+
+            batch[b] = strdup(corpus[i]);
+            if (0 == yuarel_parse(&url, batch[b]))
+            {
+                job->parsed++;
+            }
+            if (BATCH_SIZE - 1 == b)
+            {
+                int j;
+                for (j = 0; j < BATCH_SIZE; j++)
+                {
+                    free(batch[j]);
+                }
+            }
+        }
+    }
+
+    yuarel_arena_free(&arena);
+    return NULL;
+}
+
+static void bench_arena(void)
+{
+    static const int thread_counts[] = {1, 2, 4, 8};
+    const int iterations = 200;
+    int t, mode;
+
+    printf("arena: parse copies of %d URLs x %d, batches of %d\n", CORPUS_SIZE, iterations, BATCH_SIZE);
+    printf("  %-8s %-8s %12s\n", "threads", "copy", "Murl/s");
+
+    for (t = 0; t < 4; t++)
+    {
+        for (mode = 0; mode < 2; mode++)
+        {
+            pthread_t threads[8];
+            struct copy_job jobs[8];
+            long parsed = 0;
+            double start, elapsed;
+            int i, n = thread_counts[t];
+
+            start = now_sec();
+            for (i = 0; i < n; i++)
+            {
+                jobs[i].use_arena = mode;
+                jobs[i].iterations = iterations;
+                jobs[i].parsed = 0;
+                pthread_create(&threads[i], NULL, copy_worker, &jobs[i]);
+            }
+            for (i = 0; i < n; i++)
+            {
+                pthread_join(threads[i], NULL);
+                parsed += jobs[i].parsed;
+            }
+            elapsed = now_sec() - start;
+
+            printf("  %-8d %-8s %12.2f\n", n, mode ? "arena" : "strdup", parsed / elapsed / 1e6);
+        }
+    }
+}
+
+/*
+ * Lazy component parsing on long tracking URLs
+ */
+
+static void bench_lazy(void)
+{
+    static const char *names[] = {"yuarel_parse", "yuarel_parse_host", "yuarel_parse_path", "(copy only)"};
+    const int iterations = 2000000;
+    char url[2048];
+    char work[2048];
+    size_t len;
+    int mode, i;
+
+    len = (size_t)snprintf(url, sizeof(url), "https://tracker.example.com:443/click/v2/redirect?");
+    for (i = 0; len < 1500; i++)
+    {
+        len += (size_t)snprintf(url + len, sizeof(url) - len, "%sutm_param%d=value%%20%d", i ? "&" : "", i, i * 7919);
+    }
+    len += (size_t)snprintf(url + len, sizeof(url) - len, "#section-%d", i);
+
+    printf("lazy: %zu byte tracking URL x %d (copy + parse)\n", len, iterations);
+    printf("  %-20s %12s\n", "function", "ns/url");
+
+    for (mode = 0; mode < 4; mode++)
+    {
+        struct yuarel parsed;
+        double start = now_sec();
+        long ok = 0;
+
+        for (i = 0; i < iterations; i++)
+        {
+            memcpy(work, url, len + 1);
+            switch (mode)
+            {
+                case 0:
+                    ok += 0 == yuarel_parse(&parsed, work);
+                    break;
+                case 1:
+                    ok += 0 == yuarel_parse_host(&parsed, work);
+                    break;
+                case 2:
+                    ok += 0 == yuarel_parse_path(&parsed, work);
+                    break;
+                default:
+                    ok++;
+                    break;
+            }
+        }
+
+        printf("  %-20s %12.1f%s\n", names[mode], (now_sec() - start) / iterations * 1e9, ok == iterations ? "" : " (errors)");
+    }
+}
+
+/*
+ * Streaming parser vs reassembling TCP segments
+ */
+
+static void bench_stream(void)
+{
+    const int iterations = 1000000;
+    const size_t segment = 64;
+    char url[2048];
+    char work[2048];
+    size_t len = 0;
+    int mode, i;
+
+    len = (size_t)snprintf(url, sizeof(url), "http://proxy.example.com/objects/bucket/key?");
+    for (i = 0; len < 1500; i++)
+    {
+        len += (size_t)snprintf(url + len, sizeof(url) - len, "%sp%d=%d", i ? "&" : "", i, i * 31);
+    }
+
+    printf("stream: %zu byte URL in %zu byte segments x %d\n", len, segment, iterations);
+    printf("  %-20s %12s\n", "method", "ns/url");
+
+    for (mode = 0; mode < 2; mode++)
+    {
+        double start = now_sec();
+        long ok = 0;
+
+        for (i = 0; i < iterations; i++)
+        {
+            size_t off;
+
+            if (0 == mode)
+            {
+                struct yuarel parsed;
+
+                /* Reassemble the segments, then parse */
+                for (off = 0; off < len; off += segment)
+                {
+                    memcpy(work + off, url + off, (len - off < segment) ? len - off : segment);
+                }
+                work[len] = '\0';
+                ok += 0 == yuarel_parse(&parsed, work);
+            }
+            else
+            {
+                struct yuarel_stream stream;
+                int rc = 0;
+
+                yuarel_stream_init(&stream);
+                for (off = 0; off < len; off += segment)
+                {
+                    rc |= yuarel_stream_feed(&stream, url + off, (len - off < segment) ? len - off : segment);
+                }
+                ok += 0 == rc && 0 == yuarel_stream_finish(&stream);
+            }
+        }
+
+        printf("  %-20s %12.1f%s\n", mode ? "yuarel_stream_feed" : "reassemble + parse", (now_sec() - start) / iterations * 1e9, ok == iterations ? "" : " (errors)");
+    }
+}
+
+/*
+ * Registrable domain lookup, trie vs a sorted set of suffix strings
+ */
+
+static int str_cmp(const void *a, const void *b)
+{
+    return strcmp(*(const char *const *)a, *(const char *const *)b);
+}
+
+static void bench_psl(void)
+{
+    static const char *tlds[] = {"com", "net", "org", "uk", "jp", "de", "io", "br", "au", "fr"};
+    static const char *dat_filename = "bench_psl.dat";
+    static const char *blob_filename = "bench_psl.yup";
+    const int iterations = 2000000;
+    const int rule_count = 9000;
+    char **rules;
+    char hosts[64][128];
+    struct yuarel_psl psl;
+    FILE *fp;
+    int mode, i;
+
+    /* Synthetic list of second and third level suffixes below a few tlds */
+    rules = malloc(rule_count * sizeof(char *));
+    fp = fopen(dat_filename, "w");
+    for (i = 0; i < rule_count; i++)
+    {
+        char buf[64];
+
+        if (i < 10)
+        {
+            snprintf(buf, sizeof(buf), "%s", tlds[i]);
+        }
+        else if (i % 3)
+        {
+            snprintf(buf, sizeof(buf), "s%d.%s", i, tlds[i % 10]);
+        }
+        else
+        {
+            snprintf(buf, sizeof(buf), "p%d.s%d.%s", i, i - 1, tlds[(i - 1) % 10]);
+        }
+        rules[i] = strdup(buf);
+        fprintf(fp, "%s\n", buf);
+    }
+    fclose(fp);
+    qsort(rules, rule_count, sizeof(char *), str_cmp);
+
+    if (yuarel_psl_compile(dat_filename, blob_filename) < 0 || 0 != yuarel_psl_open(&psl, blob_filename))
+    {
+        printf("psl: failed to compile the list\n");
+        return;
+    }
+
+    for (i = 0; i < 64; i++)
+    {
+        /* Rules s<n>.<tld> exist for n % 3 != 0 */
+        int n = 11 + i * 3;
+        snprintf(hosts[i], sizeof(hosts[i]), "www.cdn%d.site%d.s%d.%s", i, i * 7, n, tlds[n % 10]);
+    }
+
+    printf("psl: %d rules, %d lookups\n", rule_count, iterations);
+    printf("  %-28s %12s\n", "method", "ns/host");
+
+    for (mode = 0; mode < 2; mode++)
+    {
+        double start = now_sec();
+        long ok = 0;
+
+        for (i = 0; i < iterations; i++)
+        {
+            const char *host = hosts[i & 63];
+
+            if (0 == mode)
+            {
+                struct yuarel_span domain;
+                ok += 0 == yuarel_registrable_domain(&psl, host, strlen(host), &domain);
+            }
+            else
+            {
+                /* Longest listed suffix, trying each one in the set */
+                const char *p = host;
+                const char *prev = NULL;
+
+                while (NULL != p)
+                {
+                    if (NULL != bsearch(&p, rules, rule_count, sizeof(char *), str_cmp))
+                    {
+                        ok += NULL != prev;
+                        break;
+                    }
+                    prev = p;
+                    p = strchr(p, '.');
+                    p = (NULL != p) ? p + 1 : NULL;
+                }
+            }
+        }
+
+        printf("  %-28s %12.1f%s\n", mode ? "sorted set of suffixes" : "yuarel_registrable_domain", (now_sec() - start) / iterations * 1e9, ok == iterations ? "" : " (errors)");
+    }
+
+    yuarel_psl_close(&psl);
+    remove(dat_filename);
+    remove(blob_filename);
+    for (i = 0; i < rule_count; i++)
+    {
+        free(rules[i]);
+    }
+    free(rules);
+}
+
+/*
+ * Tracking parameter removal, filter vs parse + strcmp + snprintf
+ */
+
+static void bench_filter(void)
+{
+    static const char *deny[] = {"fbclid", "gclid", "msclkid", "mc_eid", "_hsenc"};
+    const int iterations = 2000000;
+    const char *query = "id=42&utm_source=newsletter&utm_medium=email&page=3&fbclid=IwAR2xyz&utm_campaign=spring&sort=asc&gclid=Cj0KCQ";
+    struct yuarel_filter_node nodes[128];
+    struct yuarel_filter filter;
+    size_t len = strlen(query);
+    char work[256];
+    int mode, i;
+
+    yuarel_filter_init(&filter, nodes, 128, YUAREL_FILTER_KEEP);
+    yuarel_filter_add(&filter, "utm_", YUAREL_FILTER_PREFIX, YUAREL_FILTER_DROP);
+    for (i = 0; i < 5; i++)
+    {
+        yuarel_filter_add(&filter, deny[i], YUAREL_FILTER_EXACT, YUAREL_FILTER_DROP);
+    }
+
+    printf("filter: %zu byte query, %d rules x %d\n", len, 6, iterations);
+    printf("  %-28s %12s\n", "method", "ns/query");
+
+    for (mode = 0; mode < 2; mode++)
+    {
+        double start = now_sec();
+        long total = 0;
+
+        for (i = 0; i < iterations; i++)
+        {
+            memcpy(work, query, len + 1);
+
+            if (0 == mode)
+            {
+                total += yuarel_query_filter(&filter, work, '&');
+            }
+            else
+            {
+                struct yuarel_param params[32];
+                char out[256];
+                int n = yuarel_parse_query(work, '&', params, 32);
+                int used = 0;
+                int j, k;
+
+                for (j = 0; j < n; j++)
+                {
+                    int drop = 0 == strncmp(params[j].key, "utm_", 4);
+
+                    for (k = 0; k < 5 && !drop; k++)
+                    {
+                        drop = 0 == strcmp(params[j].key, deny[k]);
+                    }
+                    if (!drop)
+                    {
+                        used += snprintf(out + used, sizeof(out) - used, "%s%s%s%s", used ? "&" : "", params[j].key,
+                                         params[j].val ? "=" : "", params[j].val ? params[j].val : "");
+                    }
+                }
+                total += used;
+            }
+        }
+
+        printf("  %-28s %12.1f (%ld)\n", mode ? "parse + strcmp + snprintf" : "yuarel_query_filter", (now_sec() - start) / iterations * 1e9, total / iterations);
+    }
+}
+
+/*
+ * Query splitting, one vector pass vs strchr() for the delimiter and '='
+ */
+
+static int strchr_parse_query(char *query, char delimiter, struct yuarel_param *params, int max_params)
+{
+    int n = 0;
+
+    while (n < max_params)
+    {
+        char *end = strchr(query, delimiter);
+        char *eq;
+
+        if (NULL != end)
+        {
+            *end = '\0';
+        }
+        params[n].key = query;
+        eq = strchr(query, '=');
+        if (NULL != eq)
+        {
+            *eq = '\0';
+        }
+        params[n++].val = (NULL != eq) ? eq + 1 : NULL;
+        if (NULL == end)
+        {
+            break;
+        }
+        query = end + 1;
+    }
+
+    return n;
+}
+
+static void bench_query(void)
+{
+    static const char *names[] = {"strchr loop", "yuarel_parse_query_ex", "  + YUAREL_QUERY_DECODE", "strchr loop + url_decode"};
+    const int iterations = 1000000;
+    struct yuarel_param params[256];
+    char query[2048];
+    char work[2048];
+    size_t len = 0;
+    int mode, i;
+
+    for (i = 0; len < 1500; i++)
+    {
+        len += (size_t)snprintf(query + len, sizeof(query) - len, "%sutm_param%d=value%%20%d", i ? "&" : "", i, i * 7919);
+    }
+
+    printf("query: %zu byte query with %d parameters x %d\n", len, i, iterations);
+    printf("  %-28s %12s\n", "function", "ns/query");
+
+    for (mode = 0; mode < 4; mode++)
+    {
+        double start = now_sec();
+        long total = 0;
+
+        for (i = 0; i < iterations; i++)
+        {
+            memcpy(work, query, len + 1);
+            if (1 == mode || 2 == mode)
+            {
+                total += yuarel_parse_query_ex(work, "&", params, 256, (2 == mode) ? YUAREL_QUERY_DECODE : 0);
+            }
+            else
+            {
+                int n = strchr_parse_query(work, '&', params, 256);
+                int j;
+
+                for (j = 0; 3 == mode && j < n; j++)
+                {
+                    yuarel_url_decode(params[j].key);
+                    if (NULL != params[j].val)
+                    {
+                        yuarel_url_decode(params[j].val);
+                    }
+                }
+                total += n;
+            }
+        }
+
+        printf("  %-28s %12.1f\n", names[mode], (now_sec() - start) / iterations * 1e9);
+        (void)total;
+    }
+}
+
+/*
+ * Path splitting of deep object store keys
+ */
+
+static int strchr_split_path(char *path, char **parts, int max_parts)
+{
+    int i = 0;
+
+    do
+    {
+        while ('/' == *path)
+        {
+            path++;
+        }
+        if ('\0' == *path)
+        {
+            break;
+        }
+        parts[i++] = path;
+        path = strchr(path, '/');
+        if (NULL == path)
+        {
+            break;
+        }
+        *(path++) = '\0';
+    } while (i < max_parts);
+
+    return i;
+}
+
+static void bench_path(void)
+{
+    static const char *names[] = {"strchr loop", "yuarel_split_path", "strchr loop + strlen", "yuarel_split_path_ex"};
+    const int iterations = 2000000;
+    char *parts[64];
+    size_t lengths[64];
+    char path[512];
+    char work[512];
+    size_t len = 0;
+    int mode, i;
+
+    for (i = 0; i < 24; i++)
+    {
+        len += (size_t)snprintf(path + len, sizeof(path) - len, "/segment%d", i * 37);
+    }
+
+    printf("path: %zu byte path with 24 segments x %d\n", len, iterations);
+    printf("  %-28s %12s\n", "function", "ns/path");
+
+    for (mode = 0; mode < 4; mode++)
+    {
+        double start = now_sec();
+        size_t total = 0;
+
+        for (i = 0; i < iterations; i++)
+        {
+            int n, j;
+
+            memcpy(work, path, len + 1);
+            switch (mode)
+            {
+                case 0:
+                    total += strchr_split_path(work, parts, 64);
+                    break;
+                case 1:
+                    total += yuarel_split_path(work, parts, 64);
+                    break;
+                case 2:
+                    n = strchr_split_path(work, parts, 64);
+                    for (j = 0; j < n; j++)
+                    {
+                        total += strlen(parts[j]);
+                    }
+                    break;
+                default:
+                    n = yuarel_split_path_ex(work, parts, lengths, 64);
+                    for (j = 0; j < n; j++)
+                    {
+                        total += lengths[j];
+                    }
+                    break;
+            }
+        }
+
+        printf("  %-28s %12.1f\n", names[mode], (now_sec() - start) / iterations * 1e9);
+        (void)total;
+    }
+}
+
+/*
+ * Parsing and decoding in one pass, on URLs that are not in the cache
+ */
+
+static void bench_decode(void)
+{
+    static const char *names[] = {"yuarel_parse + url_decode", "yuarel_parse_ex"};
+    const int count = 65536;
+    const size_t flush_size = 64 << 20;
+    struct yuarel_param params[16];
+    struct yuarel url;
+    char *urls = malloc((size_t)count * 256);
+    char *work = malloc((size_t)count * 256);
+    char *flush = malloc(flush_size);
+    size_t *offsets = malloc(count * sizeof(size_t));
+    size_t len = 0;
+    int mode, round, i;
+
+    for (i = 0; i < count; i++)
+    {
+        offsets[i] = len;
+        len += (size_t)snprintf(urls + len, 256, "https://www.example.com/docs/My%%20Documents/report%%20%d/%s/summary%%20%%28final%%29.pdf?title=Annual+Report&author=J%%C3%%B6rg&id=%d#page%%3D%d",
+                                i, (i & 1) ? "plain/segments/without/escapes" : "x", i * 7919, i % 100) +
+               1;
+    }
+
+    printf("decode: %d urls, %zu bytes, evicted from the cache before each run\n", count, len);
+    printf("  %-28s %12s\n", "function", "ns/url");
+
+    for (mode = 0; mode < 2; mode++)
+    {
+        double best = 0;
+
+        for (round = 0; round < 5; round++)
+        {
+            double start;
+            long total = 0;
+
+            memcpy(work, urls, len);
+            memset(flush, round, flush_size);
+
+            start = now_sec();
+            for (i = 0; i < count; i++)
+            {
+                char *str = work + offsets[i];
+                int n, j;
+
+                if (0 == mode)
+                {
+                    yuarel_parse(&url, str);
+                    yuarel_url_decode(url.path);
+                    yuarel_url_decode(url.fragment);
+                    n = yuarel_parse_query(url.query, '&', params, 16);
+                    for (j = 0; j < n; j++)
+                    {
+                        yuarel_url_decode(params[j].key);
+                        if (NULL != params[j].val)
+                        {
+                            yuarel_url_decode(params[j].val);
+                        }
+                    }
+                }
+                else
+                {
+                    yuarel_parse_ex(&url, str, YUAREL_DECODE_PATH | YUAREL_DECODE_FRAGMENT);
+                    n = yuarel_parse_query_ex(url.query, "&", params, 16, YUAREL_QUERY_DECODE);
+                }
+                total += n;
+            }
+
+            if (0 == round || now_sec() - start < best)
+            {
+                best = now_sec() - start;
+            }
+            (void)total;
+        }
+
+        printf("  %-28s %12.1f\n", names[mode], best / count * 1e9);
+    }
+
+    free(offsets);
+    free(flush);
+    free(work);
+    free(urls);
+}
+
+/*
+ * UTF-8 validation of decoded components
+ */
+
+static size_t scalar_utf8_check(const unsigned char *s, size_t len)
+{
+    size_t i = 0;
+
+    while (i < len)
+    {
+        unsigned int c = s[i];
+        unsigned int cp;
+        size_t n, j;
+
+        if (c < 0x80)
+        {
+            i++;
+            continue;
+        }
+        n = (c >= 0xf0) ? 3 : (c >= 0xe0) ? 2 : 1;
+        cp = c & (0x3f >> n);
+        if (c < 0xc2 || c > 0xf4 || i + n >= len)
+        {
+            return i;
+        }
+        for (j = 1; j <= n; j++)
+        {
+            if (0x80 != (s[i + j] & 0xc0))
+            {
+                return i;
+            }
+            cp = cp << 6 | (s[i + j] & 0x3f);
+        }
+        if ((2 == n && cp < 0x800) || (3 == n && (cp < 0x10000 || cp > 0x10ffff)) || (cp >= 0xd800 && cp <= 0xdfff))
+        {
+            return i;
+        }
+        i += n + 1;
+    }
+
+    return len;
+}
+
+static void bench_utf8(void)
+{
+    static const char *names[] = {"scalar check", "yuarel_utf8_valid", "url_decode + scalar check", "yuarel_url_decode_utf8"};
+    static const char *words[] = {"stra%C3%9Fe", "caf%C3%A9", "%E6%9D%B1%E4%BA%AC", "index", "%F0%9F%98%80", "se%C3%B1or", "docs", "%D0%BC%D0%B8%D1%80"};
+    const int iterations = 200000;
+    char encoded[2048];
+    char decoded[2048];
+    char work[2048];
+    size_t len = 0;
+    size_t decoded_len;
+    int mode, i;
+
+    for (i = 0; len < 1900; i++)
+    {
+        len += (size_t)snprintf(encoded + len, sizeof(encoded) - len, "%s%s", i ? "/" : "", words[(i * 7) % 8]);
+    }
+    memcpy(decoded, encoded, len + 1);
+    yuarel_url_decode(decoded);
+    decoded_len = strlen(decoded);
+
+    printf("utf8: %zu byte escaped path, %zu bytes decoded x %d\n", len, decoded_len, iterations);
+    printf("  %-28s %12s\n", "function", "ns/path");
+
+    for (mode = 0; mode < 4; mode++)
+    {
+        double start = now_sec();
+        size_t total = 0;
+
+        for (i = 0; i < iterations; i++)
+        {
+            switch (mode)
+            {
+                case 0:
+                    total += scalar_utf8_check((const unsigned char *)decoded, decoded_len);
+                    break;
+                case 1:
+                    total += yuarel_utf8_valid(decoded, decoded_len, NULL);
+                    break;
+                case 2:
+                    memcpy(work, encoded, len + 1);
+                    yuarel_url_decode(work);
+                    total += scalar_utf8_check((const unsigned char *)work, strlen(work));
+                    break;
+                default:
+                    memcpy(work, encoded, len + 1);
+                    total += NULL != yuarel_url_decode_utf8(work, NULL);
+                    break;
+            }
+        }
+
+        printf("  %-28s %12.1f\n", names[mode], (now_sec() - start) / iterations * 1e9);
+        (void)total;
+    }
+}
+
+static void bench_idna(void)
+{
+    static const char *names[] = {"to_ascii, ASCII hosts", "to_ascii, Unicode hosts", "to_unicode, xn-- hosts"};
+    static const char *ascii_hosts[] = {"www.example.com", "Images.Google.co.uk", "api.github.com", "cdn.jsdelivr.net"};
+    static const char *unicode_hosts[] = {"b\xc3\xbc" "cher.example", "m\xc3\xbcnchen.de", "\xd0\xb4\xd0\xbe\xd0\xbc\xd0\xb5\xd0\xbd.\xd1\x80\xd1\x84",
+                                          "\xe4\xbe\x8b\xe3\x81\x88.\xe3\x83\x86\xe3\x82\xb9\xe3\x83\x88"};
+    const int iterations = 1000000;
+    char ace_hosts[4][64];
+    char buf[256];
+    int mode, i;
+
+    for (i = 0; i < 4; i++)
+    {
+        yuarel_host_to_ascii(unicode_hosts[i], ace_hosts[i], sizeof(ace_hosts[i]));
+    }
+
+    printf("idna: %d hosts\n", iterations);
+    printf("  %-28s %12s\n", "function", "ns/host");
+
+    for (mode = 0; mode < 3; mode++)
+    {
+        double start = now_sec();
+        long total = 0;
+
+        for (i = 0; i < iterations; i++)
+        {
+            switch (mode)
+            {
+                case 0:
+                    total += yuarel_host_to_ascii(ascii_hosts[i & 3], buf, sizeof(buf));
+                    break;
+                case 1:
+                    total += yuarel_host_to_ascii(unicode_hosts[i & 3], buf, sizeof(buf));
+                    break;
+                default:
+                    total += yuarel_host_to_unicode(ace_hosts[i & 3], buf, sizeof(buf));
+                    break;
+            }
+        }
+
+        printf("  %-28s %12.1f\n", names[mode], (now_sec() - start) / iterations * 1e9);
+        (void)total;
+    }
+}
+
+static void bench_matcher(void)
+{
+    static const char *rules_filename = "bench_matcher.txt";
+    static const char *blob_filename = "bench_matcher.yum";
+    static const char *tlds[] = {"com", "net", "org", "io", "de"};
+    static const int rule_counts[] = {1000, 10000, 80000};
+    const int iterations = 1000000;
+    char urls[64][160];
+    struct yuarel parsed[64];
+    int c, i;
+
+    /* Mostly clean traffic, with a few hosts and paths that hit a rule */
+    for (i = 0; i < 64; i++)
+    {
+        if (i % 8 == 0)
+        {
+            snprintf(urls[i], sizeof(urls[i]), "http://x.ads%d.tracker%d.%s/js/app.js", i * 97 % 1000, i % 50,
+                     tlds[i % 5]);
+        }
+        else if (i % 8 == 1)
+        {
+            snprintf(urls[i], sizeof(urls[i]), "https://www.site%d.com/img/banner%d/top.png", i, i * 13 % 1000);
+        }
+        else
+        {
+            snprintf(urls[i], sizeof(urls[i]), "https://www.site%d.%s/articles/2024/%d/story-%d.html?ref=home&page=%d", i,
+                     tlds[i % 5], i % 12, i * 31, i % 4);
+        }
+        yuarel_parse(&parsed[i], urls[i]);
+    }
+
+    printf("matcher: %d urls\n", iterations);
+    printf("  %-10s %12s %12s %12s\n", "rules", "compile ms", "open us", "ns/url");
+
+    for (c = 0; c < 3; c++)
+    {
+        struct yuarel_matcher matcher;
+        double compile, open, start;
+        long hits = 0;
+        FILE *fp;
+
+        /* Two thirds host rules, the rest path and query patterns */
+        fp = fopen(rules_filename, "w");
+        for (i = 0; i < rule_counts[c]; i++)
+        {
+            switch (i % 6)
+            {
+                case 0:
+                    fprintf(fp, "/banner%d/*\n", i / 6);
+                    break;
+                case 1:
+                    fprintf(fp, "^utm_x%d=\n", i / 6);
+                    break;
+                default:
+                    fprintf(fp, "||ads%d.tracker%d.%s^\n", i / 6 % 1000, i / 6000, tlds[i % 5]);
+                    break;
+            }
+        }
+        fclose(fp);
+
+        start = now_sec();
+        if (yuarel_matcher_compile(rules_filename, blob_filename) < 0)
+        {
+            printf("matcher: failed to compile the rules\n");
+            return;
+        }
+        compile = now_sec() - start;
+
+        start = now_sec();
+        if (0 != yuarel_matcher_open(&matcher, blob_filename))
+        {
+            printf("matcher: failed to open the rules\n");
+            return;
+        }
+        open = now_sec() - start;
+
+        start = now_sec();
+        for (i = 0; i < iterations; i++)
+        {
+            hits += YUAREL_MATCH_BLOCK == yuarel_matcher_match(&matcher, &parsed[i & 63], NULL);
+        }
+
+        printf("  %-10d %12.1f %12.1f %12.1f\n", rule_counts[c], compile * 1e3, open * 1e6,
+               (now_sec() - start) / iterations * 1e9);
+        (void)hits;
+        yuarel_matcher_close(&matcher);
+    }
+
+    remove(rules_filename);
+    remove(blob_filename);
+}
+
+static void bench_rewrite(void)
+{
+    static struct yuarel_rewrite rules[32];
+    const int iterations = 200000;
+    char urls[64][160];
+    struct yuarel parsed[64];
+    char out[256];
+    int pass, i, r;
+
+    /* A typical rule set: numbered legacy paths, one per section */
+    for (r = 0; r < 32; r++)
+    {
+        char pattern[64];
+
+        snprintf(pattern, sizeof(pattern), "^/section%d/old/(\\d+)/(.*)\\.html$", r);
+        if (0 != yuarel_rewrite_compile(&rules[r], pattern, "/new/$2?id=$1"))
+        {
+            printf("rewrite: failed to compile the rules\n");
+            return;
+        }
+    }
+    yuarel_rewrite_condition(&rules[31], YUAREL_FIELD_HOST, "^(www\\.)?example\\.com$");
+
+    for (i = 0; i < 64; i++)
+    {
+        snprintf(urls[i], sizeof(urls[i]), "http://www.example.com/section%d/old/%d/articles/story-%d.html?ref=%d",
+                 i % 40, i * 7919, i, i);
+        yuarel_parse(&parsed[i], urls[i]);
+    }
+
+    printf("rewrite: %d urls against %d rules, first match wins\n", iterations, 32);
+    printf("  %-10s %12s\n", "matching", "ns/url");
+
+    /* The second pass drops the DFAs, to show what the NFA alone costs */
+    for (pass = 0; pass < 2; pass++)
+    {
+        double start = now_sec();
+        long hits = 0;
+
+        for (i = 0; i < iterations; i++)
+        {
+            for (r = 0; r < 32; r++)
+            {
+                if (-1 != yuarel_rewrite_apply(&rules[r], &parsed[i & 63], out, sizeof(out)))
+                {
+                    hits++;
+                    break;
+                }
+            }
+        }
+        printf("  %-10s %12.1f\n", (0 == pass) ? "dfa" : "nfa only", (now_sec() - start) / iterations * 1e9);
+        (void)hits;
+
+        for (r = 0; r < 32; r++)
+        {
+            rules[r].path.state_count = 0;
+            rules[r].host.state_count = 0;
+        }
+    }
+}
+
+/*
+ * Concurrent interning, lock-free against a mutex around the same table
+ */
+
+#define INTERN_URLS 100000
+
+static struct yuarel intern_urls[INTERN_URLS];
+static struct yuarel_intern intern_table;
+static pthread_mutex_t intern_lock = PTHREAD_MUTEX_INITIALIZER;
+
+struct intern_job
+{
+    int offset;
+    int use_lock;
+    struct yuarel_arena arena;
+};
+
+static void *intern_worker(void *arg)
+{
+    struct intern_job *job = arg;
+    int i;
+
+    /* Every thread sees every URL, starting at a different one */
+    for (i = 0; i < INTERN_URLS; i++)
+    {
+        const struct yuarel *url = &intern_urls[(i + job->offset) % INTERN_URLS];
+
+        if (job->use_lock)
+        {
+            pthread_mutex_lock(&intern_lock);
+        }
+        yuarel_intern_add(&intern_table, &job->arena, url, YUAREL_FIELD_ALL);
+        if (job->use_lock)
+        {
+            pthread_mutex_unlock(&intern_lock);
+        }
+    }
+    return NULL;
+}
+
+static void bench_intern(void)
+{
+    static const int thread_counts[] = {1, 2, 4, 8, 16, 32};
+    static struct intern_job jobs[32];
+    static char strings[INTERN_URLS][96];
+    int t, mode, i;
+
+    /* A crawl frontier: many paths on a few thousand hosts */
+    for (i = 0; i < INTERN_URLS; i++)
+    {
+        snprintf(strings[i], sizeof(strings[i]), "https://www.site%d.example/articles/%d/page-%d.html?ref=%d", i % 3000,
+                 i % 97, i, i % 7);
+        yuarel_parse(&intern_urls[i], strings[i]);
+    }
+
+    printf("intern: %d URLs per thread\n", INTERN_URLS);
+    printf("  %-8s %-10s %12s %10s\n", "threads", "table", "Mop/s", "ids");
+
+    for (t = 0; t < 6; t++)
+    {
+        for (mode = 0; mode < 2; mode++)
+        {
+            pthread_t threads[32];
+            double start, elapsed;
+            int n = thread_counts[t];
+
+            yuarel_intern_init(&intern_table, 3 * INTERN_URLS);
+            start = now_sec();
+            for (i = 0; i < n; i++)
+            {
+                jobs[i].offset = i * (INTERN_URLS / n);
+                jobs[i].use_lock = mode;
+                yuarel_arena_init(&jobs[i].arena, 0);
+                pthread_create(&threads[i], NULL, intern_worker, &jobs[i]);
+            }
+            for (i = 0; i < n; i++)
+            {
+                pthread_join(threads[i], NULL);
+            }
+            elapsed = now_sec() - start;
+
+            printf("  %-8d %-10s %12.2f %10u\n", n, mode ? "mutex" : "lock-free", (double)n * INTERN_URLS / elapsed / 1e6,
+                   yuarel_intern_count(&intern_table));
+
+            yuarel_intern_free(&intern_table);
+            for (i = 0; i < n; i++)
+            {
+                yuarel_arena_free(&jobs[i].arena);
+            }
+        }
+    }
+}
+
+/*
+ * Every SIMD kernel the CPU supports, on the same inputs
+ */
+static void bench_simd(void)
+{
+    static const char *kernels[] = {"scalar", "sse2", "avx2", "avx512bw"};
+    static const char *names[] = {"split_path", "parse_query", "url_decode", "parse_ex"};
+    const int iterations = 500000;
+    struct yuarel_param params[64];
+    struct yuarel url;
+    char *parts[64];
+    size_t lengths[64];
+    char path[512];
+    char query[1024];
+    char full[2048];
+    char work[2048];
+    size_t path_len = 0, query_len = 0, full_len;
+    int k, mode, i;
+
+    for (i = 0; i < 24; i++)
+    {
+        path_len += (size_t)snprintf(path + path_len, sizeof(path) - path_len, "/segment%d", i * 37);
+    }
+    for (i = 0; i < 24; i++)
+    {
+        query_len += (size_t)snprintf(query + query_len, sizeof(query) - query_len, "%skey%d=some+value%%20%d",
+                                      i ? "&" : "", i, i * 53);
+    }
+    full_len = (size_t)snprintf(full, sizeof(full), "https://www.example.com%s?%s#top", path, query);
+
+    printf("simd: %zu byte path, %zu byte query, %zu byte URL x %d\n", path_len, query_len, full_len, iterations);
+    printf("  %-10s %12s %12s %12s %12s\n", "kernel", names[0], names[1], names[2], names[3]);
+
+    for (k = 0; k < 4; k++)
+    {
+        if (-1 == yuarel_simd_select(kernels[k]))
+        {
+            continue;
+        }
+        printf("  %-10s", kernels[k]);
+
+        for (mode = 0; mode < 4; mode++)
+        {
+            double start = now_sec();
+            size_t total = 0;
+
+            for (i = 0; i < iterations; i++)
+            {
+                switch (mode)
+                {
+                    case 0:
+                        memcpy(work, path, path_len + 1);
+                        total += yuarel_split_path_ex(work, parts, lengths, 64);
+                        break;
+                    case 1:
+                        memcpy(work, query, query_len + 1);
+                        total += yuarel_parse_query_ex(work, "&", params, 64, YUAREL_QUERY_DECODE);
+                        break;
+                    case 2:
+                        memcpy(work, query, query_len + 1);
+                        total += (size_t)yuarel_url_decode(work)[0];
+                        break;
+                    default:
+                        memcpy(work, full, full_len + 1);
+                        total += yuarel_parse_ex(&url, work, YUAREL_DECODE_PATH | YUAREL_DECODE_QUERY);
+                        break;
+                }
+            }
+
+            printf(" %12.1f", (now_sec() - start) / iterations * 1e9);
+            (void)total;
+        }
+        printf("\n");
+    }
+
+    yuarel_simd_select(NULL);
+}
+
+/*
+ * Port a URL connects to, looked up by the caller or with yuarel_effective_port()
+ */
+static int caller_default_port(const char *scheme)
+{
+    if (0 == strcmp(scheme, "http") || 0 == strcmp(scheme, "ws"))
+    {
+        return 80;
+    }
+    if (0 == strcmp(scheme, "https") || 0 == strcmp(scheme, "wss"))
+    {
+        return 443;
+    }
+    if (0 == strcmp(scheme, "ftp"))
+    {
+        return 21;
+    }
+    return 0;
+}
+
+static void bench_scheme(void)
+{
+    static const char *schemes[] = {"http", "https", "HTTPS", "wss", "ftp", "git+ssh"};
+    static const char *names[] = {"strcmp", "effective_port"};
+    const int iterations = 4000000;
+    struct yuarel url;
+    char *urls[CORPUS_SIZE];
+    char work[256];
+    int mode, i;
+
+    /* 99% http and https, the rest spread over other schemes */
+    for (i = 0; i < CORPUS_SIZE; i++)
+    {
+        int n = snprintf(work, sizeof(work), "%s://www.example.com/%d",
+                         0 == i % 100 ? schemes[2 + (i / 100) % 4] : schemes[i & 1], i);
+        urls[i] = malloc(n + 1);
+        memcpy(urls[i], work, n + 1);
+    }
+
+    printf("scheme: host and effective port of %d URLs x %d\n", CORPUS_SIZE, iterations / CORPUS_SIZE);
+    printf("  %-16s %12s\n", "lookup", "ns/url");
+
+    for (mode = 0; mode < 2; mode++)
+    {
+        double start = now_sec();
+        long total = 0;
+
+        for (i = 0; i < iterations; i++)
+        {
+            strcpy(work, urls[i & (CORPUS_SIZE - 1)]);
+            if (-1 == yuarel_parse_host(&url, work))
+            {
+                continue;
+            }
+            if (0 == mode)
+            {
+                total += 0 != url.port ? url.port : caller_default_port(url.scheme);
+            }
+            else
+            {
+                total += yuarel_effective_port(&url);
+            }
+        }
+
+        printf("  %-16s %12.1f\n", names[mode], (now_sec() - start) / iterations * 1e9);
+        (void)total;
+    }
+
+    for (i = 0; i < CORPUS_SIZE; i++)
+    {
+        free(urls[i]);
+    }
+}
+
+/*
+ * Outbound query of 30 parameters, with snprintf() and strcat() or the builder
+ */
+static void naive_encode(char *out, const char *str)
+{
+    static const char hex[] = "0123456789ABCDEF";
+
+    for (; '\0' != *str; str++)
+    {
+        unsigned char c = (unsigned char)*str;
+
+        if (isalnum(c) || '-' == c || '.' == c || '_' == c || '~' == c)
+        {
+            *out++ = (char)c;
+        }
+        else
+        {
+            *out++ = '%';
+            *out++ = hex[c >> 4];
+            *out++ = hex[c & 0xf];
+        }
+    }
+    *out = '\0';
+}
+
+static void bench_build(void)
+{
+    static const char *names[] = {"snprintf+strcat", "builder"};
+    const int iterations = 200000;
+    char keys[30][16];
+    char values[30][64];
+    char buf[4096];
+    char param[256];
+    char encoded[192];
+    int mode, i, p;
+
+    for (p = 0; p < 30; p++)
+    {
+        snprintf(keys[p], sizeof(keys[p]), "param_%d", p);
+        if (p % 3 == 0)
+        {
+            snprintf(values[p], sizeof(values[p]), "%d", p * 7919);
+        }
+        else if (p % 3 == 1)
+        {
+            snprintf(values[p], sizeof(values[p]), "creative-%d_variant.banner-%d", p, p * 31);
+        }
+        else
+        {
+            snprintf(values[p], sizeof(values[p]), "https://landing.example.com/offer/%d?ref=ad", p);
+        }
+    }
+
+    printf("build: query of 30 parameters x %d\n", iterations);
+    printf("  %-16s %12s\n", "method", "ns/query");
+
+    for (mode = 0; mode < 2; mode++)
+    {
+        double start = now_sec();
+        size_t total = 0;
+
+        for (i = 0; i < iterations; i++)
+        {
+            if (0 == mode)
+            {
+                buf[0] = '\0';
+                for (p = 0; p < 30; p++)
+                {
+                    naive_encode(encoded, values[p]);
+                    snprintf(param, sizeof(param), "%s%s=%s", p ? "&" : "", keys[p], encoded);
+                    strcat(buf, param);
+                }
+                total += strlen(buf);
+            }
+            else
+            {
+                struct yuarel_query_builder builder;
+
+                yuarel_query_builder_init(&builder, buf, sizeof(buf), 0);
+                for (p = 0; p < 30; p++)
+                {
+                    yuarel_query_builder_add(&builder, keys[p], values[p]);
+                }
+                total += (size_t)yuarel_query_builder_finish(&builder);
+            }
+        }
+
+        printf("  %-16s %12.1f\n", names[mode], (now_sec() - start) / iterations * 1e9);
+        (void)total;
+    }
+}
+
+static void bench_template(void)
+{
+    static const char *names[] = {"snprintf+yuarel_parse", "expand", "expand to url"};
+    static const char *queries[] = {"red shoes", "size:42", "caf\xc3\xa9", "a&b=c"};
+    const int iterations = 2000000;
+    struct yuarel_template_op ops[16];
+    struct yuarel_template tpl;
+    struct yuarel_template_var vars[4];
+    struct yuarel url;
+    char ids[64][16];
+    char buf[256];
+    char encoded[64];
+    int mode, i;
+
+    for (i = 0; i < 64; i++)
+    {
+        snprintf(ids[i], sizeof(ids[i]), "%d", i * 7919);
+    }
+    yuarel_template_compile(&tpl, "https://api.example.com/v1/users/{id}/items{?limit,offset,q}", ops, 16);
+    memset(vars, 0, sizeof(vars));
+    vars[0].name = "id";
+    vars[1].name = "limit";
+    vars[1].value = "50";
+    vars[2].name = "offset";
+    vars[2].value = "100";
+    vars[3].name = "q";
+
+    printf("template: expand a 4 variable template to a URL x %d\n", iterations);
+    printf("  %-24s %12s\n", "method", "ns/url");
+
+    for (mode = 0; mode < 3; mode++)
+    {
+        double start = now_sec();
+        size_t total = 0;
+
+        for (i = 0; i < iterations; i++)
+        {
+            vars[0].value = ids[i & 63];
+            vars[3].value = queries[i & 3];
+
+            if (0 == mode)
+            {
+                naive_encode(encoded, vars[3].value);
+                snprintf(buf, sizeof(buf), "https://api.example.com/v1/users/%s/items?limit=%s&offset=%s&q=%s",
+                         vars[0].value, vars[1].value, vars[2].value, encoded);
+                total += (size_t)yuarel_parse(&url, buf);
+            }
+            else
+            {
+                total += (size_t)yuarel_template_expand(&tpl, vars, 4, buf, sizeof(buf), 2 == mode ? &url : NULL);
+            }
+        }
+
+        printf("  %-24s %12.1f\n", names[mode], (now_sec() - start) / iterations * 1e9);
+        (void)total;
+    }
+}
+
+static int form_count(void *arg, const char *key, size_t key_len, const char *value, size_t value_len)
+{
+    *(size_t *)arg += key_len + value_len + (NULL != value);
+    return 0;
+}
+
+static void bench_form(void)
+{
+    static const char *names[] = {"buffer+parse_query_ex", "yuarel_form_feed"};
+    const size_t body_size = 8 << 20;
+    const size_t chunk_size = 64 << 10;
+    const int iterations = 10;
+    struct yuarel_param *params;
+    struct yuarel_form form;
+    char *body, *whole;
+    char buf[4096];
+    size_t len = 0;
+    int max_params = 0;
+    int mode, i;
+
+    /* Form fields of a typical submission, with some escapes and spaces */
+    body = malloc(body_size + 256);
+    whole = malloc(body_size + 1);
+    while (len < body_size)
+    {
+        len += snprintf(body + len, 256, "%sfield_%d=%s", len ? "&" : "", max_params,
+                        (max_params % 4) ? "some+text+with+spaces%2C+and+an+escape" : "J%C3%B6rg%40example.com");
+        max_params++;
+    }
+    params = malloc(sizeof(struct yuarel_param) * max_params);
+
+    printf("form: %zu byte body in %zu byte chunks x %d\n", len, chunk_size, iterations);
+    printf("  %-24s %12s\n", "method", "MB/s");
+
+    for (mode = 0; mode < 2; mode++)
+    {
+        double start = now_sec();
+        size_t total = 0;
+
+        for (i = 0; i < iterations; i++)
+        {
+            size_t off;
+
+            if (0 == mode)
+            {
+                /* Reassemble the chunks, then parse and decode the whole body */
+                for (off = 0; off < len; off += chunk_size)
+                {
+                    memcpy(whole + off, body + off, off + chunk_size < len ? chunk_size : len - off);
+                }
+                whole[len] = '\0';
+                total += yuarel_parse_query_ex(whole, "&", params, max_params, YUAREL_QUERY_DECODE);
+            }
+            else
+            {
+                yuarel_form_init(&form, buf, sizeof(buf), 0, form_count, &total);
+                for (off = 0; off < len; off += chunk_size)
+                {
+                    yuarel_form_feed(&form, body + off, off + chunk_size < len ? chunk_size : len - off);
+                }
+                total += yuarel_form_finish(&form);
+            }
+        }
+
+        printf("  %-24s %12.1f\n", names[mode], (double)len * iterations / (now_sec() - start) / 1e6);
+        (void)total;
+    }
+
+    free(params);
+    free(whole);
+    free(body);
+}
+
+int main(int argc, char **argv)
+{
+    corpus_init();
+
+    if (argc < 2 || 0 == strcmp(argv[1], "arena"))
+    {
+        bench_arena();
+    }
+
+    if (argc < 2 || 0 == strcmp(argv[1], "lazy"))
+    {
+        bench_lazy();
+    }
+
+    if (argc < 2 || 0 == strcmp(argv[1], "stream"))
+    {
+        bench_stream();
+    }
+
+    if (argc < 2 || 0 == strcmp(argv[1], "psl"))
+    {
+        bench_psl();
+    }
+
+    if (argc < 2 || 0 == strcmp(argv[1], "filter"))
+    {
+        bench_filter();
+    }
+
+    if (argc < 2 || 0 == strcmp(argv[1], "query"))
+    {
+        bench_query();
+    }
+
+    if (argc < 2 || 0 == strcmp(argv[1], "path"))
+    {
+        bench_path();
+    }
+
+    if (argc < 2 || 0 == strcmp(argv[1], "decode"))
+    {
+        bench_decode();
+    }
+
+    if (argc < 2 || 0 == strcmp(argv[1], "utf8"))
+    {
+        bench_utf8();
+    }
+
+    if (argc < 2 || 0 == strcmp(argv[1], "idna"))
+    {
+        bench_idna();
+    }
+
+    if (argc < 2 || 0 == strcmp(argv[1], "matcher"))
+    {
+        bench_matcher();
+    }
+
+    if (argc < 2 || 0 == strcmp(argv[1], "rewrite"))
+    {
+        bench_rewrite();
+    }
+
+    if (argc < 2 || 0 == strcmp(argv[1], "intern"))
+    {
+        bench_intern();
+    }
+
+    if (argc < 2 || 0 == strcmp(argv[1], "simd"))
+    {
+        bench_simd();
+    }
+
+    if (argc < 2 || 0 == strcmp(argv[1], "scheme"))
+    {
+        bench_scheme();
+    }
+
+    if (argc < 2 || 0 == strcmp(argv[1], "build"))
+    {
+        bench_build();
+    }
+
+    if (argc < 2 || 0 == strcmp(argv[1], "template"))
+    {
+        bench_template();
+    }
+
+    if (argc < 2 || 0 == strcmp(argv[1], "form"))
+    {
+        bench_form();
+    }
+
+    return 0;
+}
@@ -0,0 +1,850 @@
+/*
+ * yuarel-stat: top hosts, path prefixes and query keys of access logs.
+ *
+ * Build with `make yuarel-stat`. Each log is mapped into memory and cut into
+ * chunks at line ends, which the threads take in turn. A line is either a
+ * log line with a quoted request line ("GET /path?q HTTP/1.1"), as in the
+ * common and combined log formats, or a bare URL. Each thread counts into
+ * its own Space-Saving sketches, which are merged once all lines are read.
+ *
+ * Counts are exact while a sketch holds fewer distinct keys than it has
+ * counters (-m). Past that, the reported count is an upper bound and the
+ * "at least" column a lower bound of the true count.
+ */
+#define _POSIX_C_SOURCE 200809L
+
+#include <ctype.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <yuarel.h>
+#include <yuarel_http.h>
+
+/* Longer keys are cut, and counted together with the keys they start */
+#define KEY_MAX 96
+/* Longer lines are counted as errors */
+#define LINE_MAX_LEN 8192
+#define MAX_PARAMS 64
+#define MAX_THREADS 256
+#define CHUNK_SIZE (16u << 20)
+
+enum stat_error
+{
+    ERR_TOO_LONG,
+    ERR_NO_REQUEST,
+    ERR_REQUEST_LINE,
+    ERR_URL,
+    ERR_COUNT
+};
+
+static const char *error_names[ERR_COUNT] = {"line too long", "no quoted request", "bad request line", "bad url"};
+
+enum stat_kind
+{
+    STAT_HOSTS,
+    STAT_PATHS,
+    STAT_KEYS,
+    STAT_COUNT
+};
+
+static const char *stat_names[STAT_COUNT] = {"hosts", "path prefixes", "query keys"};
+
+struct counter
+{
+    uint64_t hash;
+    uint64_t count; /* Upper bound of the true count */
+    uint64_t error; /* count - error is a lower bound */
+    uint32_t heap;  /* Position in the min-heap */
+    uint16_t len;
+    char key[KEY_MAX];
+};
+
+/* Space-Saving summary: a hash table over the counters and a min-heap by count */
+struct sketch
+{
+    struct counter *counters;
+    uint32_t *heap;
+    uint32_t *table; /* Counter index + 1, 0 when empty */
+    uint32_t mask;
+    uint32_t capacity;
+    uint32_t used;
+};
+
+struct chunk
+{
+    const char *start;
+    const char *end;
+};
+
+struct worker
+{
+    pthread_t thread;
+    struct sketch sketches[STAT_COUNT];
+    uint64_t lines;
+    uint64_t parsed;
+    uint64_t errors[ERR_COUNT];
+};
+
+static struct chunk *chunks;
+static size_t chunk_count;
+static size_t chunk_next;
+static int path_depth = 2;
+static int use_vhost;
+
+static double now_sec(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/**
+ * FNV-1a hash of a key.
+ *
+ * @param key: The key.
+ * @param len: The length of the key.
+ *
+ * @return: The hash.
+ */
+static uint64_t hash_key(const char *key, size_t len)
+{
+    uint64_t h = 14695981039346656037ull;
+    size_t i;
+
+    for (i = 0; i < len; i++)
+    {
+        h = (h ^ (unsigned char)key[i]) * 1099511628211ull;
+    }
+    return h;
+}
+
+/**
+ * Allocate an empty sketch.
+ *
+ * @param s: The sketch to initialize.
+ * @param capacity: The number of counters.
+ *
+ * @return: 0 on success, otherwise -1 if out of memory.
+ */
+static int sketch_init(struct sketch *s, uint32_t capacity)
+{
+    uint32_t size = 16;
+
+    while (size < capacity * 2)
+    {
+        size *= 2;
+    }
+
+    s->counters = malloc(sizeof(struct counter) * capacity);
+    s->heap = malloc(sizeof(uint32_t) * capacity);
+    s->table = calloc(size, sizeof(uint32_t));
+    s->mask = size - 1;
+    s->capacity = capacity;
+    s->used = 0;
+
+    if (NULL == s->counters || NULL == s->heap || NULL == s->table)
+    {
+        return -1;
+    }
+    return 0;
+}
+
+static void sketch_free(struct sketch *s)
+{
+    free(s->counters);
+    free(s->heap);
+    free(s->table);
+}
+
+/**
+ * The count below which a key missing from the sketch must be.
+ *
+ * @param s: The sketch.
+ *
+ * @return: The smallest count when all counters are used, otherwise 0.
+ */
+static uint64_t sketch_min(const struct sketch *s)
+{
+    if (s->used < s->capacity)
+    {
+        return 0;
+    }
+    return s->counters[s->heap[0]].count;
+}
+
+static void heap_swap(struct sketch *s, uint32_t a, uint32_t b)
+{
+    uint32_t tmp = s->heap[a];
+
+    s->heap[a] = s->heap[b];
+    s->heap[b] = tmp;
+    s->counters[s->heap[a]].heap = a;
+    s->counters[s->heap[b]].heap = b;
+}
+
+static void heap_up(struct sketch *s, uint32_t pos)
+{
+    while (pos > 0)
+    {
+        uint32_t parent = (pos - 1) / 2;
+
+        if (s->counters[s->heap[parent]].count <= s->counters[s->heap[pos]].count)
+        {
+            break;
+        }
+        heap_swap(s, parent, pos);
+        pos = parent;
+    }
+}
+
+static void heap_down(struct sketch *s, uint32_t pos)
+{
+    for (;;)
+    {
+        uint32_t child = pos * 2 + 1;
+
+        if (child >= s->used)
+        {
+            break;
+        }
+        if (child + 1 < s->used && s->counters[s->heap[child + 1]].count < s->counters[s->heap[child]].count)
+        {
+            child++;
+        }
+        if (s->counters[s->heap[pos]].count <= s->counters[s->heap[child]].count)
+        {
+            break;
+        }
+        heap_swap(s, pos, child);
+        pos = child;
+    }
+}
+
+/**
+ * Find the counter of a key.
+ *
+ * @param s: The sketch.
+ * @param key: The key, at most KEY_MAX bytes.
+ * @param len: The length of the key.
+ * @param hash: The hash of the key.
+ * @param slot: Set to the table slot of the counter, or the empty slot that ends the probe.
+ *
+ * @return: The counter, or NULL if the key is not in the sketch.
+ */
+static struct counter *sketch_find(const struct sketch *s, const char *key, size_t len, uint64_t hash, uint32_t *slot)
+{
+    uint32_t i = (uint32_t)hash & s->mask;
+
+    for (; 0 != s->table[i]; i = (i + 1) & s->mask)
+    {
+        struct counter *c = &s->counters[s->table[i] - 1];
+
+        if (c->hash == hash && c->len == len && 0 == memcmp(c->key, key, len))
+        {
+            break;
+        }
+    }
+
+    *slot = i;
+    return 0 == s->table[i] ? NULL : &s->counters[s->table[i] - 1];
+}
+
+/**
+ * Remove a counter from the hash table, shifting back the entries that
+ * probed past it.
+ *
+ * @param s: The sketch.
+ * @param index: The index of the counter.
+ */
+static void table_remove(struct sketch *s, uint32_t index)
+{
+    uint32_t i = (uint32_t)s->counters[index].hash & s->mask;
+    uint32_t j;
+
+    while (s->table[i] != index + 1)
+    {
+        i = (i + 1) & s->mask;
+    }
+
+    for (j = (i + 1) & s->mask; 0 != s->table[j]; j = (j + 1) & s->mask)
+    {
+        uint32_t home = (uint32_t)s->counters[s->table[j] - 1].hash & s->mask;
+
+        /* Move the entry into the hole unless its home lies between the two */
+        if (((j - home) & s->mask) >= ((j - i) & s->mask))
+        {
+            s->table[i] = s->table[j];
+            i = j;
+        }
+    }
+    s->table[i] = 0;
+}
+
+/**
+ * Count a key. When all counters are in use, the key takes over the counter
+ * with the smallest count, as in the Space-Saving algorithm.
+ *
+ * @param s: The sketch.
+ * @param key: The key. Only the first KEY_MAX bytes are kept.
+ * @param len: The length of the key.
+ * @param count: The count to add.
+ * @param error: The error of the count to add.
+ */
+static void sketch_add(struct sketch *s, const char *key, size_t len, uint64_t count, uint64_t error)
+{
+    struct counter *c;
+    uint64_t hash;
+    uint32_t slot, index;
+    int evicted = 0;
+
+    if (len > KEY_MAX)
+    {
+        len = KEY_MAX;
+    }
+    hash = hash_key(key, len);
+
+    c = sketch_find(s, key, len, hash, &slot);
+    if (NULL != c)
+    {
+        c->count += count;
+        c->error += error;
+        heap_down(s, c->heap);
+        return;
+    }
+
+    if (s->used < s->capacity)
+    {
+        index = s->used++;
+        c = &s->counters[index];
+        c->count = count;
+        c->error = error;
+        c->heap = index;
+        s->heap[index] = index;
+    }
+    else
+    {
+        uint64_t min;
+
+        index = s->heap[0];
+        c = &s->counters[index];
+        min = c->count;
+        table_remove(s, index);
+        c->count = min + count;
+        c->error = min + error;
+        evicted = 1;
+        /* The removal may have moved the end of the probe */
+        sketch_find(s, key, len, hash, &slot);
+    }
+
+    c->hash = hash;
+    c->len = (uint16_t)len;
+    memcpy(c->key, key, len);
+    s->table[slot] = index + 1;
+
+    if (evicted)
+    {
+        heap_down(s, c->heap);
+    }
+    else
+    {
+        heap_up(s, c->heap);
+    }
+}
+
+/**
+ * Count the host, the path prefix and the query keys of a parsed URL.
+ *
+ * @param w: The worker to count in.
+ * @param url: The parsed URL.
+ */
+static void count_url(struct worker *w, struct yuarel *url)
+{
+    struct yuarel_param params[MAX_PARAMS];
+    char key[KEY_MAX];
+    int i, n;
+
+    if (NULL != url->host && '\0' != *url->host)
+    {
+        size_t len = strlen(url->host);
+
+        if (len > KEY_MAX)
+        {
+            len = KEY_MAX;
+        }
+        for (i = 0; i < (int)len; i++)
+        {
+            key[i] = (char)tolower((unsigned char)url->host[i]);
+        }
+        sketch_add(&w->sketches[STAT_HOSTS], key, len, 1, 0);
+    }
+
+    if (NULL != url->path)
+    {
+        /* The leading '/' was replaced by the parser, put it back */
+        const char *p = url->path;
+        size_t len = 1;
+        int depth = 0;
+
+        key[0] = '/';
+        while ('\0' != *p && len < KEY_MAX)
+        {
+            if ('/' == *p && ++depth == path_depth)
+            {
+                break;
+            }
+            key[len++] = *p++;
+        }
+        sketch_add(&w->sketches[STAT_PATHS], key, len, 1, 0);
+    }
+
+    if (NULL != url->query)
+    {
+        n = yuarel_parse_query(url->query, '&', params, MAX_PARAMS);
+        for (i = 0; i < n; i++)
+        {
+            if ('\0' != *params[i].key)
+            {
+                sketch_add(&w->sketches[STAT_KEYS], params[i].key, strlen(params[i].key), 1, 0);
+            }
+        }
+    }
+}
+
+/**
+ * Parse one log line and count it.
+ *
+ * @param w: The worker to count in.
+ * @param line: The line, without its newline.
+ * @param len: The length of the line.
+ */
+static void count_line(struct worker *w, const char *line, size_t len)
+{
+    char buf[LINE_MAX_LEN + 1];
+    char vhost[256];
+    const char *open;
+    struct yuarel_request req;
+
+    if (len > 0 && '\r' == line[len - 1])
+    {
+        len--;
+    }
+    if (0 == len)
+    {
+        return;
+    }
+
+    w->lines++;
+    if (len > LINE_MAX_LEN)
+    {
+        w->errors[ERR_TOO_LONG]++;
+        return;
+    }
+
+    open = memchr(line, '"', len);
+    if (NULL != open)
+    {
+        /* Log line, parse the quoted request line */
+        const char *start = open + 1;
+        const char *close = memchr(start, '"', len - (size_t)(start - line));
+        char *host = NULL;
+
+        if (NULL == close)
+        {
+            w->errors[ERR_NO_REQUEST]++;
+            return;
+        }
+
+        if (use_vhost)
+        {
+            /* vhost_combined: the first field is "host:port" */
+            size_t n = strcspn(line, " \t");
+
+            if (n < len && n < sizeof(vhost))
+            {
+                memcpy(vhost, line, n);
+                vhost[n] = '\0';
+                host = vhost;
+            }
+        }
+
+        memcpy(buf, start, (size_t)(close - start));
+        if (-1 == yuarel_parse_request_line(&req, buf, (size_t)(close - start), host))
+        {
+            w->errors[ERR_REQUEST_LINE]++;
+            return;
+        }
+        count_url(w, &req.url);
+    }
+    else
+    {
+        /* A bare URL, up to the first blank */
+        size_t n = 0;
+
+        while (n < len && ' ' != line[n] && '\t' != line[n])
+        {
+            n++;
+        }
+        memcpy(buf, line, n);
+        buf[n] = '\0';
+        if (-1 == yuarel_parse(&req.url, buf))
+        {
+            w->errors[ERR_URL]++;
+            return;
+        }
+        count_url(w, &req.url);
+    }
+
+    w->parsed++;
+}
+
+static void *worker_run(void *arg)
+{
+    struct worker *w = arg;
+    size_t i;
+
+    while ((i = __atomic_fetch_add(&chunk_next, 1, __ATOMIC_RELAXED)) < chunk_count)
+    {
+        const char *p = chunks[i].start;
+        const char *end = chunks[i].end;
+
+        while (p < end)
+        {
+            const char *nl = memchr(p, '\n', (size_t)(end - p));
+            const char *line_end = (NULL != nl) ? nl : end;
+
+            count_line(w, p, (size_t)(line_end - p));
+            p = line_end + 1;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Map a log and append its chunks, each ending at a line end.
+ *
+ * @param filename: The log to map.
+ * @param size: Set to the size of the log.
+ *
+ * @return: 0 on success, otherwise -1 on error.
+ */
+static int add_file(const char *filename, size_t *size)
+{
+    struct stat st;
+    const char *map;
+    size_t pos = 0;
+    int fd;
+
+    *size = 0;
+    fd = open(filename, O_RDONLY);
+    if (fd < 0)
+    {
+        return -1;
+    }
+    if (0 != fstat(fd, &st))
+    {
+        close(fd);
+        return -1;
+    }
+    if (0 == st.st_size)
+    {
+        close(fd);
+        return 0;
+    }
+
+    map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (MAP_FAILED == map)
+    {
+        return -1;
+    }
+    posix_madvise((void *)map, (size_t)st.st_size, POSIX_MADV_SEQUENTIAL);
+    *size = (size_t)st.st_size;
+
+    while (pos < *size)
+    {
+        size_t end = pos + CHUNK_SIZE;
+        struct chunk *grown;
+
+        if (end >= *size)
+        {
+            end = *size;
+        }
+        else
+        {
+            const char *nl = memchr(map + end, '\n', *size - end);
+            end = (NULL != nl) ? (size_t)(nl - map) + 1 : *size;
+        }
+
+        grown = realloc(chunks, sizeof(struct chunk) * (chunk_count + 1));
+        if (NULL == grown)
+        {
+            return -1;
+        }
+        chunks = grown;
+        chunks[chunk_count].start = map + pos;
+        chunks[chunk_count].end = map + end;
+        chunk_count++;
+        pos = end;
+    }
+
+    /* The mapping lives until the program exits */
+    return 0;
+}
+
+static int compare_counters(const void *a, const void *b)
+{
+    const struct counter *x = a;
+    const struct counter *y = b;
+    size_t len = x->len < y->len ? x->len : y->len;
+    int cmp;
+
+    if (x->count != y->count)
+    {
+        return x->count < y->count ? 1 : -1;
+    }
+    cmp = memcmp(x->key, y->key, len);
+    return 0 != cmp ? cmp : (int)x->len - (int)y->len;
+}
+
+/**
+ * Merge the sketches of all workers for one statistic, and print the top
+ * keys. A key missing from a full sketch may have been counted up to the
+ * smallest count of that sketch, so that is added to its count and error.
+ *
+ * @param workers: The workers.
+ * @param threads: The number of workers.
+ * @param kind: The statistic to merge.
+ * @param top: The number of keys to print.
+ *
+ * @return: 0 on success, otherwise -1 if out of memory.
+ */
+static int print_top(struct worker *workers, int threads, int kind, int top)
+{
+    struct sketch merged;
+    uint32_t total = 0;
+    uint32_t i;
+    int t;
+
+    for (t = 0; t < threads; t++)
+    {
+        total += workers[t].sketches[kind].used;
+    }
+    if (-1 == sketch_init(&merged, total > 0 ? total : 1))
+    {
+        sketch_free(&merged);
+        return -1;
+    }
+
+    for (t = 0; t < threads; t++)
+    {
+        const struct sketch *s = &workers[t].sketches[kind];
+
+        for (i = 0; i < s->used; i++)
+        {
+            sketch_add(&merged, s->counters[i].key, s->counters[i].len, s->counters[i].count, s->counters[i].error);
+        }
+    }
+
+    for (t = 0; t < threads; t++)
+    {
+        const struct sketch *s = &workers[t].sketches[kind];
+        uint64_t min = sketch_min(s);
+
+        if (0 == min)
+        {
+            continue;
+        }
+        for (i = 0; i < merged.used; i++)
+        {
+            struct counter *c = &merged.counters[i];
+            uint32_t slot;
+
+            if (NULL == sketch_find(s, c->key, c->len, c->hash, &slot))
+            {
+                c->count += min;
+                c->error += min;
+            }
+        }
+    }
+
+    qsort(merged.counters, merged.used, sizeof(struct counter), compare_counters);
+
+    printf("\ntop %s:\n", stat_names[kind]);
+    printf("  %12s %12s  %s\n", "count", "at least", "key");
+    for (i = 0; i < merged.used && (int)i < top; i++)
+    {
+        const struct counter *c = &merged.counters[i];
+
+        printf("  %12llu %12llu  %.*s\n", (unsigned long long)c->count, (unsigned long long)(c->count - c->error),
+               (int)c->len, c->key);
+    }
+
+    sketch_free(&merged);
+    return 0;
+}
+
+static void usage(const char *name)
+{
+    fprintf(stderr,
+            "usage: %s [-k top] [-t threads] [-m counters] [-d depth] [-v] log...\n"
+            "  -k  number of keys to print per statistic (default 10)\n"
+            "  -t  number of threads (default: online CPUs)\n"
+            "  -m  counters per sketch and thread (default 4096)\n"
+            "  -d  path segments in a path prefix (default 2)\n"
+            "  -v  the first field of each line is the virtual host, as in vhost_combined\n",
+            name);
+}
+
+int main(int argc, char **argv)
+{
+    struct worker *workers;
+    uint64_t lines = 0, parsed = 0, errors[ERR_COUNT] = {0};
+    size_t bytes = 0;
+    long threads = sysconf(_SC_NPROCESSORS_ONLN);
+    long counters = 4096;
+    long started;
+    int top = 10;
+    double start;
+    int opt, t, k, i;
+
+    while (-1 != (opt = getopt(argc, argv, "k:t:m:d:v")))
+    {
+        switch (opt)
+        {
+            case 'k':
+                top = atoi(optarg);
+                break;
+            case 't':
+                threads = atol(optarg);
+                break;
+            case 'm':
+                counters = atol(optarg);
+                break;
+            case 'd':
+                path_depth = atoi(optarg);
+                break;
+            case 'v':
+                use_vhost = 1;
+                break;
+            default:
+                usage(argv[0]);
+                return 2;
+        }
+    }
+    if (optind >= argc || top < 1 || counters < 1 || counters > (1l << 24) || path_depth < 1)
+    {
+        usage(argv[0]);
+        return 2;
+    }
+    if (threads < 1)
+    {
+        threads = 1;
+    }
+    if (threads > MAX_THREADS)
+    {
+        threads = MAX_THREADS;
+    }
+
+    start = now_sec();
+
+    for (i = optind; i < argc; i++)
+    {
+        size_t size;
+
+        if (-1 == add_file(argv[i], &size))
+        {
+            fprintf(stderr, "%s: could not read %s\n", argv[0], argv[i]);
+            return 1;
+        }
+        bytes += size;
+    }
+
+    workers = calloc((size_t)threads, sizeof(struct worker));
+    if (NULL == workers)
+    {
+        fprintf(stderr, "%s: out of memory\n", argv[0]);
+        return 1;
+    }
+    for (t = 0; t < threads; t++)
+    {
+        for (k = 0; k < STAT_COUNT; k++)
+        {
+            if (-1 == sketch_init(&workers[t].sketches[k], (uint32_t)counters))
+            {
+                fprintf(stderr, "%s: out of memory\n", argv[0]);
+                return 1;
+            }
+        }
+    }
+
+    for (started = 0; started < threads; started++)
+    {
+        if (0 != pthread_create(&workers[started].thread, NULL, worker_run, &workers[started]))
+        {
+            /* Run with the threads started so far */
+            break;
+        }
+    }
+    if (0 == started)
+    {
+        worker_run(&workers[0]);
+        started = 1;
+    }
+    else
+    {
+        for (t = 0; t < started; t++)
+        {
+            pthread_join(workers[t].thread, NULL);
+        }
+    }
+
+    for (t = 0; t < started; t++)
+    {
+        lines += workers[t].lines;
+        parsed += workers[t].parsed;
+        for (i = 0; i < ERR_COUNT; i++)
+        {
+            errors[i] += workers[t].errors[i];
+        }
+    }
+
+    printf("lines: %llu, parsed: %llu, errors: %llu\n", (unsigned long long)lines, (unsigned long long)parsed,
+           (unsigned long long)(lines - parsed));
+
+    for (k = 0; k < STAT_COUNT; k++)
+    {
+        if (-1 == print_top(workers, (int)started, k, top))
+        {
+            fprintf(stderr, "%s: out of memory\n", argv[0]);
+            return 1;
+        }
+    }
+
+    printf("\nparse errors:\n");
+    for (i = 0; i < ERR_COUNT; i++)
+    {
+        printf("  %12llu  %s\n", (unsigned long long)errors[i], error_names[i]);
+    }
+
+    fprintf(stderr, "%.1f MB in %.3f s, %ld threads\n", bytes / 1e6, now_sec() - start, started);
+
+    for (t = 0; t < threads; t++)
+    {
+        for (k = 0; k < STAT_COUNT; k++)
+        {
+            sketch_free(&workers[t].sketches[k]);
+        }
+    }
+    free(workers);
+    free(chunks);
+    return 0;
+}
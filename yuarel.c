@@ -20,10 +20,32 @@
  * SOFTWARE.
  */
 #include "yuarel.h"
+#include "yuarel_internal.h"
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+#ifdef YUAREL_X86
+#include <immintrin.h>
+#endif
+
+/* Delimiters compared by the SIMD kernels in yuarel_parse_query_ex(), more use strcspn() */
+#define QUERY_MAX_VECTOR_DELIMITERS 8
+
+/* Delimiters accepted by yuarel_parse_query_ex() */
+#define QUERY_MAX_DELIMITERS 256
+
+/*
+ * The scanners read whole aligned blocks, which never cross a page but may
+ * extend past the end of the string.
+ */
+#ifdef __GNUC__
+#define YUAREL_NO_SANITIZE_ADDRESS __attribute__((no_sanitize_address))
+#else
+#define YUAREL_NO_SANITIZE_ADDRESS
+#endif
+
 /**
  * Parse a non-null terminated string into an integer.
  *
@@ -48,482 +70,2452 @@ static inline int natoi(const char *str, size_t len)
     return r;
 }
 
+/*
+ * SIMD dispatch
+ *
+ * The scanners of yuarel_parse_ex(), yuarel_split_path(), yuarel_parse_query()
+ * and yuarel_url_decode() look at one aligned block of the string at a time,
+ * and get a bit mask of the bytes to stop at from a kernel. The kernel is
+ * chosen on first use, the widest one the CPU supports, and can be forced
+ * with the YUAREL_FORCE_ISA environment variable or yuarel_simd_select().
+ * yuarel_parse() searches for single bytes with strchr(), which the C library
+ * already dispatches on the CPU.
+ */
+
+/* The most bytes a scanner stops at, besides NUL */
+#define SCAN_MAX_NEEDLES 12
+
+/* The bytes to stop at, each repeated to fill 16 bytes */
+struct scan_set
+{
+    unsigned char needles[SCAN_MAX_NEEDLES][16] __attribute__((aligned(16)));
+    int count;
+};
+
 /**
- * Check if a URL is relative (no scheme and hostname).
+ * Prepare the bytes to stop at.
  *
- * A relative URL starts with a "/" but does not include a scheme (e.g., "http://")
- * or a hostname. This function determines whether the given URL is relative based
- * on this criteria.
+ * @param set: The set to fill.
+ * @param chars: Up to SCAN_MAX_NEEDLES bytes.
+ * @param count: The number of bytes.
+ */
+static void scan_set_init(struct scan_set *set, const char *chars, size_t count)
+{
+    size_t i;
+
+    set->count = (int)count;
+    for (i = 0; i < count; i++)
+    {
+        memset(set->needles[i], chars[i], 16);
+    }
+}
+
+/* A byte repeated to fill a needle */
+#define SCAN_NEEDLE(c) {c, c, c, c, c, c, c, c, c, c, c, c, c, c, c, c}
+
+/* Needles compared by decode_component(), a constant count unrolls the kernel */
+#define DECODE_NEEDLES 3
+
+/* The fixed sets of bytes to stop at, the decode sets padded with repeats */
+static const struct scan_set stops_slash = {{SCAN_NEEDLE('/')}, 1};
+static const struct scan_set stops_escape = {{SCAN_NEEDLE('%'), SCAN_NEEDLE('%'), SCAN_NEEDLE('%')}, 3};
+static const struct scan_set stops_form = {{SCAN_NEEDLE('%'), SCAN_NEEDLE('+'), SCAN_NEEDLE('+')}, 3};
+static const struct scan_set stops_path = {{SCAN_NEEDLE('?'), SCAN_NEEDLE('#'), SCAN_NEEDLE('#')}, 3};
+static const struct scan_set stops_path_decode = {{SCAN_NEEDLE('?'), SCAN_NEEDLE('#'), SCAN_NEEDLE('%')}, 3};
+static const struct scan_set stops_query = {{SCAN_NEEDLE('#'), SCAN_NEEDLE('#'), SCAN_NEEDLE('#')}, 3};
+static const struct scan_set stops_query_decode = {{SCAN_NEEDLE('#'), SCAN_NEEDLE('%'), SCAN_NEEDLE('+')}, 3};
+
+/* Loads of whole words that may extend past the end of the string */
+typedef uint64_t __attribute__((may_alias)) scan_word;
+
+/**
+ * Mark the zero bytes of a word.
  *
- * @param url: The string containing the URL to check.
+ * @param x: The word.
  *
- * @return: 1 if the URL is relative, otherwise 0.
+ * @return: The word with the high bit of each zero byte set, and all others clear.
  */
-static inline int is_relative(const char *url) { return (*url == '/') ? 1 : 0; }
+static inline uint64_t zero_bytes(uint64_t x)
+{
+    const uint64_t low7 = 0x7f7f7f7f7f7f7f7full;
+
+    return ~(((x & low7) + low7) | x | low7);
+}
 
 /**
- * Parse the scheme of a URL by inserting a null terminator after the scheme.
+ * Scan an aligned 8 byte block, in plain C.
  *
- * This function attempts to parse the scheme part of a URL, which is followed by
- * a colon (":") and two slashes ("//"). If the scheme is present and valid, the
- * function null-terminates the scheme and returns a pointer to the host part of the URL.
+ * @param block: The block, aligned to 8 bytes.
+ * @param set: The bytes to stop at.
+ * @param count: The number of needles of `set` to compare.
  *
- * @warning: Modifies the input string as part of the parsing process.
+ * @return: A bit mask with bit i set if byte i is NUL or one of those needles.
+ */
+static inline YUAREL_NO_SANITIZE_ADDRESS uint64_t scan_scalar(const char *block, const struct scan_set *set, int count)
+{
+    uint64_t v = *(const scan_word *)block;
+    uint64_t found = zero_bytes(v);
+    int i;
+
+    for (i = 0; i < count; i++)
+    {
+        found |= zero_bytes(v ^ *(const scan_word *)set->needles[i]);
+    }
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    found = __builtin_bswap64(found);
+#endif
+
+    /* Gather the high bit of each byte into the low 8 bits */
+    return ((found >> 7) * 0x0102040810204080ull) >> 56;
+}
+
+#ifdef YUAREL_X86
+/**
+ * Scan an aligned 16 byte block with SSE2.
  *
- * @param str: The string containing the URL to parse. This string will be modified
- *             by null-terminating the scheme portion.
+ * @param block: The block, aligned to 16 bytes.
+ * @param set: The bytes to stop at.
+ * @param count: The number of needles of `set` to compare.
  *
- * @return: A pointer to the part of the string after the scheme (i.e., the host),
- *         or NULL if the scheme is not found or invalid.
+ * @return: A bit mask with bit i set if byte i is NUL or one of those needles.
  */
-static inline char *parse_scheme(char *str)
+static inline YUAREL_NO_SANITIZE_ADDRESS __attribute__((target("sse2"))) uint64_t
+scan_sse2(const char *block, const struct scan_set *set, int count)
 {
-    char *s;
+    __m128i v = _mm_load_si128((const __m128i *)block);
+    __m128i m = _mm_cmpeq_epi8(v, _mm_setzero_si128());
+    int i;
 
-    /* If not found or first in string, return error */
-    s = strchr(str, ':');
-    if (s == NULL || s == str)
+    for (i = 0; i < count; i++)
     {
-        return NULL;
+        m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_loadu_si128((const __m128i *)set->needles[i])));
     }
+    return (unsigned int)_mm_movemask_epi8(m);
+}
 
-    /* If not followed by two slashes, return error */
-    if (s[1] == '\0' || s[1] != '/' || s[2] == '\0' || s[2] != '/')
+/**
+ * Scan an aligned 32 byte block with AVX2.
+ *
+ * @param block: The block, aligned to 32 bytes.
+ * @param set: The bytes to stop at.
+ * @param count: The number of needles of `set` to compare.
+ *
+ * @return: A bit mask with bit i set if byte i is NUL or one of those needles.
+ */
+static inline YUAREL_NO_SANITIZE_ADDRESS __attribute__((target("avx2"))) uint64_t
+scan_avx2(const char *block, const struct scan_set *set, int count)
+{
+    __m256i v = _mm256_load_si256((const __m256i *)block);
+    __m256i m = _mm256_cmpeq_epi8(v, _mm256_setzero_si256());
+    int i;
+
+    for (i = 0; i < count; i++)
     {
-        return NULL;
+        __m256i n = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)set->needles[i]));
+        m = _mm256_or_si256(m, _mm256_cmpeq_epi8(v, n));
     }
+    return (uint32_t)_mm256_movemask_epi8(m);
+}
 
-    *s = '\0'; // Replace ':' with NULL
+/**
+ * Scan an aligned 64 byte block with AVX-512BW.
+ *
+ * @param block: The block, aligned to 64 bytes.
+ * @param set: The bytes to stop at.
+ * @param count: The number of needles of `set` to compare.
+ *
+ * @return: A bit mask with bit i set if byte i is NUL or one of those needles.
+ */
+static inline YUAREL_NO_SANITIZE_ADDRESS __attribute__((target("avx512f,avx512bw"))) uint64_t
+scan_avx512(const char *block, const struct scan_set *set, int count)
+{
+    __m512i v = _mm512_load_si512((const void *)block);
+    __mmask64 m = _mm512_cmpeq_epi8_mask(v, _mm512_setzero_si512());
+    int i;
 
-    return s + 3;
+    for (i = 0; i < count; i++)
+    {
+        __m512i n = _mm512_broadcast_i32x4(_mm_loadu_si128((const __m128i *)set->needles[i]));
+        m |= _mm512_cmpeq_epi8_mask(v, n);
+    }
+    return m;
 }
+#endif
+
+/* A kernel, see scan_scalar() */
+typedef uint64_t (*scan_fn)(const char *block, const struct scan_set *set, int count);
 
 /**
- * Find a character in a string, replace it with '\0' and return the next
- * character in the string.
+ * Null terminate a component at the first of the `stops` characters, and
+ * percent-decode it in place while scanning for the end.
  *
- * This function searches for a specific character in the string and, if found,
- * replaces it with a null terminator ('\0'). It then returns a pointer to the
- * character immediately after the one found. If the character is not found,
- * the function returns NULL.
+ * Only the delimiters found in the raw bytes end the component, so decoded
+ * characters such as "%3F" never split it. '%' and '+' are decoded when they
+ * are part of `stops`, '+' to a space. The stops are found with one bit mask
+ * per block, and the bytes between them are moved in one go.
  *
- * @warning: Modifies the input string as part of the parsing process.
+ * @param str: The start of the component.
+ * @param stops: The characters that end the component, plus '%' and '+' to decode.
+ * @param delim: Set to the character that ended the component, or '\0'.
+ * @param scan: The kernel.
+ * @param width: The size of the blocks it scans.
  *
- * @param str: The string to search in.
- * @param find: The character to search for.
+ * @return: The position of that character in the raw string.
+ */
+static inline __attribute__((always_inline)) char *decode_component_with(char *str, const struct scan_set *stops,
+                                                                        char *delim, scan_fn scan, uintptr_t width)
+{
+    char *read = str; /* First byte not yet moved */
+    char *write = str;
+    const char *block;
+    uint64_t mask;
+    char *p;
+    int hi, lo;
+
+    block = (const char *)((uintptr_t)str & ~(width - 1));
+    mask = scan(block, stops, DECODE_NEEDLES) & (~(uint64_t)0 << (str - block));
+
+    for (;;)
+    {
+        while (0 == mask)
+        {
+            block += width;
+            mask = scan(block, stops, DECODE_NEEDLES);
+        }
+        p = (char *)block + __builtin_ctzll(mask);
+        mask &= mask - 1;
+
+        /* Skip bytes that were part of an escape, or were written since */
+        if (p < read)
+        {
+            continue;
+        }
+
+        if (write == read)
+        {
+            write = read = p;
+        }
+        else
+        {
+            /* Runs between escapes are short, a call costs more than the copy */
+            while (read < p)
+            {
+                *write++ = *read++;
+            }
+        }
+
+        if ('+' == *p)
+        {
+            *write++ = ' ';
+            read++;
+        }
+        else if ('%' == *p)
+        {
+            hi = hex_value(p[1]);
+            lo = (hi >= 0) ? hex_value(p[2]) : -1;
+            if (lo >= 0)
+            {
+                *write++ = (char)(hi << 4 | lo);
+                read += 3;
+            }
+            else
+            {
+                *write++ = '%';
+                read++;
+            }
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    *delim = *read;
+    *write = '\0';
+    return read;
+}
+
+/**
+ * Split a path into parts at its slashes, see yuarel_split_path_ex().
  *
- * @return: A pointer to the character after the found character, or NULL if
- *         the character was not found.
+ * @param path: The non-empty path.
+ * @param parts: Where to store the parts.
+ * @param lengths: Where to store the lengths of the parts, or NULL.
+ * @param max_parts: The size of `parts`, at least 1.
+ * @param scan: The kernel.
+ * @param width: The size of the blocks it scans.
+ *
+ * @return: The number of parts.
  */
-static inline char *find_and_terminate(char *str, char find)
+static inline __attribute__((always_inline)) int split_path_with(char *path, char **parts, size_t *lengths,
+                                                                 int max_parts, scan_fn scan, uintptr_t width)
 {
-    str = strchr(str, find);
-    if (NULL == str)
+    char *start = path;
+    int i = 0;
+    const char *block;
+    uint64_t mask;
+
+    block = (const char *)((uintptr_t)path & ~(width - 1));
+    mask = scan(block, &stops_slash, 1) & (~(uint64_t)0 << (path - block));
+
+    for (;;)
     {
-        return NULL;
+        char *p;
+
+        while (0 == mask)
+        {
+            block += width;
+            mask = scan(block, &stops_slash, 1);
+        }
+        p = (char *)block + __builtin_ctzll(mask);
+        mask &= mask - 1;
+
+        /* Double slashes leave an empty part, which is skipped */
+        if (p > start)
+        {
+            parts[i] = start;
+            if (NULL != lengths)
+            {
+                lengths[i] = p - start;
+            }
+            i++;
+
+            if ('\0' == *p)
+            {
+                break;
+            }
+            *p = '\0';
+
+            if (i == max_parts)
+            {
+                break;
+            }
+        }
+        else if ('\0' == *p)
+        {
+            break;
+        }
+
+        start = p + 1;
     }
 
-    *str = '\0';
-    return str + 1;
+    return i;
 }
 
-/*
-    Dev Note: Regarding find_fragment(), find_query() and find_path()
-                Yes, the following functions could be implemented as preprocessor macros
-                instead of inline functions, but I think that this approach will be more
-                clean in this case.
-*/
+/**
+ * State of the scanner for the bytes yuarel_parse_query_ex() stops at.
+ */
+struct query_scanner
+{
+    char set[4 + QUERY_MAX_DELIMITERS]; /* strcspn() set of the bytes to stop at */
+    const char *pos;                    /* Next byte to scan with strcspn() */
+    int vector;                         /* Nonzero to use scan(), not strcspn() */
+    struct scan_set needles;            /* The bytes to stop at, for scan() */
+    const char *block;                  /* Aligned block being scanned */
+    uint64_t mask;                      /* Bytes left to stop at in the block */
+};
 
 /**
- * Find the fragment part of a URL (everything after the '#' character).
- *
- * This function searches for the fragment delimiter ('#') in the URL and,
- * if found, replaces it with a null terminator ('\0'). It returns a pointer
- * to the part of the string after the fragment delimiter.
+ * Prepare a scanner for a query string.
  *
- * @param str: The URL string to search in.
+ * @param s: The scanner.
+ * @param query: The query string.
+ * @param delimiters: The delimiter characters.
+ * @param decode: Nonzero to also stop at '%' and '+'.
+ * @param scan: The kernel.
+ * @param width: The size of the blocks it scans.
  *
- * @return: A pointer to the part of the string after the fragment part,
- *         or NULL if no fragment is found.
+ * @return: 0 on success, or -1 if there are too many delimiters.
  */
-static inline char *find_fragment(char *str) { return find_and_terminate(str, '#'); }
+static inline __attribute__((always_inline)) int query_scan_init(struct query_scanner *s, const char *query,
+                                                                  const char *delimiters, int decode, scan_fn scan,
+                                                                  uintptr_t width)
+{
+    size_t len = strlen(delimiters);
+    size_t n = 0;
+
+    if (len > QUERY_MAX_DELIMITERS)
+    {
+        return -1;
+    }
+
+    s->set[n++] = '=';
+    if (decode)
+    {
+        s->set[n++] = '%';
+        s->set[n++] = '+';
+    }
+    memcpy(s->set + n, delimiters, len + 1);
+
+    if (len > QUERY_MAX_VECTOR_DELIMITERS)
+    {
+        s->vector = 0;
+        s->pos = query;
+        return 0;
+    }
+
+    s->vector = 1;
+    scan_set_init(&s->needles, s->set, n + len);
+    s->block = (const char *)((uintptr_t)query & ~(width - 1));
+    s->mask = scan(s->block, &s->needles, s->needles.count) & (~(uint64_t)0 << (query - s->block));
+    return 0;
+}
 
 /**
- * Find the query part of a URL (everything after the '?' character).
- *
- * This function searches for the query delimiter ('?') in the URL and,
- * if found, replaces it with a null terminator ('\0'). It returns a pointer
- * to the part of the string after the query delimiter.
+ * Find the next byte to stop at.
  *
- * @param str: The URL string to search in.
+ * @param s: The scanner.
+ * @param scan: The kernel.
+ * @param width: The size of the blocks it scans.
  *
- * @return: A pointer to the part of the string after the query part,
- *         or NULL if no query is found.
+ * @return: A pointer to the next '=', delimiter or NUL, or '%' or '+' when
+ *          decoding. Must not be called again after NUL.
  */
-static inline char *find_query(char *str) { return find_and_terminate(str, '?'); }
+static inline __attribute__((always_inline)) char *query_scan_next(struct query_scanner *s, scan_fn scan,
+                                                                   uintptr_t width)
+{
+    const char *p;
+
+    if (s->vector)
+    {
+        while (0 == s->mask)
+        {
+            s->block += width;
+            s->mask = scan(s->block, &s->needles, s->needles.count);
+        }
+        p = s->block + __builtin_ctzll(s->mask);
+        s->mask &= s->mask - 1;
+        return (char *)p;
+    }
+
+    p = s->pos + strcspn(s->pos, s->set);
+    s->pos = p + 1;
+    return (char *)p;
+}
 
 /**
- * Find the path part of a URL (everything after the '/' character).
- *
- * This function searches for the path delimiter ('/') in the URL and,
- * if found, replaces it with a null terminator ('\0'). It returns a pointer
- * to the part of the string after the path delimiter.
+ * Split a query string into key-value pairs, see yuarel_parse_query_ex().
  *
- * @param str: The URL string to search in.
+ * @param query: The non-empty query string.
+ * @param delimiters: The delimiter characters.
+ * @param params: Where to store the pairs.
+ * @param max_params: The size of `params`, at least 1.
+ * @param decode: Nonzero to percent-decode the keys and values.
+ * @param scan: The kernel.
+ * @param width: The size of the blocks it scans.
  *
- * @return: A pointer to the part of the string after the path part,
- *         or NULL if no path is found.
+ * @return: The number of pairs, or -1 if there are too many delimiters.
  */
-static inline char *find_path(char *str) { return find_and_terminate(str, '/'); }
+static inline __attribute__((always_inline)) int parse_query_with(char *query, const char *delimiters,
+                                                                  struct yuarel_param *params, int max_params,
+                                                                  int decode, scan_fn scan, uintptr_t width)
+{
+    struct query_scanner scanner;
+    int param_count = 0;
+    char *run = query;   /* First byte not yet copied when decoding */
+    char *write = query; /* Where decoded bytes go */
+
+    if (-1 == query_scan_init(&scanner, query, delimiters, decode, scan, width))
+    {
+        return -1;
+    }
+    params[0].key = query;
+    params[0].val = NULL;
+
+    for (;;)
+    {
+        char *p = query_scan_next(&scanner, scan, width);
+        char c = *p;
+
+        /* Skip bytes that were part of an escape */
+        if (p < run)
+        {
+            continue;
+        }
+
+        if (decode)
+        {
+            if (write != run)
+            {
+                memmove(write, run, p - run);
+            }
+            write += p - run;
+        }
+        else
+        {
+            write = p;
+        }
+        run = p + 1;
+
+        if ('\0' == c)
+        {
+            *write = '\0';
+            param_count++;
+            break;
+        }
+
+        if ('=' == c)
+        {
+            if (NULL == params[param_count].val)
+            {
+                /* Value Is Present. Split and record */
+                *write++ = '\0';
+                params[param_count].val = write;
+            }
+            else if (decode)
+            {
+                *write++ = '=';
+            }
+        }
+        else if (decode && '+' == c)
+        {
+            *write++ = ' ';
+        }
+        else if (decode && '%' == c)
+        {
+            int hi = hex_value(p[1]);
+            int lo = (hi >= 0) ? hex_value(p[2]) : -1;
+
+            if (lo >= 0)
+            {
+                *write++ = (char)(hi << 4 | lo);
+                run = p + 3;
+            }
+            else
+            {
+                *write++ = '%';
+            }
+        }
+        else
+        {
+            /* Delimiter, terminate this kv */
+            *write++ = '\0';
+            param_count++;
+            if (param_count == max_params)
+            {
+                break;
+            }
+
+            params[param_count].key = write;
+            params[param_count].val = NULL;
+        }
+    }
+
+    return param_count;
+}
+
+/*
+ * The scanners are compiled once for each kernel, with the kernel inlined
+ * into their loops, so that only the entry points are called through the
+ * table of the kernel in use.
+ */
+#define SCAN_INSTANCE(isa, width, target)                                                                       \
+    static target char *decode_component_##isa(char *str, const struct scan_set *stops, char *delim)            \
+    {                                                                                                           \
+        return decode_component_with(str, stops, delim, scan_##isa, width);                                     \
+    }                                                                                                           \
+    static target int split_path_##isa(char *path, char **parts, size_t *lengths, int max_parts)                \
+    {                                                                                                           \
+        return split_path_with(path, parts, lengths, max_parts, scan_##isa, width);                             \
+    }                                                                                                           \
+    static target int parse_query_##isa(char *query, const char *delimiters, struct yuarel_param *params,       \
+                                        int max_params, int decode)                                             \
+    {                                                                                                           \
+        return parse_query_with(query, delimiters, params, max_params, decode, scan_##isa, width);              \
+    }
+
+SCAN_INSTANCE(scalar, 8, )
+#ifdef YUAREL_X86
+SCAN_INSTANCE(sse2, 16, __attribute__((target("sse2"))))
+SCAN_INSTANCE(avx2, 32, __attribute__((target("avx2"))))
+SCAN_INSTANCE(avx512, 64, __attribute__((target("avx512f,avx512bw"))))
+#endif
+
+struct scan_kernel
+{
+    const char *name;
+    int level; /* YUAREL_ISA_* */
+    char *(*decode_component)(char *str, const struct scan_set *stops, char *delim);
+    int (*split_path)(char *path, char **parts, size_t *lengths, int max_parts);
+    int (*parse_query)(char *query, const char *delimiters, struct yuarel_param *params, int max_params, int decode);
+};
+
+/* Best first, the scalar kernel always works */
+static const struct scan_kernel scan_kernels[] = {
+#ifdef YUAREL_X86
+    {"avx512bw", YUAREL_ISA_AVX512, decode_component_avx512, split_path_avx512, parse_query_avx512},
+    {"avx2", YUAREL_ISA_AVX2, decode_component_avx2, split_path_avx2, parse_query_avx2},
+    {"sse2", YUAREL_ISA_SSE2, decode_component_sse2, split_path_sse2, parse_query_sse2},
+#endif
+    {"scalar", YUAREL_ISA_SCALAR, decode_component_scalar, split_path_scalar, parse_query_scalar},
+};
+
+#define SCAN_KERNEL_COUNT (sizeof(scan_kernels) / sizeof(scan_kernels[0]))
+
+/* The kernel in use, NULL until the first scan */
+static const struct scan_kernel *scan_current;
+
+/* Nonzero if the SSSE3 code of other modules may run along with the kernel in use */
+static int scan_ssse3;
 
 /**
- * @brief Parse a URL into its components.
+ * Check if the CPU can run a kernel.
  *
- * This function parses a URL into its components:
- *     scheme, host, port, path, query, and fragment.
- * The URL string should be in one of the following formats:
+ * @param kernel: The kernel.
+ *
+ * @return: 1 if supported, otherwise 0.
+ */
+static int scan_kernel_supported(const struct scan_kernel *kernel)
+{
+#ifdef YUAREL_X86
+    __builtin_cpu_init();
+    if (split_path_avx512 == kernel->split_path)
+    {
+        return __builtin_cpu_supports("avx512bw");
+    }
+    if (split_path_avx2 == kernel->split_path)
+    {
+        return __builtin_cpu_supports("avx2");
+    }
+    if (split_path_sse2 == kernel->split_path)
+    {
+        return __builtin_cpu_supports("sse2");
+    }
+#endif
+    return split_path_scalar == kernel->split_path;
+}
+
+/**
+ * Find a kernel the CPU supports.
+ *
+ * @param name: The name of the kernel, or NULL for the best one.
+ *
+ * @return: The kernel, or NULL if it is unknown or not supported.
+ */
+static const struct scan_kernel *scan_kernel_find(const char *name)
+{
+    size_t i;
+
+    for (i = 0; i < SCAN_KERNEL_COUNT; i++)
+    {
+        if ((NULL == name || 0 == strcmp(name, scan_kernels[i].name)) && scan_kernel_supported(&scan_kernels[i]))
+        {
+            return &scan_kernels[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Make a kernel the one in use.
+ *
+ * SSSE3 comes with the avx2 and avx512bw kernels. A CPU the sse2 kernel was
+ * chosen for may still have it, unless that kernel or the scalar one was
+ * asked for by name.
+ *
+ * @param kernel: The kernel.
+ * @param forced: Nonzero if the kernel was asked for by name.
+ */
+static void scan_kernel_set(const struct scan_kernel *kernel, int forced)
+{
+    int ssse3 = kernel->level >= YUAREL_ISA_AVX2;
+
+#ifdef YUAREL_X86
+    if (!forced && YUAREL_ISA_SSE2 == kernel->level)
+    {
+        __builtin_cpu_init();
+        ssse3 = __builtin_cpu_supports("ssse3");
+    }
+#else
+    (void)forced;
+#endif
+    /* Published by the release store of the kernel */
+    __atomic_store_n(&scan_ssse3, ssse3, __ATOMIC_RELAXED);
+    __atomic_store_n(&scan_current, kernel, __ATOMIC_RELEASE);
+}
+
+/**
+ * Get the kernel in use, choosing it on first use.
+ *
+ * @return: The kernel.
+ */
+static inline const struct scan_kernel *scan_kernel(void)
+{
+    const struct scan_kernel *kernel = __atomic_load_n(&scan_current, __ATOMIC_ACQUIRE);
+
+    if (NULL == kernel)
+    {
+        /* Threads racing here all store the same kernel */
+        int forced = 1;
+
+        kernel = scan_kernel_find(getenv("YUAREL_FORCE_ISA"));
+        if (NULL == kernel)
+        {
+            kernel = scan_kernel_find(NULL);
+            forced = 0;
+        }
+        scan_kernel_set(kernel, forced);
+    }
+    return kernel;
+}
+
+/**
+ * Null terminate and percent-decode a component with the kernel in use, see
+ * decode_component_with().
+ *
+ * @param str: The start of the component.
+ * @param stops: The characters that end the component, plus '%' and '+' to decode.
+ * @param delim: Set to the character that ended the component, or '\0'.
+ *
+ * @return: The position of that character in the raw string.
+ */
+static inline char *decode_component(char *str, const struct scan_set *stops, char *delim)
+{
+    return scan_kernel()->decode_component(str, stops, delim);
+}
+
+/**
+ * @brief Get the name of the SIMD kernel the scanners use.
+ *
+ * The kernel is chosen on first use: the one named by the YUAREL_FORCE_ISA
+ * environment variable if the CPU supports it, otherwise the widest one it
+ * supports. The names are "avx512bw", "avx2", "sse2" and "scalar", the last
+ * of which is available everywhere.
+ *
+ * @return The name of the kernel.
+ */
+const char *yuarel_simd_kernel(void)
+{
+    return scan_kernel()->name;
+}
+
+/**
+ * Get the instruction set of the SIMD kernel in use, choosing the kernel on
+ * first use like yuarel_simd_kernel().
+ *
+ * @return: One of the YUAREL_ISA_* values.
+ */
+int yuarel_simd_level(void)
+{
+    return scan_kernel()->level;
+}
+
+/**
+ * Check if code compiled for SSSE3 may run, choosing the kernel on first use
+ * like yuarel_simd_kernel().
+ *
+ * @return: 1 with the avx2 and avx512bw kernels, and with the sse2 kernel on
+ *          a CPU with SSSE3 unless a kernel was asked for by name, otherwise 0.
+ */
+int yuarel_simd_ssse3(void)
+{
+    scan_kernel();
+    return __atomic_load_n(&scan_ssse3, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Choose the SIMD kernel the scanners use.
+ *
+ * Meant for tests and benchmarks. Scans already running in other threads keep
+ * the kernel they started with.
+ *
+ * @param[in] name The name of the kernel, or NULL for the widest one the CPU supports.
+ *
+ * @return 0 on success, otherwise -1 if the kernel is unknown or not supported.
+ */
+int yuarel_simd_select(const char *name)
+{
+    const struct scan_kernel *kernel = scan_kernel_find(name);
+
+    if (NULL == kernel)
+    {
+        return -1;
+    }
+    scan_kernel_set(kernel, NULL != name);
+    return 0;
+}
+
+/**
+ * Check if a URL is relative (no scheme and hostname).
+ *
+ * A relative URL starts with a "/" but does not include a scheme (e.g., "http://")
+ * or a hostname. This function determines whether the given URL is relative based
+ * on this criteria.
+ *
+ * @param url: The string containing the URL to check.
+ *
+ * @return: 1 if the URL is relative, otherwise 0.
+ */
+static inline int is_relative(const char *url) { return (*url == '/') ? 1 : 0; }
+
+/* A scheme name of up to 8 bytes as one word, the first byte lowest */
+#define SCHEME_WORD(a, b, c, d, e, f) \
+    ((uint64_t)(a) | (uint64_t)(b) << 8 | (uint64_t)(c) << 16 | (uint64_t)(d) << 24 | (uint64_t)(e) << 32 | \
+     (uint64_t)(f) << 40)
+
+/* Known schemes with their default port, in the order of enum yuarel_scheme
+ * from YUAREL_SCHEME_HTTP on, which also puts the most common first */
+static const struct
+{
+    uint64_t word;
+    int id;
+    int port;
+} schemes[] = {
+    {SCHEME_WORD('h', 't', 't', 'p', 0, 0), YUAREL_SCHEME_HTTP, 80},
+    {SCHEME_WORD('h', 't', 't', 'p', 's', 0), YUAREL_SCHEME_HTTPS, 443},
+    {SCHEME_WORD('w', 's', 0, 0, 0, 0), YUAREL_SCHEME_WS, 80},
+    {SCHEME_WORD('w', 's', 's', 0, 0, 0), YUAREL_SCHEME_WSS, 443},
+    {SCHEME_WORD('f', 't', 'p', 0, 0, 0), YUAREL_SCHEME_FTP, 21},
+    {SCHEME_WORD('f', 't', 'p', 's', 0, 0), YUAREL_SCHEME_FTPS, 990},
+    {SCHEME_WORD('s', 'f', 't', 'p', 0, 0), YUAREL_SCHEME_SFTP, 22},
+    {SCHEME_WORD('s', 's', 'h', 0, 0, 0), YUAREL_SCHEME_SSH, 22},
+    {SCHEME_WORD('g', 'i', 't', 0, 0, 0), YUAREL_SCHEME_GIT, 9418},
+    {SCHEME_WORD('f', 'i', 'l', 'e', 0, 0), YUAREL_SCHEME_FILE, 0},
+    {SCHEME_WORD('g', 'o', 'p', 'h', 'e', 'r'), YUAREL_SCHEME_GOPHER, 70},
+    {SCHEME_WORD('l', 'd', 'a', 'p', 0, 0), YUAREL_SCHEME_LDAP, 389},
+    {SCHEME_WORD('l', 'd', 'a', 'p', 's', 0), YUAREL_SCHEME_LDAPS, 636},
+    {SCHEME_WORD('t', 'e', 'l', 'n', 'e', 't'), YUAREL_SCHEME_TELNET, 23},
+    {SCHEME_WORD('i', 'm', 'a', 'p', 0, 0), YUAREL_SCHEME_IMAP, 143},
+    {SCHEME_WORD('i', 'm', 'a', 'p', 's', 0), YUAREL_SCHEME_IMAPS, 993},
+    {SCHEME_WORD('p', 'o', 'p', '3', 0, 0), YUAREL_SCHEME_POP3, 110},
+    {SCHEME_WORD('s', 'm', 't', 'p', 0, 0), YUAREL_SCHEME_SMTP, 25},
+    {SCHEME_WORD('r', 't', 's', 'p', 0, 0), YUAREL_SCHEME_RTSP, 554},
+    {SCHEME_WORD('m', 'q', 't', 't', 0, 0), YUAREL_SCHEME_MQTT, 1883},
+    {SCHEME_WORD('r', 'e', 'd', 'i', 's', 0), YUAREL_SCHEME_REDIS, 6379},
+};
+
+/**
+ * Look up a scheme by its lowercase name as a word.
+ *
+ * @param word: The name, packed by SCHEME_WORD().
+ *
+ * @return: The YUAREL_SCHEME_* value, YUAREL_SCHEME_OTHER if not known.
+ */
+static inline int scheme_lookup(uint64_t word)
+{
+    size_t i;
+
+    for (i = 0; i < sizeof(schemes) / sizeof(schemes[0]); i++)
+    {
+        if (schemes[i].word == word)
+        {
+            return schemes[i].id;
+        }
+    }
+    return YUAREL_SCHEME_OTHER;
+}
+
+/**
+ * Pack up to 8 bytes of a scheme name into a lowercase word.
+ *
+ * @param word: The word to add the byte to.
+ * @param c: The byte.
+ * @param i: The position of the byte, below 8.
+ *
+ * @return: The word with the byte added.
+ */
+static inline uint64_t scheme_word_add(uint64_t word, unsigned char c, int i)
+{
+    if ('A' <= c && c <= 'Z')
+    {
+        c |= 0x20;
+    }
+    return word | (uint64_t)c << (8 * i);
+}
+
+/**
+ * Get the YUAREL_SCHEME_* value of a scheme name.
+ *
+ * @param str: The scheme name.
+ * @param len: The length of the name.
+ *
+ * @return: The YUAREL_SCHEME_* value.
+ */
+static int scheme_identify(const char *str, size_t len)
+{
+    uint64_t word = 0;
+    size_t i;
+
+    if (0 == len)
+    {
+        return YUAREL_SCHEME_NONE;
+    }
+    if (len > 8)
+    {
+        return YUAREL_SCHEME_OTHER;
+    }
+    for (i = 0; i < len; i++)
+    {
+        word = scheme_word_add(word, (unsigned char)str[i], (int)i);
+    }
+    return scheme_lookup(word);
+}
+
+/**
+ * Find the end of the scheme of a URL, and recognize the scheme.
+ *
+ * Lowercase "http" and "https" are matched directly. Every other known scheme
+ * is at most 8 bytes long, so while the first 8 bytes are searched for the
+ * ':', the lowercase name is packed into one word and then looked up with a
+ * single compare per known scheme. Only longer schemes are searched with
+ * strcspn().
+ *
+ * @param str: The URL string.
+ * @param scheme_id: Set to the YUAREL_SCHEME_* value, if a ':' is found.
+ *
+ * @return: A pointer to the first ':', '?', '#' or '\0' in the string.
+ */
+static inline char *scheme_end(char *str, int *scheme_id)
+{
+    uint64_t word = 0;
+    int i;
+
+    /* Most URLs are "http:" or "https:" in lowercase */
+    if ('h' == str[0] && 't' == str[1] && 't' == str[2] && 'p' == str[3])
+    {
+        if (':' == str[4])
+        {
+            *scheme_id = YUAREL_SCHEME_HTTP;
+            return str + 4;
+        }
+        if ('s' == str[4] && ':' == str[5])
+        {
+            *scheme_id = YUAREL_SCHEME_HTTPS;
+            return str + 5;
+        }
+    }
+
+    for (i = 0; i < 8; i++)
+    {
+        unsigned char c = (unsigned char)str[i];
+
+        if (':' == c)
+        {
+            *scheme_id = scheme_lookup(word);
+            return str + i;
+        }
+        if ('\0' == c || '?' == c || '#' == c)
+        {
+            return str + i;
+        }
+        word = scheme_word_add(word, c, i);
+    }
+
+    str += 8 + strcspn(str + 8, ":?#");
+    *scheme_id = YUAREL_SCHEME_OTHER;
+    return str;
+}
+
+/**
+ * Parse the scheme of a URL by inserting a null terminator after the scheme.
+ *
+ * This function attempts to parse the scheme part of a URL, which is followed by
+ * a colon (":") and two slashes ("//"). If the scheme is present and valid, the
+ * function null-terminates the scheme and returns a pointer to the host part of the URL.
+ *
+ * @warning: Modifies the input string as part of the parsing process.
+ *
+ * @param str: The string containing the URL to parse. This string will be modified
+ *             by null-terminating the scheme portion.
+ * @param scheme_id: Set to the YUAREL_SCHEME_* value of the scheme on success.
+ *
+ * @return: A pointer to the part of the string after the scheme (i.e., the host),
+ *         or NULL if the scheme is not found or invalid.
+ */
+static inline char *parse_scheme(char *str, int *scheme_id)
+{
+    char *s;
+    int id = YUAREL_SCHEME_OTHER;
+
+    /* If not found or first in string, return error. The query and fragment
+     * are already cut off, so the first ':' ends the scheme. */
+    s = scheme_end(str, &id);
+    if (':' != *s || s == str)
+    {
+        return NULL;
+    }
+
+    /* If not followed by two slashes, return error */
+    if (s[1] == '\0' || s[1] != '/' || s[2] == '\0' || s[2] != '/')
+    {
+        return NULL;
+    }
+
+    *s = '\0'; // Replace ':' with NULL
+    *scheme_id = id;
+
+    return s + 3;
+}
+
+/**
+ * Find a character in a string, replace it with '\0' and return the next
+ * character in the string.
+ *
+ * This function searches for a specific character in the string and, if found,
+ * replaces it with a null terminator ('\0'). It then returns a pointer to the
+ * character immediately after the one found. If the character is not found,
+ * the function returns NULL.
+ *
+ * @warning: Modifies the input string as part of the parsing process.
+ *
+ * @param str: The string to search in.
+ * @param find: The character to search for.
+ *
+ * @return: A pointer to the character after the found character, or NULL if
+ *         the character was not found.
+ */
+static inline char *find_and_terminate(char *str, char find)
+{
+    str = strchr(str, find);
+    if (NULL == str)
+    {
+        return NULL;
+    }
+
+    *str = '\0';
+    return str + 1;
+}
+
+/*
+    Dev Note: Regarding find_fragment(), find_query() and find_path()
+                Yes, the following functions could be implemented as preprocessor macros
+                instead of inline functions, but I think that this approach will be more
+                clean in this case.
+*/
+
+/**
+ * Find the fragment part of a URL (everything after the '#' character).
+ *
+ * This function searches for the fragment delimiter ('#') in the URL and,
+ * if found, replaces it with a null terminator ('\0'). It returns a pointer
+ * to the part of the string after the fragment delimiter.
+ *
+ * @param str: The URL string to search in.
+ *
+ * @return: A pointer to the part of the string after the fragment part,
+ *         or NULL if no fragment is found.
+ */
+static inline char *find_fragment(char *str) { return find_and_terminate(str, '#'); }
+
+/**
+ * Find the query part of a URL (everything after the '?' character).
+ *
+ * This function searches for the query delimiter ('?') in the URL and,
+ * if found, replaces it with a null terminator ('\0'). It returns a pointer
+ * to the part of the string after the query delimiter.
+ *
+ * @param str: The URL string to search in.
+ *
+ * @return: A pointer to the part of the string after the query part,
+ *         or NULL if no query is found.
+ */
+static inline char *find_query(char *str) { return find_and_terminate(str, '?'); }
+
+/**
+ * Find the path part of a URL (everything after the '/' character).
+ *
+ * This function searches for the path delimiter ('/') in the URL and,
+ * if found, replaces it with a null terminator ('\0'). It returns a pointer
+ * to the part of the string after the path delimiter.
+ *
+ * @param str: The URL string to search in.
+ *
+ * @return: A pointer to the part of the string after the path part,
+ *         or NULL if no path is found.
+ */
+static inline char *find_path(char *str) { return find_and_terminate(str, '/'); }
+
+/**
+ * @brief Parse a URL into its components.
+ *
+ * This function parses a URL into its components:
+ *     scheme, host, port, path, query, and fragment.
+ * The URL string should be in one of the following formats:
+ *
+ * Absolute URL:
+ * scheme ":" [ "//" ] [ username ":" password "@" ] host [ ":" port ] [ "/" ] [ path ] [ "?" query ] [ "#" fragment ]
+ *
+ * Relative URL:
+ * path [ "?" query ] [ "#" fragment ]
+ *
+ * The following parts will be parsed to the corresponding struct member.
+ *
+ * @warning: Modifies the input string as part of the parsing process.
+ *
+ * @param[out] url A pointer to the `yuarel` struct where the parsed values will be stored.
+ * @param[in,out] url_str A pointer to the URL string to be parsed. The string will be modified.
+ *
+ * @return 0 on success, otherwise -1 on error.
+ */
+int yuarel_parse(struct yuarel *url, char *url_str)
+{
+    if (NULL == url || NULL == url_str)
+    {
+        return -1;
+    }
+
+    memset(url, 0, sizeof(struct yuarel));
+
+    /* (Fragment) */
+    url->fragment = find_fragment(url_str);
+
+    /* (Query) */
+    url->query = find_query(url_str);
+
+    /* Relative URL? Parse scheme and hostname */
+    if (is_relative(url_str))
+    {
+        /* Relative (Path) Found */
+        url->path = find_path(url_str);
+        return 0;
+    }
+
+    /* Scheme */
+    url->scheme = url_str;
+    url_str = parse_scheme(url_str, &url->scheme_id);
+    if (url_str == NULL)
+    {
+        /* Scheme Missing */
+        return -1;
+    }
+
+    /* Check if host is omitted but path is provided (e.g. File URI) */
+    if ('/' == *url_str)
+    {
+        /* URI Omits Hostname. Record only path */
+        url->path = url_str;
+        return 0;
+    }
+
+    /* Host */
+    if ('\0' == *url_str)
+    {
+        return -1;
+    }
+    url->host = url_str;
+
+    /* (Path) */
+    url->path = find_path(url_str);
+
+    /* (Credentials) */
+    url_str = strchr(url->host, '@');
+    if (NULL != url_str)
+    {
+        /* Missing credentials? */
+        if (url_str == url->host)
+        {
+            return -1;
+        }
+
+        url->username = url->host;
+        url->host = url_str + 1;
+        *url_str = '\0';
+
+        url_str = strchr(url->username, ':');
+        if (NULL != url_str)
+        {
+            url->password = url_str + 1;
+            *url_str = '\0';
+        }
+    }
+
+    /* Missing hostname? */
+    if ('\0' == *url->host)
+    {
+        return -1;
+    }
+
+    /* IPv6 hostname */
+    if ('[' == url->host[0])
+    {
+        /* IPv6 Literal */
+        // If hostname starts with square bracket, it is IPv6 literal
+        // example:
+        // http://[1080:0:0:0:8:800:200C:417A]:80/index.html
+        // http://[3ffe:2a00:100:7031::1]
+        // http://[::192.9.5.5]/ipng
+        url->host++;
+
+        /* Locate end of IPv6 Literal marker */
+        url_str = strchr(url->host, ']');
+        if (NULL == url_str)
+        {
+            /* Missing end ']' marker */
+            return -1;
+        }
+
+        /* Null terminate IPv6 host literal (In place of ']') */
+        *url_str = '\0';
+
+        /* Check if next character is ':' is present.
+         * Which would indicate port number is present */
+        url_str++;
+        if ('\0' == *url_str)
+        {
+            /* Already end of host string. No port number present */
+            url_str = NULL;
+        }
+        else if (':' != *url_str)
+        {
+            /* Port number delimiter is missing. Invalid. */
+            return -1;
+        }
+    }
+    else
+    {
+        /* Check for port number delimiter */
+        // example: http://192.156.1.1:80 ('<HOST>:<PORT>')
+        url_str = strchr(url->host, ':');
+    }
+
+    if (NULL != url_str && (NULL == url->path || url_str < url->path))
+    {
+        *(url_str++) = '\0';
+        if ('\0' == *url_str)
+        {
+            return -1;
+        }
+
+        if (url->path)
+        {
+            url->port = natoi(url_str, url->path - url_str - 1);
+        }
+        else
+        {
+            url->port = atoi(url_str);
+        }
+    }
+
+    /* Missing hostname? */
+    if ('\0' == *url->host)
+    {
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * Check if any field after the given one is requested.
+ *
+ * The YUAREL_FIELD_* bits are ordered the same way as the components appear
+ * in a URL, so this tells whether the parser has to continue scanning.
+ *
+ * @param fields: A bitmask of YUAREL_FIELD_* values.
+ * @param field: The last component that has been parsed.
+ *
+ * @return: Non-zero if a later component is requested.
+ */
+static inline int fields_after(int fields, int field) { return fields & ~((field << 1) - 1); }
+
+/**
+ * Parse the authority part of a URL between `str` and `end`.
+ *
+ * Handles credentials, IPv6 literals and the port with the same rules as
+ * yuarel_parse(), but only null terminates the requested components. Nothing
+ * at or after `end` is modified.
+ *
+ * @warning: Modifies the input string as part of the parsing process.
+ *
+ * @param url: The struct where the requested components are stored.
+ * @param str: The start of the authority.
+ * @param end: The end of the authority ('/', '?', '#' or '\0').
+ * @param fields: A bitmask of YUAREL_FIELD_* values.
+ *
+ * @return: 0 on success, otherwise -1 on error.
+ */
+static int parse_authority(struct yuarel *url, char *str, char *end, int fields)
+{
+    char *host = str;
+    char *host_end;
+    char *port = NULL;
+    char *at = memchr(str, '@', end - str);
+
+    /* (Credentials) */
+    if (NULL != at)
+    {
+        if (at == str)
+        {
+            /* Missing credentials */
+            return -1;
+        }
+
+        host = at + 1;
+        if (fields & (YUAREL_FIELD_USERNAME | YUAREL_FIELD_PASSWORD))
+        {
+            char *colon = memchr(str, ':', at - str);
+
+            if (fields & YUAREL_FIELD_USERNAME)
+            {
+                url->username = str;
+            }
+            if (NULL != colon)
+            {
+                if (fields & YUAREL_FIELD_PASSWORD)
+                {
+                    url->password = colon + 1;
+                }
+                *colon = '\0';
+            }
+            *at = '\0';
+        }
+    }
+
+    /* Missing hostname? */
+    if (host == end)
+    {
+        return -1;
+    }
+
+    if (!fields_after(fields, YUAREL_FIELD_PASSWORD))
+    {
+        return 0;
+    }
+
+    if ('[' == *host)
+    {
+        /* IPv6 Literal, ends at ']' and may be followed by a port */
+        host_end = memchr(host, ']', end - host);
+        if (NULL == host_end)
+        {
+            return -1;
+        }
+
+        host++;
+        if (host_end + 1 != end)
+        {
+            if (':' != host_end[1])
+            {
+                return -1;
+            }
+            port = host_end + 1;
+        }
+    }
+    else
+    {
+        port = memchr(host, ':', end - host);
+        host_end = (NULL != port) ? port : end;
+    }
+
+    /* Missing hostname or port? */
+    if (host == host_end || (NULL != port && port + 1 == end))
+    {
+        return -1;
+    }
+
+    if (fields & YUAREL_FIELD_HOST)
+    {
+        url->host = host;
+        *host_end = '\0';
+    }
+
+    if ((fields & YUAREL_FIELD_PORT) && NULL != port)
+    {
+        size_t len = 0;
+
+        port++;
+        while (port + len < end && '0' <= port[len] && port[len] <= '9')
+        {
+            len++;
+        }
+        url->port = natoi(port, len);
+    }
+
+    return 0;
+}
+
+/**
+ * Parse the scheme and authority of a URL, as far as `fields` requires.
+ *
+ * On return `*path` is the start of the path, or NULL if there is none. In the
+ * latter case `*end` points at the end of the authority and `*delim` holds the
+ * '?', '#' or '\0' found there, which may since have been overwritten by a null
+ * terminator. Nothing is located if no component after the port is requested.
+ *
+ * @warning: Modifies the input string as part of the parsing process.
+ *
+ * @param url: The struct where the requested components are stored.
+ * @param url_str: The URL string to parse.
+ * @param fields: A bitmask of YUAREL_FIELD_* values.
+ * @param path: Set to the start of the path, or NULL.
+ * @param end: Set to the end of the authority.
+ * @param delim: Set to the character that ended the authority.
+ *
+ * @return: 0 on success, otherwise -1 on error.
+ */
+static int parse_head(struct yuarel *url, char *url_str, int fields, char **path, char **end, char *delim)
+{
+    int scheme_id = YUAREL_SCHEME_OTHER;
+
+    *path = NULL;
+    *end = url_str;
+    *delim = '\0';
+
+    if (is_relative(url_str))
+    {
+        /* Relative (Path) */
+        *path = url_str + 1;
+        return 0;
+    }
+
+    /* Scheme, must be followed by "://" */
+    *end = scheme_end(url_str, &scheme_id);
+    if (':' != **end || *end == url_str || '/' != (*end)[1] || '/' != (*end)[2])
+    {
+        return -1;
+    }
+    url->scheme_id = scheme_id;
+
+    if (fields & YUAREL_FIELD_SCHEME)
+    {
+        url->scheme = url_str;
+        **end = '\0';
+    }
+
+    url_str = *end + 3;
+    *end = url_str;
+    if ('/' == *url_str)
+    {
+        /* URI Omits Hostname (e.g. File URI). Path keeps its slash */
+        *path = url_str;
+        return 0;
+    }
+
+    if (!fields_after(fields, YUAREL_FIELD_SCHEME))
+    {
+        return 0;
+    }
+
+    /* Authority */
+    *end = url_str + strcspn(url_str, "/?#");
+    *delim = **end;
+    if (parse_authority(url, url_str, *end, fields))
+    {
+        return -1;
+    }
+
+    if ('/' == *delim)
+    {
+        *path = *end + 1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Parse only the requested components of a URL.
+ *
+ * Accepts the same formats as yuarel_parse(), but only the components named
+ * in `fields` are stored in `url` and null terminated. Scanning stops as soon
+ * as the last requested component is found, so the rest of the string is
+ * neither read nor modified. Components that are not requested are left NULL
+ * (port 0) and are only validated as far as needed to locate the requested
+ * ones.
+ *
+ * Unlike yuarel_parse(), the port is read up to the first non-digit.
+ *
+ * @warning: Modifies the input string as part of the parsing process.
+ *
+ * @param[out] url A pointer to the `yuarel` struct where the parsed values will be stored.
+ * @param[in,out] url_str A pointer to the URL string to be parsed. The string will be modified.
+ * @param[in] fields A bitmask of YUAREL_FIELD_* values.
+ *
+ * @return 0 on success, otherwise -1 on error.
+ */
+int yuarel_parse_fields(struct yuarel *url, char *url_str, int fields)
+{
+    char *path;
+    char *end;
+    char delim;
+
+    if (NULL == url || NULL == url_str)
+    {
+        return -1;
+    }
+
+    memset(url, 0, sizeof(struct yuarel));
+
+    if (parse_head(url, url_str, fields, &path, &end, &delim))
+    {
+        return -1;
+    }
+
+    if (!fields_after(fields, YUAREL_FIELD_PORT))
+    {
+        return 0;
+    }
+
+    /* (Path) */
+    if (NULL != path)
+    {
+        end = path + strcspn(path, "?#");
+        delim = *end;
+        if (fields & YUAREL_FIELD_PATH)
+        {
+            url->path = path;
+            *end = '\0';
+        }
+    }
+
+    if (!fields_after(fields, YUAREL_FIELD_PATH))
+    {
+        return 0;
+    }
+
+    /* (Query) */
+    if ('?' == delim)
+    {
+        char *query = end + 1;
+
+        end = query + strcspn(query, "#");
+        delim = *end;
+        if (fields & YUAREL_FIELD_QUERY)
+        {
+            url->query = query;
+            *end = '\0';
+        }
+    }
+
+    /* (Fragment) */
+    if ('#' == delim && (fields & YUAREL_FIELD_FRAGMENT))
+    {
+        url->fragment = end + 1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Parse a URL and percent-decode the selected components in the same pass.
+ *
+ * Accepts the same formats as yuarel_parse_fields() with YUAREL_FIELD_ALL. The
+ * components named in `flags` are decoded like yuarel_url_decode() while their
+ * end is searched for, so each byte is only read once. Delimiters are only
+ * recognized in the raw bytes, e.g. "%3F" in the path is decoded to '?' and
+ * does not start the query. '+' is only decoded to a space in the query.
+ *
+ * A decoded query can no longer be split on '&' and '='. To get decoded keys
+ * and values, leave YUAREL_DECODE_QUERY out and pass the query to
+ * yuarel_parse_query_ex() with YUAREL_QUERY_DECODE, which splits and decodes it
+ * in one pass.
+ *
+ * @warning: Modifies the input string as part of the parsing process.
+ *
+ * @param[out] url A pointer to the `yuarel` struct where the parsed values will be stored.
+ * @param[in,out] url_str A pointer to the URL string to be parsed. The string will be modified.
+ * @param[in] flags A bitmask of YUAREL_DECODE_* values.
+ *
+ * @return 0 on success, otherwise -1 on error.
+ */
+int yuarel_parse_ex(struct yuarel *url, char *url_str, int flags)
+{
+    char *path;
+    char *end;
+    char delim;
+    char stop;
+
+    if (NULL == url || NULL == url_str)
+    {
+        return -1;
+    }
+
+    memset(url, 0, sizeof(struct yuarel));
+
+    if (parse_head(url, url_str, YUAREL_FIELD_ALL, &path, &end, &delim))
+    {
+        return -1;
+    }
+
+    /* (Credentials), already null terminated */
+    if (flags & YUAREL_DECODE_USERINFO)
+    {
+        if (NULL != url->username)
+        {
+            decode_component(url->username, &stops_escape, &stop);
+        }
+        if (NULL != url->password)
+        {
+            decode_component(url->password, &stops_escape, &stop);
+        }
+    }
+
+    /* (Path) */
+    if (NULL != path)
+    {
+        url->path = path;
+        end = decode_component(path, (flags & YUAREL_DECODE_PATH) ? &stops_path_decode : &stops_path, &delim);
+    }
+
+    /* (Query) */
+    if ('?' == delim)
+    {
+        url->query = end + 1;
+        end = decode_component(end + 1, (flags & YUAREL_DECODE_QUERY) ? &stops_query_decode : &stops_query, &delim);
+    }
+
+    /* (Fragment) */
+    if ('#' == delim)
+    {
+        url->fragment = end + 1;
+        if (flags & YUAREL_DECODE_FRAGMENT)
+        {
+            decode_component(end + 1, &stops_escape, &stop);
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Parse only the host and port of a URL.
+ *
+ * Same as yuarel_parse_fields() with YUAREL_FIELD_HOST | YUAREL_FIELD_PORT.
+ * Stops scanning at the end of the host and port.
+ *
+ * @warning: Modifies the input string as part of the parsing process.
+ *
+ * @param[out] url A pointer to the `yuarel` struct where the parsed values will be stored.
+ * @param[in,out] url_str A pointer to the URL string to be parsed. The string will be modified.
+ *
+ * @return 0 on success, otherwise -1 on error.
+ */
+int yuarel_parse_host(struct yuarel *url, char *url_str)
+{
+    return yuarel_parse_fields(url, url_str, YUAREL_FIELD_HOST | YUAREL_FIELD_PORT);
+}
+
+/**
+ * @brief Parse only the path of a URL.
+ *
+ * Same as yuarel_parse_fields() with YUAREL_FIELD_PATH. Stops scanning at the
+ * end of the path, leaving the query and fragment untouched.
+ *
+ * @warning: Modifies the input string as part of the parsing process.
+ *
+ * @param[out] url A pointer to the `yuarel` struct where the parsed values will be stored.
+ * @param[in,out] url_str A pointer to the URL string to be parsed. The string will be modified.
+ *
+ * @return 0 on success, otherwise -1 on error.
+ */
+int yuarel_parse_path(struct yuarel *url, char *url_str)
+{
+    return yuarel_parse_fields(url, url_str, YUAREL_FIELD_PATH);
+}
+
+/**
+ * @brief Split a URL path into parts.
+ *
+ * No data is copied, the slashed are used as null terminators and then
+ * pointers to each path part will be stored in **parts. Double slashes will be
+ * treated as one.
+ *
+ * @warning: Modifies the input string as part of the parsing process.
+ *
+ * @param[in,out] path The path string to split. The string will be modified.
+ * @param[out] parts An array where the resulting path parts will be stored.
+ * @param[in] max_parts The maximum number of parts to parse.
+ *
+ * @return The number of parsed path parts, or -1 on error.
+ */
+int yuarel_split_path(char *path, char **parts, int max_parts)
+{
+    return yuarel_split_path_ex(path, parts, NULL, max_parts);
+}
+
+/**
+ * @brief Split a URL path into parts, and report their lengths.
+ *
+ * Works like yuarel_split_path(), and also stores the length of each part so
+ * that callers do not need strlen(). The slashes and the end of the path are
+ * found with one bit mask per block of the SIMD kernel, see yuarel_simd_kernel().
+ *
+ * @warning: Modifies the input string as part of the parsing process.
+ *
+ * @param[in,out] path The path string to split. The string will be modified.
+ * @param[out] parts An array where the resulting path parts will be stored.
+ * @param[out] lengths An array where the length of each part will be stored, or NULL.
+ * @param[in] max_parts The maximum number of parts to parse.
+ *
+ * @return The number of parsed path parts, or -1 on error.
+ */
+int yuarel_split_path_ex(char *path, char **parts, size_t *lengths, int max_parts)
+{
+    if (NULL == path || '\0' == *path)
+    {
+        return -1;
+    }
+
+    if (max_parts <= 0)
+    {
+        return 0;
+    }
+
+    return scan_kernel()->split_path(path, parts, lengths, max_parts);
+}
+
+/**
+ * @brief Split a hostname into its labels, from right to left.
+ *
+ * No data is copied or modified. The offset and length of each label within
+ * `host` are stored in `labels`, starting with the top level label. Empty
+ * labels (e.g. from a trailing dot) are skipped.
+ *
+ * @param[in] host The null terminated hostname to split.
+ * @param[out] labels An array where the resulting label spans will be stored.
+ * @param[in] max_labels The maximum number of labels to store.
+ *
+ * @return The number of labels, or -1 on error.
+ */
+int yuarel_split_host(const char *host, struct yuarel_span *labels, int max_labels)
+{
+    size_t end;
+    int i = 0;
+
+    if (NULL == host || '\0' == *host)
+    {
+        return -1;
+    }
+
+    end = strlen(host);
+    while (end > 0 && i < max_labels)
+    {
+        size_t start = end;
+
+        /* Back to after the previous dot */
+        while (start > 0 && '.' != host[start - 1])
+        {
+            start--;
+        }
+
+        if (start < end)
+        {
+            labels[i].off = start;
+            labels[i].len = end - start;
+            i++;
+        }
+
+        end = (start > 0) ? start - 1 : 0;
+    }
+
+    return i;
+}
+
+/**
+ * @brief Parse a query string into key-value pairs.
+ *
+ * The query string should be a null terminated string of parameters separated by
+ * a delimiter. Each parameter are checked for the equal sign character. If it
+ * appears in the parameter, it will be used as a null terminator and the part
+ * that comes after it will be the value of the parameter.
+ *
+ * No data are copied, the equal sign and delimiters are used as null
+ * terminators and then pointers to each parameter key and value will be stored
+ * in the yuarel_param struct.
+ *
+ * @warning: Modifies the input string as part of the parsing process.
+ *
+ * @param[in,out] query The query string to parse. The string will be modified.
+ * @param[in] delimiter The character that separates key-value pairs in the query.
+ * @param[out] params An array where the parsed key-value pairs will be stored.
+ * @param[in] max_params The maximum number of parameters to parse.
+ *
+ * @return The number of parsed parameters, or -1 on error.
+ */
+int yuarel_parse_query(char *query, char delimiter, struct yuarel_param *params, int max_params)
+{
+    char delimiters[2];
+
+    delimiters[0] = delimiter;
+    delimiters[1] = '\0';
+    return yuarel_parse_query_ex(query, delimiters, params, max_params, 0);
+}
+
+/**
+ * @brief Parse a query string with any set of delimiters into key-value pairs.
+ *
+ * Works like yuarel_parse_query(), but parameters may be separated by any of
+ * the characters in `delimiters`, e.g. "&;" for mixed queries. The delimiters
+ * and the first '=' of each parameter are found in a single pass, comparing a
+ * whole block at a time with the SIMD kernel, see yuarel_simd_kernel().
+ *
+ * With YUAREL_QUERY_DECODE, keys and values are also percent-decoded like
+ * yuarel_url_decode() in the same pass. Decoded characters never split a
+ * parameter.
+ *
+ * @warning: Modifies the input string as part of the parsing process.
+ *
+ * @param[in,out] query The query string to parse. The string will be modified.
+ * @param[in] delimiters The characters that separate key-value pairs in the query.
+ * @param[out] params An array where the parsed key-value pairs will be stored.
+ * @param[in] max_params The maximum number of parameters to parse.
+ * @param[in] flags 0 or YUAREL_QUERY_DECODE.
+ *
+ * @return The number of parsed parameters, or -1 on error.
+ */
+int yuarel_parse_query_ex(char *query, const char *delimiters, struct yuarel_param *params, int max_params, int flags)
+{
+    if (NULL == query || '\0' == *query || NULL == delimiters)
+    {
+        return -1;
+    }
+
+    if (max_params <= 0)
+    {
+        return 0;
+    }
+
+    return scan_kernel()->parse_query(query, delimiters, params, max_params, flags & YUAREL_QUERY_DECODE);
+}
+
+/**
+ * @brief Decode a percent-encoded URL string in place.
+ *
+ * This function decodes percent-encoded characters (`%XX`) in the input URL
+ * string and replaces `+` with spaces. The string is modified directly, and
+ * no additional memory is allocated. The escapes are found a block at a time
+ * with the SIMD kernel, see yuarel_simd_kernel().
+ *
+ * @warning: Modifies the input string as part of the parsing process.
+ *
+ * @param[in,out] str The input string to decode. The string will be modified.
+ *
+ * @return The modified input string (same pointer as `str`).
+ */
+char *yuarel_url_decode(char *str)
+{
+    char delim;
+
+    if (NULL == str || '\0' == *str)
+    {
+        return str;
+    }
+
+    decode_component(str, &stops_form, &delim);
+    return str;
+}
+
+/* Query parameters yuarel_surt() sorts at once, more are written in several rounds */
+#define SURT_SORT_SPANS 128
+
+/* Largest number of labels in a hostname of 253 bytes */
+#define SURT_MAX_LABELS 127
+
+/**
+ * Output buffer of yuarel_surt(), which counts the bytes that do not fit.
+ */
+struct surt_writer
+{
+    char *buf;
+    size_t size;
+    size_t len;
+};
+
+/**
+ * Append bytes to a SURT key.
+ *
+ * @param w: The writer.
+ * @param str: The bytes to append.
+ * @param len: The number of bytes.
+ * @param lower: Nonzero to lowercase ASCII letters.
+ */
+static void surt_put(struct surt_writer *w, const char *str, size_t len, int lower)
+{
+    size_t avail = (w->len + 1 < w->size) ? w->size - 1 - w->len : 0;
+    size_t n = (len < avail) ? len : avail;
+    size_t i;
+
+    if (lower)
+    {
+        for (i = 0; i < n; i++)
+        {
+            char c = str[i];
+            w->buf[w->len + i] = ('A' <= c && c <= 'Z') ? c + ('a' - 'A') : c;
+        }
+    }
+    else if (n > 0)
+    {
+        memcpy(w->buf + w->len, str, n);
+    }
+
+    w->len += len;
+}
+
+/**
+ * Compare two query parameters by their bytes, and by their offsets when
+ * the bytes are equal, so that no two parameters are equal.
+ *
+ * @param query: The query string.
+ * @param a: The first parameter.
+ * @param b: The second parameter.
+ *
+ * @return: Less than, equal to or greater than 0, like strcmp().
+ */
+static int surt_span_cmp(const char *query, const struct yuarel_span *a, const struct yuarel_span *b)
+{
+    int d = memcmp(query + a->off, query + b->off, (a->len < b->len) ? a->len : b->len);
+
+    if (0 != d)
+    {
+        return d;
+    }
+    if (a->len != b->len)
+    {
+        return (a->len < b->len) ? -1 : 1;
+    }
+    return (a->off < b->off) ? -1 : (a->off > b->off);
+}
+
+/**
+ * Move a parameter down a max-heap until it is not less than its children.
+ *
+ * @param query: The query string.
+ * @param heap: The heap.
+ * @param i: The index of the parameter.
+ * @param count: The number of parameters in the heap.
+ */
+static void surt_sift_down(const char *query, struct yuarel_span *heap, size_t i, size_t count)
+{
+    struct yuarel_span span = heap[i];
+
+    while (2 * i + 1 < count)
+    {
+        size_t child = 2 * i + 1;
+
+        if (child + 1 < count && surt_span_cmp(query, &heap[child], &heap[child + 1]) < 0)
+        {
+            child++;
+        }
+        if (surt_span_cmp(query, &span, &heap[child]) >= 0)
+        {
+            break;
+        }
+        heap[i] = heap[child];
+        i = child;
+    }
+    heap[i] = span;
+}
+
+/**
+ * Append the query parameters of a SURT key in sorted order.
+ *
+ * The parameters are kept as spans of the query, and the smallest ones not
+ * written yet are collected in a max-heap on the stack and heap sorted in
+ * place. A query with more parameters than the heap holds takes one pass
+ * over the query per SURT_SORT_SPANS parameters. Empty parameters are left
+ * out.
+ *
+ * @param w: The writer.
+ * @param query: The query string.
+ */
+static void surt_put_query(struct surt_writer *w, const char *query)
+{
+    struct yuarel_span heap[SURT_SORT_SPANS];
+    struct yuarel_span last;
+    size_t written = 0;
+    size_t count;
+    size_t i;
+
+    do
+    {
+        const char *p = query;
+
+        count = 0;
+        for (;;)
+        {
+            const char *end = strchr(p, '&');
+            struct yuarel_span span;
+
+            span.off = (size_t)(p - query);
+            span.len = (NULL != end) ? (size_t)(end - p) : strlen(p);
+            /* Only parameters after the last one written */
+            if (span.len > 0 && (0 == written || surt_span_cmp(query, &span, &last) > 0))
+            {
+                if (count < SURT_SORT_SPANS)
+                {
+                    /* Move it up from the bottom of the heap */
+                    for (i = count++; i > 0 && surt_span_cmp(query, &heap[(i - 1) / 2], &span) < 0; i = (i - 1) / 2)
+                    {
+                        heap[i] = heap[(i - 1) / 2];
+                    }
+                    heap[i] = span;
+                }
+                else if (surt_span_cmp(query, &span, &heap[0]) < 0)
+                {
+                    /* Replace the largest one */
+                    heap[0] = span;
+                    surt_sift_down(query, heap, 0, count);
+                }
+            }
+            if (NULL == end)
+            {
+                break;
+            }
+            p = end + 1;
+        }
+
+        for (i = count; i > 1; i--)
+        {
+            struct yuarel_span largest = heap[0];
+
+            heap[0] = heap[i - 1];
+            heap[i - 1] = largest;
+            surt_sift_down(query, heap, 0, i - 1);
+        }
+        for (i = 0; i < count; i++)
+        {
+            surt_put(w, (0 == written++) ? "?" : "&", 1, 0);
+            surt_put(w, query + heap[i].off, heap[i].len, 0);
+        }
+        if (count > 0)
+        {
+            last = heap[count - 1];
+        }
+    } while (SURT_SORT_SPANS == count);
+}
+
+/**
+ * Get the YUAREL_SCHEME_* value of a URL, also when the struct was not
+ * filled in by the parser.
+ *
+ * @param url: The URL.
+ *
+ * @return: The YUAREL_SCHEME_* value.
+ */
+static inline int url_scheme_id(const struct yuarel *url)
+{
+    if (YUAREL_SCHEME_NONE == url->scheme_id && NULL != url->scheme)
+    {
+        return scheme_identify(url->scheme, strlen(url->scheme));
+    }
+    return url->scheme_id;
+}
+
+/**
+ * @brief Get the default port of a scheme.
+ *
+ * @param[in] scheme_id One of the yuarel_scheme values.
+ *
+ * @return The default port, or 0 if the scheme has none or is not known.
+ */
+int yuarel_default_port(int scheme_id)
+{
+    size_t i = (size_t)(scheme_id - YUAREL_SCHEME_HTTP);
+
+    if (scheme_id < YUAREL_SCHEME_HTTP || i >= sizeof(schemes) / sizeof(schemes[0]))
+    {
+        return 0;
+    }
+    return schemes[i].port;
+}
+
+/**
+ * @brief Get the port a URL connects to.
+ *
+ * @param[in] url A parsed URL.
+ *
+ * @return `url->port` if given, otherwise the default port of the scheme, or
+ * 0 if neither is known.
+ */
+int yuarel_effective_port(const struct yuarel *url)
+{
+    if (NULL == url)
+    {
+        return 0;
+    }
+    if (0 != url->port)
+    {
+        return url->port;
+    }
+    return yuarel_default_port(url_scheme_id(url));
+}
+
+/**
+ * @brief Check if the port of a URL is the default port of its scheme, and
+ * can be left out when the URL is written in canonical form.
  *
- * Absolute URL:
- * scheme ":" [ "//" ] [ username ":" password "@" ] host [ ":" port ] [ "/" ] [ path ] [ "?" query ] [ "#" fragment ]
+ * @param[in] url A parsed URL.
  *
- * Relative URL:
- * path [ "?" query ] [ "#" fragment ]
+ * @return 1 if a port is given and it is the default, otherwise 0.
+ */
+int yuarel_is_default_port(const struct yuarel *url)
+{
+    if (NULL == url || 0 == url->port)
+    {
+        return 0;
+    }
+    return url->port == yuarel_default_port(url_scheme_id(url));
+}
+
+/**
+ * @brief Write the SURT key of a parsed URL.
  *
- * The following parts will be parsed to the corresponding struct member.
+ * The Sort-friendly URI Reordering Transform puts the labels of the lowercased
+ * hostname in reverse order, so that URLs of one domain sort next to each
+ * other, e.g. `com,example,www)/path?a=1&b=2`. IP addresses are kept as they
+ * are. A non-default port follows the host, the query parameters are sorted
+ * as spans of `url->query` on the stack, and the scheme, credentials and
+ * fragment are left out. No intermediate strings are built.
  *
- * @warning: Modifies the input string as part of the parsing process.
+ * Like snprintf(), the key is truncated to fit `size` and always null
+ * terminated when `size` is not 0.
  *
- * @param[out] url A pointer to the `yuarel` struct where the parsed values will be stored.
- * @param[in,out] url_str A pointer to the URL string to be parsed. The string will be modified.
+ * @param[in] url A URL parsed by yuarel_parse().
+ * @param[out] buf The buffer to write the key to.
+ * @param[in] size The size of `buf`.
  *
- * @return 0 on success, otherwise -1 on error.
+ * @return The length of the full key, or -1 if the URL has no host.
  */
-int yuarel_parse(struct yuarel *url, char *url_str)
+long yuarel_surt(const struct yuarel *url, char *buf, size_t size)
 {
-    if (NULL == url || NULL == url_str)
+    struct surt_writer w;
+    struct yuarel_span labels[SURT_MAX_LABELS];
+    const char *last_dot;
+    int count;
+    int i;
+
+    if (NULL == url || NULL == url->host || '\0' == *url->host || (NULL == buf && size > 0))
     {
         return -1;
     }
 
-    memset(url, 0, sizeof(struct yuarel));
+    w.buf = buf;
+    w.size = size;
+    w.len = 0;
 
-    /* (Fragment) */
-    url->fragment = find_fragment(url_str);
+    /* IPv6 and IPv4 addresses are not reversed */
+    last_dot = strrchr(url->host, '.');
+    last_dot = (NULL != last_dot) ? last_dot + 1 : url->host;
+    if (NULL != strchr(url->host, ':') || ('\0' != *last_dot && strspn(last_dot, "0123456789") == strlen(last_dot)))
+    {
+        surt_put(&w, url->host, strlen(url->host), 1);
+    }
+    else
+    {
+        count = yuarel_split_host(url->host, labels, SURT_MAX_LABELS);
+        for (i = 0; i < count; i++)
+        {
+            if (i > 0)
+            {
+                surt_put(&w, ",", 1, 0);
+            }
+            surt_put(&w, url->host + labels[i].off, labels[i].len, 1);
+        }
+    }
 
-    /* (Query) */
-    url->query = find_query(url_str);
+    if (0 != url->port && !yuarel_is_default_port(url))
+    {
+        char port[12];
+        int n = sprintf(port, ":%d", url->port);
+        surt_put(&w, port, (size_t)n, 0);
+    }
 
-    /* Relative URL? Parse scheme and hostname */
-    if (is_relative(url_str))
+    surt_put(&w, ")/", 2, 0);
+    if (NULL != url->path)
     {
-        /* Relative (Path) Found */
-        url->path = find_path(url_str);
-        return 0;
+        surt_put(&w, url->path, strlen(url->path), 0);
+    }
+    if (NULL != url->query)
+    {
+        surt_put_query(&w, url->query);
     }
 
-    /* Scheme */
-    url->scheme = url_str;
-    url_str = parse_scheme(url_str);
-    if (url_str == NULL)
+    if (size > 0)
     {
-        /* Scheme Missing */
-        return -1;
+        w.buf[(w.len < size) ? w.len : size - 1] = '\0';
     }
 
-    /* Check if host is omitted but path is provided (e.g. File URI) */
-    if ('/' == *url_str)
+    return (long)w.len;
+}
+
+/**
+ * Store the offset of `ptr` from `base` in a compact offset field.
+ *
+ * @param out: Where to store the offset.
+ * @param ptr: The component pointer, or NULL if not present.
+ * @param base: The start of the parsed URL string.
+ *
+ * @return: 0 on success, or -1 if the offset does not fit in 16 bits.
+ */
+static inline int compact_offset(uint16_t *out, const char *ptr, const char *base)
+{
+    if (NULL == ptr)
     {
-        /* URI Omits Hostname. Record only path */
-        url->path = url_str;
+        *out = 0;
         return 0;
     }
 
-    /* Host */
-    if ('\0' == *url_str)
+    if (ptr <= base || ptr - base > UINT16_MAX)
     {
         return -1;
     }
-    url->host = url_str;
 
-    /* (Path) */
-    url->path = find_path(url_str);
+    *out = (uint16_t)(ptr - base);
+    return 0;
+}
 
-    /* (Credentials) */
-    url_str = strchr(url->host, '@');
-    if (NULL != url_str)
+/**
+ * @brief Pack a parsed URL into its compact representation.
+ *
+ * @param[out] compact Where to store the compact representation.
+ * @param[in] url A URL parsed by yuarel_parse().
+ * @param[in] base The string that was passed to yuarel_parse().
+ *
+ * @return 0 on success, otherwise -1 if the URL exceeds the compact limits.
+ */
+int yuarel_compact_pack(struct yuarel_compact *compact, const struct yuarel *url, const char *base)
+{
+    const char *last;
+    size_t len;
+    size_t end;
+
+    if (NULL == compact || NULL == url || NULL == base)
     {
-        /* Missing credentials? */
-        if (url_str == url->host)
-        {
-            return -1;
-        }
+        return -1;
+    }
 
-        url->username = url->host;
-        url->host = url_str + 1;
-        *url_str = '\0';
+    memset(compact, 0, sizeof(struct yuarel_compact));
 
-        url_str = strchr(url->username, ':');
-        if (NULL != url_str)
+    if (NULL != url->scheme)
+    {
+        len = strlen(url->scheme);
+        if (len > UINT8_MAX)
         {
-            url->password = url_str + 1;
-            *url_str = '\0';
+            return -1;
         }
+        compact->scheme_len = (uint8_t)len;
     }
 
-    /* Missing hostname? */
-    if ('\0' == *url->host)
+    if (NULL != url->username)
     {
-        return -1;
+        len = strlen(url->username);
+        if (len > UINT8_MAX)
+        {
+            return -1;
+        }
+        compact->user_len = (uint8_t)len;
+        compact->flags |= YUAREL_COMPACT_CREDENTIALS;
+
+        if (NULL != url->password)
+        {
+            compact->flags |= YUAREL_COMPACT_PASSWORD;
+        }
     }
 
-    /* IPv6 hostname */
-    if ('[' == url->host[0])
+    if (NULL != url->host)
     {
-        /* IPv6 Literal */
-        // If hostname starts with square bracket, it is IPv6 literal
-        // example:
-        // http://[1080:0:0:0:8:800:200C:417A]:80/index.html
-        // http://[3ffe:2a00:100:7031::1]
-        // http://[::192.9.5.5]/ipng
-        url->host++;
-
-        /* Locate end of IPv6 Literal marker */
-        url_str = strchr(url->host, ']');
-        if (NULL == url_str)
+        len = strlen(url->host);
+        if (len > UINT8_MAX)
         {
-            /* Missing end ']' marker */
             return -1;
         }
+        compact->host_len = (uint8_t)len;
 
-        /* Null terminate IPv6 host literal (In place of ']') */
-        *url_str = '\0';
-
-        /* Check if next character is ':' is present.
-         * Which would indicate port number is present */
-        url_str++;
-        if ('\0' == *url_str)
+        /* The opening bracket of an IPv6 literal is left in place */
+        if (url->host > base && '[' == url->host[-1])
         {
-            /* Already end of host string. No port number present */
-            url_str = NULL;
+            compact->flags |= YUAREL_COMPACT_IPV6;
         }
-        else if (':' != *url_str)
+    }
+
+    if (0 != url->port)
+    {
+        if (url->port < 0 || url->port > UINT16_MAX)
         {
-            /* Port number delimiter is missing. Invalid. */
             return -1;
         }
+        compact->port = (uint16_t)url->port;
+        compact->flags |= YUAREL_COMPACT_PORT;
     }
-    else
+
+    if (compact_offset(&compact->host, url->host, base) ||
+        compact_offset(&compact->path, url->path, base) ||
+        compact_offset(&compact->query, url->query, base) ||
+        compact_offset(&compact->fragment, url->fragment, base))
     {
-        /* Check for port number delimiter */
-        // example: http://192.156.1.1:80 ('<HOST>:<PORT>')
-        url_str = strchr(url->host, ':');
+        return -1;
     }
 
-    if (NULL != url_str && (NULL == url->path || url_str < url->path))
+    /* The end of the last component bounds the ones before it */
+    if (NULL != url->fragment)
     {
-        *(url_str++) = '\0';
-        if ('\0' == *url_str)
-        {
-            return -1;
-        }
+        last = url->fragment;
+    }
+    else if (NULL != url->query)
+    {
+        last = url->query;
+    }
+    else
+    {
+        last = url->path;
+    }
 
-        if (url->path)
-        {
-            url->port = natoi(url_str, url->path - url_str - 1);
-        }
-        else
-        {
-            url->port = atoi(url_str);
-        }
+    if (NULL != last)
+    {
+        end = (size_t)(last - base) + strlen(last);
+    }
+    else
+    {
+        end = (size_t)compact->host + compact->host_len;
     }
 
-    /* Missing hostname? */
-    if ('\0' == *url->host)
+    if (end > UINT16_MAX)
     {
         return -1;
     }
+    compact->end = (uint16_t)end;
 
     return 0;
 }
 
 /**
- * @brief Split a URL path into parts.
+ * @brief Expand a compact representation back into a `yuarel` struct.
  *
- * No data is copied, the slashed are used as null terminators and then
- * pointers to each path part will be stored in **parts. Double slashes will be
- * treated as one.
- *
- * @warning: Modifies the input string as part of the parsing process.
- *
- * @param[in,out] path The path string to split. The string will be modified.
- * @param[out] parts An array where the resulting path parts will be stored.
- * @param[in] max_parts The maximum number of parts to parse.
+ * @param[out] url A pointer to the `yuarel` struct where the values will be stored.
+ * @param[in] compact The compact representation.
+ * @param[in] base The parsed string the compact representation refers to.
  *
- * @return The number of parsed path parts, or -1 on error.
+ * @return 0 on success, otherwise -1 on error.
  */
-int yuarel_split_path(char *path, char **parts, int max_parts)
+int yuarel_compact_unpack(struct yuarel *url, const struct yuarel_compact *compact, char *base)
 {
-    int i = 0;
-
-    if (NULL == path || '\0' == *path)
+    if (NULL == url || NULL == compact || NULL == base)
     {
         return -1;
     }
 
-    do
-    {
-        /* Forward to after slashes */
-        while (*path == '/')
-        {
-            path++;
-        }
-
-        if ('\0' == *path)
-        {
-            break;
-        }
+    memset(url, 0, sizeof(struct yuarel));
 
-        parts[i++] = path;
+    if (compact->scheme_len)
+    {
+        url->scheme = base;
+        url->scheme_id = scheme_identify(base, compact->scheme_len);
+    }
 
-        path = strchr(path, '/');
-        if (NULL == path)
+    if (compact->flags & YUAREL_COMPACT_CREDENTIALS)
+    {
+        url->username = base + compact->scheme_len + 3;
+        if (compact->flags & YUAREL_COMPACT_PASSWORD)
         {
-            break;
+            url->password = url->username + compact->user_len + 1;
         }
+    }
 
-        *(path++) = '\0';
-    } while (i < max_parts);
+    url->host = compact->host ? base + compact->host : NULL;
+    url->port = compact->port;
+    url->path = compact->path ? base + compact->path : NULL;
+    url->query = compact->query ? base + compact->query : NULL;
+    url->fragment = compact->fragment ? base + compact->fragment : NULL;
 
-    return i;
+    return 0;
 }
 
 /**
- * @brief Parse a query string into key-value pairs.
+ * @brief Get one component of a compact URL as a pointer and length.
  *
- * The query string should be a null terminated string of parameters separated by
- * a delimiter. Each parameter are checked for the equal sign character. If it
- * appears in the parameter, it will be used as a null terminator and the part
- * that comes after it will be the value of the parameter.
- *
- * No data are copied, the equal sign and delimiters are used as null
- * terminators and then pointers to each parameter key and value will be stored
- * in the yuarel_param struct.
+ * No strlen() is needed, the length is derived from the stored offsets.
  *
- * @warning: Modifies the input string as part of the parsing process.
- *
- * @param[in,out] query The query string to parse. The string will be modified.
- * @param[in] delimiter The character that separates key-value pairs in the query.
- * @param[out] params An array where the parsed key-value pairs will be stored.
- * @param[in] max_params The maximum number of parameters to parse.
+ * @param[in] compact The compact representation.
+ * @param[in] base The parsed string the compact representation refers to.
+ * @param[in] field One of the YUAREL_FIELD_* values, except YUAREL_FIELD_PORT.
+ * @param[out] len Where to store the length of the component. May be NULL.
  *
- * @return The number of parsed parameters, or -1 on error.
+ * @return A pointer to the component, or NULL if it is not present.
  */
-int yuarel_parse_query(char *query, char delimiter, struct yuarel_param *params, int max_params)
+const char *yuarel_compact_get(const struct yuarel_compact *compact, const char *base, int field, size_t *len)
 {
-    int param_count = 0;
+    size_t start;
+    size_t end;
 
-    if (NULL == query || '\0' == *query)
+    if (NULL == compact || NULL == base)
     {
-        return -1;
+        return NULL;
     }
 
-    while (param_count < max_params)
+    switch (field)
     {
-        char *curr_key_ptr = query;
-        char *curr_end_ptr = strchr(curr_key_ptr, delimiter);
-        char *val_delim;
-
-        if (curr_end_ptr != NULL)
-        {
-            // There will be more kv pairs ahead so zero terminate this kv
-            *curr_end_ptr = '\0';
-        }
+        case YUAREL_FIELD_SCHEME:
+            if (0 == compact->scheme_len)
+            {
+                return NULL;
+            }
+            start = 0;
+            end = compact->scheme_len;
+            break;
 
-        /* Write KV parameter */
-        params[param_count].key = curr_key_ptr;
-        val_delim = strchr(curr_key_ptr, '=');
-        if (val_delim != NULL)
-        {
-            /* Value Is Present. Split and record */
-            *val_delim = '\0';
-            params[param_count].val = val_delim + 1;
-        }
-        else
-        {
-            /* Value Not Present. Mark as empty */
-            params[param_count].val = NULL;
-        }
-        param_count++;
+        case YUAREL_FIELD_USERNAME:
+            if (!(compact->flags & YUAREL_COMPACT_CREDENTIALS))
+            {
+                return NULL;
+            }
+            start = (size_t)compact->scheme_len + 3;
+            end = start + compact->user_len;
+            break;
 
-        /* Handle next KV pair if present */
-        if (curr_end_ptr == NULL)
-        {
-            /* No more kv pairs ahead. Finish up */
+        case YUAREL_FIELD_PASSWORD:
+            if (!(compact->flags & YUAREL_COMPACT_PASSWORD))
+            {
+                return NULL;
+            }
+            /* Ends before the '@', and before the '[' of an IPv6 host */
+            start = (size_t)compact->scheme_len + 3 + compact->user_len + 1;
+            end = (size_t)compact->host - 1 - ((compact->flags & YUAREL_COMPACT_IPV6) ? 1 : 0);
             break;
-        }
 
-        /* There will be more kv pairs ahead */
-        query = curr_end_ptr + 1;
-    }
+        case YUAREL_FIELD_HOST:
+            if (0 == compact->host)
+            {
+                return NULL;
+            }
+            start = compact->host;
+            end = start + compact->host_len;
+            break;
 
-    return param_count;
-}
+        case YUAREL_FIELD_PATH:
+            if (0 == compact->path)
+            {
+                return NULL;
+            }
+            start = compact->path;
+            if (compact->query)
+            {
+                end = compact->query - 1u;
+            }
+            else if (compact->fragment)
+            {
+                end = compact->fragment - 1u;
+            }
+            else
+            {
+                end = compact->end;
+            }
+            break;
 
-/**
- * @brief Decode a percent-encoded URL string in place.
- *
- * This function decodes percent-encoded characters (`%XX`) in the input URL
- * string and replaces `+` with spaces. The string is modified directly, and
- * no additional memory is allocated.
- *
- * @warning: Modifies the input string as part of the parsing process.
- *
- * @param[in,out] str The input string to decode. The string will be modified.
- *
- * @return The modified input string (same pointer as `str`).
- */
-char *yuarel_url_decode(char *str)
-{
-    // Hex decoding utilities
-#define YUAREL_URL_DECODE_IS_HEX(ch) (('0' <= (ch) && (ch) <= '9') || ('a' <= (ch) && (ch) <= 'f') || ('A' <= (ch) && (ch) <= 'F'))
-#define YUAREL_URL_DECODE_PARSE_HEX(ch) (('0' <= (ch) && (ch) <= '9') ? ((ch) - '0') : (('a' <= (ch) && (ch) <= 'f') ? (10 + (ch) - 'a') : (('A' <= (ch) && (ch) <= 'F') ? (10 + (ch) - 'A') : 0)))
+        case YUAREL_FIELD_QUERY:
+            if (0 == compact->query)
+            {
+                return NULL;
+            }
+            start = compact->query;
+            end = compact->fragment ? compact->fragment - 1u : compact->end;
+            break;
 
-    const char *read_ptr = str;
-    char *write_ptr = str;
+        case YUAREL_FIELD_FRAGMENT:
+            if (0 == compact->fragment)
+            {
+                return NULL;
+            }
+            start = compact->fragment;
+            end = compact->end;
+            break;
 
-    if (NULL == str || '\0' == *str)
-    {
-        return str;
+        default:
+            return NULL;
     }
 
-    while (*read_ptr)
+    if (NULL != len)
     {
-        if (read_ptr[0] == '+')
-        {
-            // '+' is a space in URL-encoded strings
-            *write_ptr = ' ';
-            write_ptr += 1;
-            read_ptr += 1;
-        }
-        else if (read_ptr[0] == '%' && YUAREL_URL_DECODE_IS_HEX(read_ptr[1]) && YUAREL_URL_DECODE_IS_HEX(read_ptr[2]))
-        {
-            // Decode percent encoded hex and skip past the two hex character
-            *write_ptr = YUAREL_URL_DECODE_PARSE_HEX(read_ptr[1]) << 4 | YUAREL_URL_DECODE_PARSE_HEX(read_ptr[2]);
-            write_ptr += 1;
-            read_ptr += 3;
-        }
-        else
-        {
-            // Regular character, copy as is
-            *write_ptr = *read_ptr;
-            write_ptr += 1;
-            read_ptr += 1;
-        }
+        *len = end - start;
     }
-#undef YUAREL_URL_DECODE_IS_HEX
-#undef YUAREL_URL_DECODE_PARSE_HEX
 
-    // Null-terminate the string
-    *write_ptr = '\0';
-    return str;
+    return base + start;
 }
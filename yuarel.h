@@ -30,6 +30,26 @@
 #ifndef INC_YUAREL_H
 #define INC_YUAREL_H
 
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @def YUAREL_API
+ * @brief Storage class of the functions declared below.
+ *
+ * With the single header `yuarel_single.h` (see `make single`), define
+ * YUAREL_STATIC before including it to give the functions internal linkage,
+ * so that the compiler can inline them into the callers of that file. Without
+ * it, define YUAREL_IMPLEMENTATION in exactly one file instead.
+ */
+#ifndef YUAREL_API
+#ifdef YUAREL_STATIC
+#define YUAREL_API static inline
+#else
+#define YUAREL_API extern
+#endif
+#endif
+
 #ifdef __cplusplus
 extern "C"
 {
@@ -54,6 +74,7 @@ struct yuarel
     char *path;     /**< @brief Path, without leading "/", default: NULL */
     char *query;    /**< @brief Query string, default: NULL */
     char *fragment; /**< @brief Fragment identifier, default: NULL */
+    int scheme_id;  /**< @brief One of the yuarel_scheme values, default: YUAREL_SCHEME_NONE */
 };
 
 /**
@@ -69,6 +90,118 @@ struct yuarel_param
     char *val; /**< @brief Value of the query parameter */
 };
 
+/**
+ * @struct yuarel_span
+ * @brief A part of a string, as an offset and a length.
+ */
+struct yuarel_span
+{
+    size_t off; /**< @brief Offset of the first byte */
+    size_t len; /**< @brief Length in bytes */
+};
+
+/**
+ * @enum yuarel_scheme
+ * @brief Schemes recognized by the parser, stored in `url->scheme_id`.
+ *
+ * Schemes are compared without regard to case. The default port of each is
+ * given in parentheses.
+ */
+enum yuarel_scheme
+{
+    YUAREL_SCHEME_NONE,   /**< @brief No scheme, e.g. a relative URL */
+    YUAREL_SCHEME_OTHER,  /**< @brief A scheme not listed below */
+    YUAREL_SCHEME_HTTP,   /**< @brief `http` (80) */
+    YUAREL_SCHEME_HTTPS,  /**< @brief `https` (443) */
+    YUAREL_SCHEME_WS,     /**< @brief `ws` (80) */
+    YUAREL_SCHEME_WSS,    /**< @brief `wss` (443) */
+    YUAREL_SCHEME_FTP,    /**< @brief `ftp` (21) */
+    YUAREL_SCHEME_FTPS,   /**< @brief `ftps` (990) */
+    YUAREL_SCHEME_SFTP,   /**< @brief `sftp` (22) */
+    YUAREL_SCHEME_SSH,    /**< @brief `ssh` (22) */
+    YUAREL_SCHEME_GIT,    /**< @brief `git` (9418) */
+    YUAREL_SCHEME_FILE,   /**< @brief `file` (none) */
+    YUAREL_SCHEME_GOPHER, /**< @brief `gopher` (70) */
+    YUAREL_SCHEME_LDAP,   /**< @brief `ldap` (389) */
+    YUAREL_SCHEME_LDAPS,  /**< @brief `ldaps` (636) */
+    YUAREL_SCHEME_TELNET, /**< @brief `telnet` (23) */
+    YUAREL_SCHEME_IMAP,   /**< @brief `imap` (143) */
+    YUAREL_SCHEME_IMAPS,  /**< @brief `imaps` (993) */
+    YUAREL_SCHEME_POP3,   /**< @brief `pop3` (110) */
+    YUAREL_SCHEME_SMTP,   /**< @brief `smtp` (25) */
+    YUAREL_SCHEME_RTSP,   /**< @brief `rtsp` (554) */
+    YUAREL_SCHEME_MQTT,   /**< @brief `mqtt` (1883) */
+    YUAREL_SCHEME_REDIS   /**< @brief `redis` (6379) */
+};
+
+/**
+ * @enum yuarel_field
+ * @brief Bit flags naming the components of a URL.
+ */
+enum yuarel_field
+{
+    YUAREL_FIELD_SCHEME = 1 << 0,   /**< @brief `url->scheme` */
+    YUAREL_FIELD_USERNAME = 1 << 1, /**< @brief `url->username` */
+    YUAREL_FIELD_PASSWORD = 1 << 2, /**< @brief `url->password` */
+    YUAREL_FIELD_HOST = 1 << 3,     /**< @brief `url->host` */
+    YUAREL_FIELD_PORT = 1 << 4,     /**< @brief `url->port` */
+    YUAREL_FIELD_PATH = 1 << 5,     /**< @brief `url->path` */
+    YUAREL_FIELD_QUERY = 1 << 6,    /**< @brief `url->query` */
+    YUAREL_FIELD_FRAGMENT = 1 << 7, /**< @brief `url->fragment` */
+    YUAREL_FIELD_ALL = 0xff         /**< @brief Every component */
+};
+
+/**
+ * @brief Flags stored in `yuarel_compact.flags`.
+ */
+#define YUAREL_COMPACT_CREDENTIALS 0x01 /**< @brief A username is present */
+#define YUAREL_COMPACT_PASSWORD 0x02    /**< @brief A password is present */
+#define YUAREL_COMPACT_IPV6 0x04        /**< @brief Host is an IPv6 literal */
+#define YUAREL_COMPACT_PORT 0x08        /**< @brief A port is present */
+
+/**
+ * @brief Flags for yuarel_parse_query_ex().
+ */
+#define YUAREL_QUERY_DECODE 0x01 /**< @brief Percent-decode keys and values */
+
+/**
+ * @brief Flags for yuarel_parse_ex(), naming the components to decode.
+ */
+#define YUAREL_DECODE_USERINFO 0x01 /**< @brief `url->username` and `url->password` */
+#define YUAREL_DECODE_PATH 0x02     /**< @brief `url->path` */
+#define YUAREL_DECODE_QUERY 0x04    /**< @brief `url->query`, as a whole */
+#define YUAREL_DECODE_FRAGMENT 0x08 /**< @brief `url->fragment` */
+#define YUAREL_DECODE_ALL 0x0f      /**< @brief Every component above */
+
+/**
+ * @struct yuarel_compact
+ * @brief 16 byte representation of a parsed URL.
+ *
+ * Stores the component boundaries as offsets from the start of the URL string
+ * that was passed to yuarel_parse(), instead of pointers. The string itself is
+ * not part of the struct and has to be kept by the caller. An offset of 0 means
+ * that the component is not present, since only the scheme can start at 0.
+ *
+ * The scheme, when present, starts at offset 0 and the username directly after
+ * the "://". Other component ends are derived from the next component start.
+ *
+ * Limits: URLs of at most 65535 bytes, and scheme, username and host of at
+ * most 255 bytes each.
+ */
+struct yuarel_compact
+{
+    uint16_t host;      /**< @brief Offset of the host, 0 if none */
+    uint16_t path;      /**< @brief Offset of the path, 0 if none */
+    uint16_t query;     /**< @brief Offset of the query, 0 if none */
+    uint16_t fragment;  /**< @brief Offset of the fragment, 0 if none */
+    uint16_t end;       /**< @brief Offset just past the last component */
+    uint16_t port;      /**< @brief Port, default: 0 */
+    uint8_t scheme_len; /**< @brief Length of the scheme, 0 if none */
+    uint8_t user_len;   /**< @brief Length of the username */
+    uint8_t host_len;   /**< @brief Length of the host */
+    uint8_t flags;      /**< @brief YUAREL_COMPACT_* flags */
+};
+
 /**
  * @brief Parse a URL into its components.
  *
@@ -91,7 +224,83 @@ struct yuarel_param
  *
  * @return 0 on success, otherwise -1 on error.
  */
-extern int yuarel_parse(struct yuarel *url, char *url_str);
+YUAREL_API int yuarel_parse(struct yuarel *url, char *url_str);
+
+/**
+ * @brief Parse only the requested components of a URL.
+ *
+ * Accepts the same formats as yuarel_parse(), but only the components named
+ * in `fields` are stored in `url` and null terminated. Scanning stops as soon
+ * as the last requested component is found, so the rest of the string is
+ * neither read nor modified. Components that are not requested are left NULL
+ * (port 0) and are only validated as far as needed to locate the requested
+ * ones.
+ *
+ * Unlike yuarel_parse(), the port is read up to the first non-digit.
+ *
+ * @warning: Modifies the input string as part of the parsing process.
+ *
+ * @param[out] url A pointer to the `yuarel` struct where the parsed values will be stored.
+ * @param[in,out] url_str A pointer to the URL string to be parsed. The string will be modified.
+ * @param[in] fields A bitmask of YUAREL_FIELD_* values.
+ *
+ * @return 0 on success, otherwise -1 on error.
+ */
+YUAREL_API int yuarel_parse_fields(struct yuarel *url, char *url_str, int fields);
+
+/**
+ * @brief Parse a URL and percent-decode the selected components in the same pass.
+ *
+ * Accepts the same formats as yuarel_parse_fields() with YUAREL_FIELD_ALL. The
+ * components named in `flags` are decoded like yuarel_url_decode() while their
+ * end is searched for, so each byte is only read once. Delimiters are only
+ * recognized in the raw bytes, e.g. "%3F" in the path is decoded to '?' and
+ * does not start the query. '+' is only decoded to a space in the query.
+ *
+ * A decoded query can no longer be split on '&' and '='. To get decoded keys
+ * and values, leave YUAREL_DECODE_QUERY out and pass the query to
+ * yuarel_parse_query_ex() with YUAREL_QUERY_DECODE, which splits and decodes it
+ * in one pass.
+ *
+ * @warning: Modifies the input string as part of the parsing process.
+ *
+ * @param[out] url A pointer to the `yuarel` struct where the parsed values will be stored.
+ * @param[in,out] url_str A pointer to the URL string to be parsed. The string will be modified.
+ * @param[in] flags A bitmask of YUAREL_DECODE_* values.
+ *
+ * @return 0 on success, otherwise -1 on error.
+ */
+YUAREL_API int yuarel_parse_ex(struct yuarel *url, char *url_str, int flags);
+
+/**
+ * @brief Parse only the host and port of a URL.
+ *
+ * Same as yuarel_parse_fields() with YUAREL_FIELD_HOST | YUAREL_FIELD_PORT.
+ * Stops scanning at the end of the host and port.
+ *
+ * @warning: Modifies the input string as part of the parsing process.
+ *
+ * @param[out] url A pointer to the `yuarel` struct where the parsed values will be stored.
+ * @param[in,out] url_str A pointer to the URL string to be parsed. The string will be modified.
+ *
+ * @return 0 on success, otherwise -1 on error.
+ */
+YUAREL_API int yuarel_parse_host(struct yuarel *url, char *url_str);
+
+/**
+ * @brief Parse only the path of a URL.
+ *
+ * Same as yuarel_parse_fields() with YUAREL_FIELD_PATH. Stops scanning at the
+ * end of the path, leaving the query and fragment untouched.
+ *
+ * @warning: Modifies the input string as part of the parsing process.
+ *
+ * @param[out] url A pointer to the `yuarel` struct where the parsed values will be stored.
+ * @param[in,out] url_str A pointer to the URL string to be parsed. The string will be modified.
+ *
+ * @return 0 on success, otherwise -1 on error.
+ */
+YUAREL_API int yuarel_parse_path(struct yuarel *url, char *url_str);
 
 /**
  * @brief Split a URL path into parts.
@@ -108,7 +317,40 @@ extern int yuarel_parse(struct yuarel *url, char *url_str);
  *
  * @return The number of parsed path parts, or -1 on error.
  */
-extern int yuarel_split_path(char *path, char **parts, int max_parts);
+YUAREL_API int yuarel_split_path(char *path, char **parts, int max_parts);
+
+/**
+ * @brief Split a URL path into parts, and report their lengths.
+ *
+ * Works like yuarel_split_path(), and also stores the length of each part so
+ * that callers do not need strlen(). The slashes and the end of the path are
+ * found with one bit mask per block of the SIMD kernel, see yuarel_simd_kernel().
+ *
+ * @warning: Modifies the input string as part of the parsing process.
+ *
+ * @param[in,out] path The path string to split. The string will be modified.
+ * @param[out] parts An array where the resulting path parts will be stored.
+ * @param[out] lengths An array where the length of each part will be stored, or NULL.
+ * @param[in] max_parts The maximum number of parts to parse.
+ *
+ * @return The number of parsed path parts, or -1 on error.
+ */
+YUAREL_API int yuarel_split_path_ex(char *path, char **parts, size_t *lengths, int max_parts);
+
+/**
+ * @brief Split a hostname into its labels, from right to left.
+ *
+ * No data is copied or modified. The offset and length of each label within
+ * `host` are stored in `labels`, starting with the top level label. Empty
+ * labels (e.g. from a trailing dot) are skipped.
+ *
+ * @param[in] host The null terminated hostname to split.
+ * @param[out] labels An array where the resulting label spans will be stored.
+ * @param[in] max_labels The maximum number of labels to store.
+ *
+ * @return The number of labels, or -1 on error.
+ */
+YUAREL_API int yuarel_split_host(const char *host, struct yuarel_span *labels, int max_labels);
 
 /**
  * @brief Parse a query string into key-value pairs.
@@ -131,14 +373,39 @@ extern int yuarel_split_path(char *path, char **parts, int max_parts);
  *
  * @return The number of parsed parameters, or -1 on error.
  */
-extern int yuarel_parse_query(char *query, char delimiter, struct yuarel_param *params, int max_params);
+YUAREL_API int yuarel_parse_query(char *query, char delimiter, struct yuarel_param *params, int max_params);
+
+/**
+ * @brief Parse a query string with any set of delimiters into key-value pairs.
+ *
+ * Works like yuarel_parse_query(), but parameters may be separated by any of
+ * the characters in `delimiters`, e.g. "&;" for mixed queries. The delimiters
+ * and the first '=' of each parameter are found in a single pass, comparing a
+ * whole block at a time with the SIMD kernel, see yuarel_simd_kernel().
+ *
+ * With YUAREL_QUERY_DECODE, keys and values are also percent-decoded like
+ * yuarel_url_decode() in the same pass. Decoded characters never split a
+ * parameter.
+ *
+ * @warning: Modifies the input string as part of the parsing process.
+ *
+ * @param[in,out] query The query string to parse. The string will be modified.
+ * @param[in] delimiters The characters that separate key-value pairs in the query.
+ * @param[out] params An array where the parsed key-value pairs will be stored.
+ * @param[in] max_params The maximum number of parameters to parse.
+ * @param[in] flags 0 or YUAREL_QUERY_DECODE.
+ *
+ * @return The number of parsed parameters, or -1 on error.
+ */
+YUAREL_API int yuarel_parse_query_ex(char *query, const char *delimiters, struct yuarel_param *params, int max_params, int flags);
 
 /**
  * @brief Decode a percent-encoded URL string in place.
  *
  * This function decodes percent-encoded characters (`%XX`) in the input URL
  * string and replaces `+` with spaces. The string is modified directly, and
- * no additional memory is allocated.
+ * no additional memory is allocated. The escapes are found a block at a time
+ * with the SIMD kernel, see yuarel_simd_kernel().
  *
  * @warning: Modifies the input string as part of the parsing process.
  *
@@ -146,7 +413,117 @@ extern int yuarel_parse_query(char *query, char delimiter, struct yuarel_param *
  *
  * @return The modified input string (same pointer as `str`).
  */
-extern char *yuarel_url_decode(char *str);
+YUAREL_API char *yuarel_url_decode(char *str);
+
+/**
+ * @brief Get the default port of a scheme.
+ *
+ * @param[in] scheme_id One of the yuarel_scheme values.
+ *
+ * @return The default port, or 0 if the scheme has none or is not known.
+ */
+YUAREL_API int yuarel_default_port(int scheme_id);
+
+/**
+ * @brief Get the port a URL connects to.
+ *
+ * @param[in] url A parsed URL.
+ *
+ * @return `url->port` if given, otherwise the default port of the scheme, or
+ * 0 if neither is known.
+ */
+YUAREL_API int yuarel_effective_port(const struct yuarel *url);
+
+/**
+ * @brief Check if the port of a URL is the default port of its scheme, and
+ * can be left out when the URL is written in canonical form.
+ *
+ * @param[in] url A parsed URL.
+ *
+ * @return 1 if a port is given and it is the default, otherwise 0.
+ */
+YUAREL_API int yuarel_is_default_port(const struct yuarel *url);
+
+/**
+ * @brief Write the SURT key of a parsed URL.
+ *
+ * The Sort-friendly URI Reordering Transform puts the labels of the lowercased
+ * hostname in reverse order, so that URLs of one domain sort next to each
+ * other, e.g. `com,example,www)/path?a=1&b=2`. IP addresses are kept as they
+ * are. A non-default port follows the host, the query parameters are sorted
+ * as spans of `url->query` on the stack, and the scheme, credentials and
+ * fragment are left out. No intermediate strings are built.
+ *
+ * Like snprintf(), the key is truncated to fit `size` and always null
+ * terminated when `size` is not 0.
+ *
+ * @param[in] url A URL parsed by yuarel_parse().
+ * @param[out] buf The buffer to write the key to.
+ * @param[in] size The size of `buf`.
+ *
+ * @return The length of the full key, or -1 if the URL has no host.
+ */
+YUAREL_API long yuarel_surt(const struct yuarel *url, char *buf, size_t size);
+
+/**
+ * @brief Pack a parsed URL into its compact representation.
+ *
+ * @param[out] compact Where to store the compact representation.
+ * @param[in] url A URL parsed by yuarel_parse().
+ * @param[in] base The string that was passed to yuarel_parse().
+ *
+ * @return 0 on success, otherwise -1 if the URL exceeds the compact limits.
+ */
+YUAREL_API int yuarel_compact_pack(struct yuarel_compact *compact, const struct yuarel *url, const char *base);
+
+/**
+ * @brief Expand a compact representation back into a `yuarel` struct.
+ *
+ * @param[out] url A pointer to the `yuarel` struct where the values will be stored.
+ * @param[in] compact The compact representation.
+ * @param[in] base The parsed string the compact representation refers to.
+ *
+ * @return 0 on success, otherwise -1 on error.
+ */
+YUAREL_API int yuarel_compact_unpack(struct yuarel *url, const struct yuarel_compact *compact, char *base);
+
+/**
+ * @brief Get one component of a compact URL as a pointer and length.
+ *
+ * No strlen() is needed, the length is derived from the stored offsets.
+ *
+ * @param[in] compact The compact representation.
+ * @param[in] base The parsed string the compact representation refers to.
+ * @param[in] field One of the YUAREL_FIELD_* values, except YUAREL_FIELD_PORT.
+ * @param[out] len Where to store the length of the component. May be NULL.
+ *
+ * @return A pointer to the component, or NULL if it is not present.
+ */
+YUAREL_API const char *yuarel_compact_get(const struct yuarel_compact *compact, const char *base, int field, size_t *len);
+
+/**
+ * @brief Get the name of the SIMD kernel the scanners use.
+ *
+ * The kernel is chosen on first use: the one named by the YUAREL_FORCE_ISA
+ * environment variable if the CPU supports it, otherwise the widest one it
+ * supports. The names are "avx512bw", "avx2", "sse2" and "scalar", the last
+ * of which is available everywhere.
+ *
+ * @return The name of the kernel.
+ */
+YUAREL_API const char *yuarel_simd_kernel(void);
+
+/**
+ * @brief Choose the SIMD kernel the scanners use.
+ *
+ * Meant for tests and benchmarks. Scans already running in other threads keep
+ * the kernel they started with.
+ *
+ * @param[in] name The name of the kernel, or NULL for the widest one the CPU supports.
+ *
+ * @return 0 on success, otherwise -1 if the kernel is unknown or not supported.
+ */
+YUAREL_API int yuarel_simd_select(const char *name);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,240 @@
+/**
+ * Copyright (C) 2016,2017 Jack Engqvist Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "yuarel_arena.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Alignment of every allocation, enough for pointers and 64 bit integers */
+#define YUAREL_ARENA_ALIGN 16
+
+struct yuarel_arena_chunk
+{
+    struct yuarel_arena_chunk *next;
+    size_t size;
+    size_t used;
+    /* Keeps data[] aligned to YUAREL_ARENA_ALIGN on common ABIs */
+    size_t pad;
+    unsigned char data[];
+};
+
+/**
+ * Allocate a new chunk with room for at least `size` bytes.
+ *
+ * @param size: The number of usable bytes in the chunk.
+ *
+ * @return: The new chunk, or NULL if out of memory.
+ */
+static struct yuarel_arena_chunk *chunk_new(size_t size)
+{
+    struct yuarel_arena_chunk *chunk;
+
+    /* The header is added to the size, which must not wrap around */
+    if (size > SIZE_MAX - sizeof(struct yuarel_arena_chunk))
+    {
+        return NULL;
+    }
+
+    chunk = malloc(sizeof(struct yuarel_arena_chunk) + size);
+    if (NULL == chunk)
+    {
+        return NULL;
+    }
+
+    chunk->next = NULL;
+    chunk->size = size;
+    chunk->used = 0;
+    return chunk;
+}
+
+/**
+ * @brief Initialize an arena.
+ *
+ * No memory is allocated until the first call to yuarel_arena_alloc().
+ *
+ * @param[out] arena The arena to initialize.
+ * @param[in] chunk_size The size of each chunk in bytes, or 0 for
+ *            YUAREL_ARENA_DEFAULT_CHUNK_SIZE.
+ *
+ * @return 0 on success, otherwise -1 on error.
+ */
+int yuarel_arena_init(struct yuarel_arena *arena, size_t chunk_size)
+{
+    if (NULL == arena)
+    {
+        return -1;
+    }
+
+    arena->head = NULL;
+    arena->curr = NULL;
+    arena->chunk_size = chunk_size ? chunk_size : YUAREL_ARENA_DEFAULT_CHUNK_SIZE;
+    return 0;
+}
+
+/**
+ * @brief Allocate memory from an arena.
+ *
+ * The returned memory is aligned for any pointer or integer type. Requests
+ * larger than the chunk size get a chunk of their own.
+ *
+ * @param[in,out] arena The arena to allocate from.
+ * @param[in] size The number of bytes to allocate.
+ *
+ * @return A pointer to the allocated memory, or NULL if out of memory.
+ */
+void *yuarel_arena_alloc(struct yuarel_arena *arena, size_t size)
+{
+    struct yuarel_arena_chunk *chunk;
+    void *ptr;
+
+    /* Rounding up and the chunk header must not wrap around */
+    if (NULL == arena || size > SIZE_MAX - sizeof(struct yuarel_arena_chunk) - (YUAREL_ARENA_ALIGN - 1))
+    {
+        return NULL;
+    }
+
+    size = (size + YUAREL_ARENA_ALIGN - 1) & ~(size_t)(YUAREL_ARENA_ALIGN - 1);
+
+    chunk = arena->curr;
+    if (NULL != chunk && chunk->size - chunk->used >= size)
+    {
+        /* Fast path: bump within the current chunk */
+        ptr = chunk->data + chunk->used;
+        chunk->used += size;
+        return ptr;
+    }
+
+    /* Reuse the next chunk if it was kept by an earlier reset */
+    if (NULL != chunk && NULL != chunk->next && chunk->next->size >= size)
+    {
+        chunk = chunk->next;
+        chunk->used = 0;
+    }
+    else
+    {
+        chunk = chunk_new(size > arena->chunk_size ? size : arena->chunk_size);
+        if (NULL == chunk)
+        {
+            return NULL;
+        }
+
+        /* Link in after the current chunk, so kept chunks are not lost */
+        if (NULL == arena->curr)
+        {
+            chunk->next = arena->head;
+            arena->head = chunk;
+        }
+        else
+        {
+            chunk->next = arena->curr->next;
+            arena->curr->next = chunk;
+        }
+    }
+
+    arena->curr = chunk;
+    ptr = chunk->data;
+    chunk->used = size;
+    return ptr;
+}
+
+/**
+ * @brief Release every allocation made from an arena in O(1).
+ *
+ * The chunks are kept and reused by later allocations. Pointers handed out
+ * before the reset must not be used afterwards.
+ *
+ * @param[in,out] arena The arena to reset.
+ */
+void yuarel_arena_reset(struct yuarel_arena *arena)
+{
+    if (NULL == arena || NULL == arena->head)
+    {
+        return;
+    }
+
+    /* Later chunks are rewound lazily when the allocator moves onto them */
+    arena->curr = arena->head;
+    arena->curr->used = 0;
+}
+
+/**
+ * @brief Free all chunks owned by an arena.
+ *
+ * The arena can be used again after this call, as if newly initialized.
+ *
+ * @param[in,out] arena The arena to free.
+ */
+void yuarel_arena_free(struct yuarel_arena *arena)
+{
+    struct yuarel_arena_chunk *chunk;
+
+    if (NULL == arena)
+    {
+        return;
+    }
+
+    chunk = arena->head;
+    while (NULL != chunk)
+    {
+        struct yuarel_arena_chunk *next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+
+    arena->head = NULL;
+    arena->curr = NULL;
+}
+
+/**
+ * @brief Copy a URL into an arena and parse the copy.
+ *
+ * The original string is left untouched. The parsed components point into
+ * the arena and stay valid until the arena is reset or freed.
+ *
+ * @param[in,out] arena The arena to copy the URL into.
+ * @param[in] url_str The URL to parse. Does not need to be null terminated.
+ * @param[in] len The length of `url_str` in bytes.
+ * @param[out] url A pointer to the `yuarel` struct where the parsed values will be stored.
+ *
+ * @return 0 on success, otherwise -1 on error.
+ */
+int yuarel_parse_copy(struct yuarel_arena *arena, const char *url_str, size_t len, struct yuarel *url)
+{
+    char *copy;
+
+    /* No room for the null terminator, len + 1 would wrap to 0 */
+    if (NULL == url_str || NULL == url || SIZE_MAX == len)
+    {
+        return -1;
+    }
+
+    copy = yuarel_arena_alloc(arena, len + 1);
+    if (NULL == copy)
+    {
+        return -1;
+    }
+
+    memcpy(copy, url_str, len);
+    copy[len] = '\0';
+
+    return yuarel_parse(url, copy);
+}
@@ -0,0 +1,128 @@
+/**
+ * @file yuarel_arena.h
+ * @brief Bump allocator for keeping copies of URLs during bulk parsing.
+ *
+ * yuarel_parse() modifies the string it is given. Callers that need to keep
+ * the original URL around would otherwise have to malloc() a copy per URL.
+ * The arena hands out memory from large chunks instead, and a whole batch of
+ * copies can be released at once with yuarel_arena_reset().
+ *
+ * An arena is not thread safe. Use one arena per thread.
+ *
+ * @copyright Copyright (C) 2016 Jack Engqvist Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef INC_YUAREL_ARENA_H
+#define INC_YUAREL_ARENA_H
+
+#include "yuarel.h"
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** @brief Chunk size used when 0 is passed to yuarel_arena_init() */
+#define YUAREL_ARENA_DEFAULT_CHUNK_SIZE (64 * 1024)
+
+struct yuarel_arena_chunk;
+
+/**
+ * @struct yuarel_arena
+ * @brief Chunked bump allocator.
+ *
+ * Chunks are kept in a singly linked list. Allocation bumps an offset in the
+ * current chunk and moves on to the next chunk when it is full. Resetting only
+ * rewinds to the first chunk, so chunks are reused by the next batch.
+ */
+struct yuarel_arena
+{
+    struct yuarel_arena_chunk *head; /**< @brief First chunk, default: NULL */
+    struct yuarel_arena_chunk *curr; /**< @brief Chunk allocations are taken from */
+    size_t chunk_size;               /**< @brief Size of each new chunk */
+};
+
+/**
+ * @brief Initialize an arena.
+ *
+ * No memory is allocated until the first call to yuarel_arena_alloc().
+ *
+ * @param[out] arena The arena to initialize.
+ * @param[in] chunk_size The size of each chunk in bytes, or 0 for
+ *            YUAREL_ARENA_DEFAULT_CHUNK_SIZE.
+ *
+ * @return 0 on success, otherwise -1 on error.
+ */
+extern int yuarel_arena_init(struct yuarel_arena *arena, size_t chunk_size);
+
+/**
+ * @brief Allocate memory from an arena.
+ *
+ * The returned memory is aligned for any pointer or integer type. Requests
+ * larger than the chunk size get a chunk of their own.
+ *
+ * @param[in,out] arena The arena to allocate from.
+ * @param[in] size The number of bytes to allocate.
+ *
+ * @return A pointer to the allocated memory, or NULL if out of memory.
+ */
+extern void *yuarel_arena_alloc(struct yuarel_arena *arena, size_t size);
+
+/**
+ * @brief Release every allocation made from an arena in O(1).
+ *
+ * The chunks are kept and reused by later allocations. Pointers handed out
+ * before the reset must not be used afterwards.
+ *
+ * @param[in,out] arena The arena to reset.
+ */
+extern void yuarel_arena_reset(struct yuarel_arena *arena);
+
+/**
+ * @brief Free all chunks owned by an arena.
+ *
+ * The arena can be used again after this call, as if newly initialized.
+ *
+ * @param[in,out] arena The arena to free.
+ */
+extern void yuarel_arena_free(struct yuarel_arena *arena);
+
+/**
+ * @brief Copy a URL into an arena and parse the copy.
+ *
+ * The original string is left untouched. The parsed components point into
+ * the arena and stay valid until the arena is reset or freed.
+ *
+ * @param[in,out] arena The arena to copy the URL into.
+ * @param[in] url_str The URL to parse. Does not need to be null terminated.
+ * @param[in] len The length of `url_str` in bytes.
+ * @param[out] url A pointer to the `yuarel` struct where the parsed values will be stored.
+ *
+ * @return 0 on success, otherwise -1 on error.
+ */
+extern int yuarel_parse_copy(struct yuarel_arena *arena, const char *url_str, size_t len, struct yuarel *url);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_YUAREL_ARENA_H */
@@ -0,0 +1,770 @@
+/**
+ * Copyright (C) 2016,2017 Jack Engqvist Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#define _POSIX_C_SOURCE 200809L
+
+#include "yuarel_corpus.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define CORPUS_MAGIC "YUC\x1a"
+#define CORPUS_ALIGN 8
+
+/* Columns, in the order they appear in the file */
+enum corpus_column
+{
+    COL_STARTS,
+    COL_COMPACT,
+    COL_RAW,
+    COL_SEG_INDEX,
+    COL_SEGS,
+    COL_PARAM_INDEX,
+    COL_PARAMS,
+    COL_COUNT
+};
+
+/* File header, followed by the columns each aligned to CORPUS_ALIGN */
+struct corpus_header
+{
+    char magic[4];
+    uint32_t version;
+    uint64_t count;
+    uint64_t raw_size;
+    uint64_t seg_count;
+    uint64_t param_count;
+    uint32_t checksum;
+    uint32_t header_size;
+    uint64_t reserved[2];
+};
+
+/* Growable buffer used to build one column while writing */
+struct column
+{
+    unsigned char *data;
+    size_t len;
+    size_t cap;
+};
+
+/**
+ * Append bytes to a column, growing it as needed.
+ *
+ * @param col: The column to append to.
+ * @param data: The bytes to append.
+ * @param len: The number of bytes.
+ *
+ * @return: 0 on success, or -1 if out of memory.
+ */
+static int column_append(struct column *col, const void *data, size_t len)
+{
+    if (col->cap - col->len < len)
+    {
+        size_t cap = col->cap ? col->cap : 4096;
+        unsigned char *grown;
+
+        while (cap - col->len < len)
+        {
+            cap *= 2;
+        }
+
+        grown = realloc(col->data, cap);
+        if (NULL == grown)
+        {
+            return -1;
+        }
+        col->data = grown;
+        col->cap = cap;
+    }
+
+    memcpy(col->data + col->len, data, len);
+    col->len += len;
+    return 0;
+}
+
+/**
+ * Append a 32 bit index entry to a column.
+ *
+ * @param col: The column to append to.
+ * @param value: The value, which must fit in 32 bits.
+ *
+ * @return: 0 on success, or -1 on overflow or if out of memory.
+ */
+static int column_append_u32(struct column *col, size_t value)
+{
+    uint32_t v = (uint32_t)value;
+
+    if (value > UINT32_MAX)
+    {
+        return -1;
+    }
+
+    return column_append(col, &v, sizeof(v));
+}
+
+/**
+ * 32 bit FNV-1a hash, used as the checksum of the columns.
+ *
+ * @param hash: The hash of the preceding bytes, or the FNV offset basis.
+ * @param data: The bytes to hash.
+ * @param len: The number of bytes.
+ *
+ * @return: The updated hash.
+ */
+static uint32_t fnv1a(uint32_t hash, const unsigned char *data, size_t len)
+{
+    size_t i;
+
+    for (i = 0; i < len; i++)
+    {
+        hash ^= data[i];
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+/**
+ * Compute where each column starts in the file.
+ *
+ * @param h: The header holding the element counts.
+ * @param off: Receives the start of each column, and the file size last.
+ *
+ * @return: 0 on success, or -1 if the counts overflow.
+ */
+static int corpus_layout(const struct corpus_header *h, uint64_t off[COL_COUNT + 1])
+{
+    uint64_t size[COL_COUNT];
+    uint64_t pos = sizeof(struct corpus_header);
+    int i;
+
+    /* Bound counts so that the multiplications below can not overflow */
+    if (h->count > UINT32_MAX || h->seg_count > UINT32_MAX || h->param_count > UINT32_MAX || h->raw_size > UINT32_MAX)
+    {
+        return -1;
+    }
+
+    size[COL_STARTS] = (h->count + 1) * sizeof(uint32_t);
+    size[COL_COMPACT] = h->count * sizeof(struct yuarel_compact);
+    size[COL_RAW] = h->raw_size;
+    size[COL_SEG_INDEX] = (h->count + 1) * sizeof(uint32_t);
+    size[COL_SEGS] = h->seg_count * sizeof(struct yuarel_corpus_span);
+    size[COL_PARAM_INDEX] = (h->count + 1) * sizeof(uint32_t);
+    size[COL_PARAMS] = h->param_count * sizeof(struct yuarel_corpus_param);
+
+    for (i = 0; i < COL_COUNT; i++)
+    {
+        off[i] = pos;
+        pos = (pos + size[i] + CORPUS_ALIGN - 1) & ~(uint64_t)(CORPUS_ALIGN - 1);
+    }
+    off[COL_COUNT] = pos;
+
+    return 0;
+}
+
+/**
+ * Record the path segments of one URL, split like yuarel_split_path() but
+ * without modifying the path.
+ *
+ * @param segs: The column to append segments to.
+ * @param path: The null terminated path.
+ * @param base: The start of the URL the offsets are relative to.
+ *
+ * @return: The number of segments, -1 if out of memory, or -2 if an offset,
+ *          length or the count does not fit in 16 bits.
+ */
+static long index_segments(struct column *segs, const char *path, const char *base)
+{
+    long n = 0;
+
+    for (;;)
+    {
+        struct yuarel_corpus_span span;
+        size_t len;
+
+        while ('/' == *path)
+        {
+            path++;
+        }
+
+        if ('\0' == *path)
+        {
+            return n;
+        }
+
+        len = strcspn(path, "/");
+        if ((size_t)(path - base) > UINT16_MAX || len > UINT16_MAX || n == UINT16_MAX)
+        {
+            return -2;
+        }
+        span.off = (uint16_t)(path - base);
+        span.len = (uint16_t)len;
+        if (column_append(segs, &span, sizeof(span)))
+        {
+            return -1;
+        }
+
+        n++;
+        path += len;
+    }
+}
+
+/**
+ * Record the query parameters of one URL, split like yuarel_parse_query()
+ * with '&' as delimiter but without modifying the query.
+ *
+ * @param params: The column to append parameters to.
+ * @param query: The null terminated query.
+ * @param base: The start of the URL the offsets are relative to.
+ *
+ * @return: The number of parameters, -1 if out of memory, or -2 if an
+ *          offset, length or the count does not fit in 16 bits.
+ */
+static long index_params(struct column *params, const char *query, const char *base)
+{
+    long n = 0;
+
+    if ('\0' == *query)
+    {
+        return 0;
+    }
+
+    for (;;)
+    {
+        struct yuarel_corpus_param param;
+        size_t len = strcspn(query, "&");
+        const char *eq = memchr(query, '=', len);
+
+        if ((size_t)(query - base) + len > UINT16_MAX || n == UINT16_MAX)
+        {
+            return -2;
+        }
+        param.key = (uint16_t)(query - base);
+        if (NULL != eq)
+        {
+            param.key_len = (uint16_t)(eq - query);
+            param.val = (uint16_t)(eq + 1 - base);
+            param.val_len = (uint16_t)(len - param.key_len - 1);
+        }
+        else
+        {
+            param.key_len = (uint16_t)len;
+            param.val = 0;
+            param.val_len = 0;
+        }
+
+        if (column_append(params, &param, sizeof(param)))
+        {
+            return -1;
+        }
+        n++;
+
+        if ('\0' == query[len])
+        {
+            return n;
+        }
+        query += len + 1;
+    }
+}
+
+/**
+ * @brief Parse a set of URLs and write them to a `.yuc` file.
+ *
+ * The URLs are parsed with yuarel_parse(), path segments are split like
+ * yuarel_split_path() and query parameters like yuarel_parse_query() with '&'
+ * as delimiter. URLs that fail to parse, or exceed the limits of
+ * `yuarel_compact`, are kept in the file but marked as invalid.
+ *
+ * @param[in] filename The file to write.
+ * @param[in] urls The URLs to store.
+ * @param[in] count The number of URLs.
+ *
+ * @return The number of valid URLs written, or -1 on error.
+ */
+long yuarel_corpus_write(const char *filename, const char *const *urls, size_t count)
+{
+    static const unsigned char zeros[CORPUS_ALIGN] = {0};
+    struct column col[COL_COUNT];
+    struct corpus_header header;
+    uint64_t off[COL_COUNT + 1];
+    char *buf = NULL;
+    size_t buf_cap = 0;
+    long valid = 0;
+    long rc = -1;
+    size_t seg_total = 0;
+    size_t param_total = 0;
+    size_t i;
+    FILE *fp = NULL;
+
+    if (NULL == filename || (NULL == urls && count > 0))
+    {
+        return -1;
+    }
+
+    memset(col, 0, sizeof(col));
+
+    for (i = 0; i < count; i++)
+    {
+        struct yuarel url;
+        struct yuarel_compact compact;
+        size_t len = strlen(urls[i]);
+        int ok;
+
+        if (buf_cap < len + 1)
+        {
+            char *grown = realloc(buf, len + 1);
+            if (NULL == grown)
+            {
+                goto out;
+            }
+            buf = grown;
+            buf_cap = len + 1;
+        }
+        memcpy(buf, urls[i], len + 1);
+
+        ok = len <= UINT16_MAX && 0 == yuarel_parse(&url, buf) && 0 == yuarel_compact_pack(&compact, &url, buf);
+
+        /* The index entries are appended first, and dropped again if they do not fit */
+        if (column_append_u32(&col[COL_SEG_INDEX], seg_total) ||
+            column_append_u32(&col[COL_PARAM_INDEX], param_total))
+        {
+            goto out;
+        }
+        if (ok)
+        {
+            size_t segs_len = col[COL_SEGS].len;
+            size_t params_len = col[COL_PARAMS].len;
+            long segs = 0;
+            long params = 0;
+
+            if (NULL != url.path)
+            {
+                segs = index_segments(&col[COL_SEGS], url.path, buf);
+            }
+            if (segs >= 0 && NULL != url.query)
+            {
+                params = index_params(&col[COL_PARAMS], url.query, buf);
+            }
+            if (-1 == segs || -1 == params)
+            {
+                goto out;
+            }
+
+            if (segs < 0 || params < 0)
+            {
+                col[COL_SEGS].len = segs_len;
+                col[COL_PARAMS].len = params_len;
+                ok = 0;
+            }
+            else
+            {
+                seg_total += (size_t)segs;
+                param_total += (size_t)params;
+                valid++;
+            }
+        }
+
+        if (!ok)
+        {
+            /* Invalid URLs are stored as given, with an empty compact entry */
+            memset(&compact, 0, sizeof(compact));
+            memcpy(buf, urls[i], len + 1);
+        }
+
+        if (column_append_u32(&col[COL_STARTS], col[COL_RAW].len) ||
+            column_append(&col[COL_COMPACT], &compact, sizeof(compact)) ||
+            column_append(&col[COL_RAW], buf, len + 1))
+        {
+            goto out;
+        }
+    }
+
+    if (column_append_u32(&col[COL_STARTS], col[COL_RAW].len) ||
+        column_append_u32(&col[COL_SEG_INDEX], seg_total) ||
+        column_append_u32(&col[COL_PARAM_INDEX], param_total))
+    {
+        goto out;
+    }
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, CORPUS_MAGIC, 4);
+    header.version = YUAREL_CORPUS_VERSION;
+    header.count = count;
+    header.raw_size = col[COL_RAW].len;
+    header.seg_count = seg_total;
+    header.param_count = param_total;
+    header.header_size = sizeof(struct corpus_header);
+    if (corpus_layout(&header, off))
+    {
+        goto out;
+    }
+
+    /* Checksum covers every byte after the header, padding included */
+    header.checksum = 2166136261u;
+    for (i = 0; i < COL_COUNT; i++)
+    {
+        header.checksum = fnv1a(header.checksum, col[i].data, col[i].len);
+        header.checksum = fnv1a(header.checksum, zeros, off[i + 1] - off[i] - col[i].len);
+    }
+
+    fp = fopen(filename, "wb");
+    if (NULL == fp)
+    {
+        goto out;
+    }
+
+    if (1 != fwrite(&header, sizeof(header), 1, fp))
+    {
+        goto out;
+    }
+
+    for (i = 0; i < COL_COUNT; i++)
+    {
+        size_t pad = off[i + 1] - off[i] - col[i].len;
+
+        if (col[i].len != fwrite(col[i].data, 1, col[i].len, fp) || pad != fwrite(zeros, 1, pad, fp))
+        {
+            goto out;
+        }
+    }
+
+    rc = valid;
+
+out:
+    if (NULL != fp && 0 != fclose(fp))
+    {
+        rc = -1;
+    }
+    for (i = 0; i < COL_COUNT; i++)
+    {
+        free(col[i].data);
+    }
+    free(buf);
+    return rc;
+}
+
+/**
+ * Check that the index tables of a mapped corpus increase and stay within
+ * the totals, so that every entry lies within its column.
+ *
+ * @param corpus: The corpus to check.
+ *
+ * @return: 0 if every URL is null terminated within the raw column and the
+ *          segment and parameter ranges are in order, otherwise -1.
+ */
+static int corpus_check_bounds(const struct yuarel_corpus *corpus)
+{
+    size_t count = corpus->count;
+    size_t i;
+
+    if (0 != corpus->starts[0] || 0 != corpus->seg_index[0] || 0 != corpus->param_index[0])
+    {
+        return -1;
+    }
+
+    /* The last entries hold the totals, which the columns have been sized by */
+    for (i = 0; i < count; i++)
+    {
+        if (corpus->starts[i + 1] <= corpus->starts[i] || corpus->starts[i + 1] > corpus->starts[count] ||
+            '\0' != corpus->raw[corpus->starts[i + 1] - 1] || corpus->seg_index[i + 1] < corpus->seg_index[i] ||
+            corpus->seg_index[i + 1] > corpus->seg_index[count] ||
+            corpus->param_index[i + 1] < corpus->param_index[i] ||
+            corpus->param_index[i + 1] > corpus->param_index[count])
+        {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * Check the offsets of a compact entry against the length of its URL.
+ *
+ * @param compact: The compact entry.
+ * @param len: The length of the URL, including its null terminator.
+ *
+ * @return: 0 if every component starts within the URL, otherwise -1.
+ */
+static int corpus_check_compact(const struct yuarel_compact *compact, size_t len)
+{
+    size_t user_end = (size_t)compact->scheme_len + 3 + compact->user_len;
+
+    if (compact->end >= len || compact->scheme_len > compact->end || compact->host > compact->end ||
+        compact->path > compact->end || compact->query > compact->end || compact->fragment > compact->end)
+    {
+        return -1;
+    }
+
+    /* The username follows the "://", and the password the ':' after it */
+    if ((compact->flags & YUAREL_COMPACT_CREDENTIALS) &&
+        user_end + ((compact->flags & YUAREL_COMPACT_PASSWORD) ? 1 : 0) > compact->end)
+    {
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * Check the compact entries, path segments and query parameters of a mapped
+ * corpus against the length of their URL.
+ *
+ * @param corpus: The corpus to check, which has passed corpus_check_bounds().
+ *
+ * @return: 0 if every component, segment and parameter lies within its URL.
+ */
+static int corpus_check_entries(const struct yuarel_corpus *corpus)
+{
+    size_t i;
+
+    for (i = 0; i < corpus->count; i++)
+    {
+        size_t len = corpus->starts[i + 1] - corpus->starts[i];
+        size_t j;
+
+        if (corpus_check_compact(&corpus->compact[i], len))
+        {
+            return -1;
+        }
+
+        for (j = corpus->seg_index[i]; j < corpus->seg_index[i + 1]; j++)
+        {
+            if ((size_t)corpus->segs[j].off + corpus->segs[j].len >= len)
+            {
+                return -1;
+            }
+        }
+
+        for (j = corpus->param_index[i]; j < corpus->param_index[i + 1]; j++)
+        {
+            if ((size_t)corpus->params[j].key + corpus->params[j].key_len >= len ||
+                (size_t)corpus->params[j].val + corpus->params[j].val_len >= len)
+            {
+                return -1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Open a `.yuc` file by mapping it into memory.
+ *
+ * The mapping is private and writable, so the components can be modified in
+ * place (e.g. by yuarel_url_decode()) without changing the file.
+ *
+ * The index tables are always checked to be in order and within the file.
+ * With YUAREL_CORPUS_VERIFY, the checksum is checked as well, and so are the
+ * component offsets, path segments and query parameters of every URL.
+ *
+ * @param[out] corpus The corpus to open.
+ * @param[in] filename The file to open.
+ * @param[in] flags 0 or YUAREL_CORPUS_VERIFY.
+ *
+ * @return 0 on success, otherwise -1 on error or if the file is invalid.
+ */
+int yuarel_corpus_open(struct yuarel_corpus *corpus, const char *filename, int flags)
+{
+    struct corpus_header header;
+    uint64_t off[COL_COUNT + 1];
+    struct stat st;
+    unsigned char *map;
+    int fd;
+
+    if (NULL == corpus || NULL == filename)
+    {
+        return -1;
+    }
+
+    memset(corpus, 0, sizeof(struct yuarel_corpus));
+
+    fd = open(filename, O_RDONLY);
+    if (fd < 0)
+    {
+        return -1;
+    }
+
+    if (0 != fstat(fd, &st) || (size_t)st.st_size < sizeof(struct corpus_header))
+    {
+        close(fd);
+        return -1;
+    }
+
+    map = mmap(NULL, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (MAP_FAILED == map)
+    {
+        return -1;
+    }
+
+    corpus->map = map;
+    corpus->map_size = (size_t)st.st_size;
+
+    memcpy(&header, map, sizeof(header));
+    if (0 != memcmp(header.magic, CORPUS_MAGIC, 4) ||
+        YUAREL_CORPUS_VERSION != header.version ||
+        sizeof(struct corpus_header) != header.header_size ||
+        0 != corpus_layout(&header, off) ||
+        off[COL_COUNT] != (uint64_t)st.st_size)
+    {
+        yuarel_corpus_close(corpus);
+        return -1;
+    }
+
+    corpus->count = (size_t)header.count;
+    corpus->starts = (const uint32_t *)(map + off[COL_STARTS]);
+    corpus->compact = (const struct yuarel_compact *)(map + off[COL_COMPACT]);
+    corpus->raw = (char *)(map + off[COL_RAW]);
+    corpus->seg_index = (const uint32_t *)(map + off[COL_SEG_INDEX]);
+    corpus->segs = (const struct yuarel_corpus_span *)(map + off[COL_SEGS]);
+    corpus->param_index = (const uint32_t *)(map + off[COL_PARAM_INDEX]);
+    corpus->params = (const struct yuarel_corpus_param *)(map + off[COL_PARAMS]);
+
+    /* The index tables are checked always, the entries they point to only when verifying */
+    if (corpus->starts[corpus->count] != header.raw_size ||
+        corpus->seg_index[corpus->count] != header.seg_count ||
+        corpus->param_index[corpus->count] != header.param_count ||
+        corpus_check_bounds(corpus))
+    {
+        yuarel_corpus_close(corpus);
+        return -1;
+    }
+
+    if (flags & YUAREL_CORPUS_VERIFY)
+    {
+        uint32_t checksum = fnv1a(2166136261u, map + sizeof(header), corpus->map_size - sizeof(header));
+
+        if (checksum != header.checksum || corpus_check_entries(corpus))
+        {
+            yuarel_corpus_close(corpus);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Unmap a corpus opened by yuarel_corpus_open().
+ *
+ * @param[in,out] corpus The corpus to close.
+ */
+void yuarel_corpus_close(struct yuarel_corpus *corpus)
+{
+    if (NULL == corpus || NULL == corpus->map)
+    {
+        return;
+    }
+
+    munmap(corpus->map, corpus->map_size);
+    memset(corpus, 0, sizeof(struct yuarel_corpus));
+}
+
+/**
+ * @brief Get the parsed components of one URL in a corpus.
+ *
+ * @param[in] corpus The corpus.
+ * @param[in] index The index of the URL.
+ * @param[out] url A pointer to the `yuarel` struct where the values will be stored.
+ *
+ * @return 0 on success, otherwise -1 if out of range or the URL was invalid.
+ */
+int yuarel_corpus_get(const struct yuarel_corpus *corpus, size_t index, struct yuarel *url)
+{
+    if (NULL == corpus || index >= corpus->count)
+    {
+        return -1;
+    }
+
+    /* Every valid URL ends past offset 0, see yuarel_compact */
+    if (0 == corpus->compact[index].end)
+    {
+        return -1;
+    }
+
+    return yuarel_compact_unpack(url, &corpus->compact[index], corpus->raw + corpus->starts[index]);
+}
+
+/**
+ * @brief Get the start of one URL in a corpus.
+ *
+ * The offsets in `yuarel_compact`, `yuarel_corpus_span` and
+ * `yuarel_corpus_param` are relative to this pointer.
+ *
+ * @param[in] corpus The corpus.
+ * @param[in] index The index of the URL.
+ *
+ * @return A pointer to the URL, or NULL if out of range.
+ */
+char *yuarel_corpus_base(const struct yuarel_corpus *corpus, size_t index)
+{
+    if (NULL == corpus || index >= corpus->count)
+    {
+        return NULL;
+    }
+
+    return corpus->raw + corpus->starts[index];
+}
+
+/**
+ * @brief Get the path segments of one URL in a corpus.
+ *
+ * @param[in] corpus The corpus.
+ * @param[in] index The index of the URL.
+ * @param[out] count Where to store the number of segments.
+ *
+ * @return A pointer to the segments, or NULL if out of range.
+ */
+const struct yuarel_corpus_span *yuarel_corpus_segments(const struct yuarel_corpus *corpus, size_t index, size_t *count)
+{
+    if (NULL == corpus || NULL == count || index >= corpus->count)
+    {
+        return NULL;
+    }
+
+    *count = corpus->seg_index[index + 1] - corpus->seg_index[index];
+    return corpus->segs + corpus->seg_index[index];
+}
+
+/**
+ * @brief Get the query parameters of one URL in a corpus.
+ *
+ * @param[in] corpus The corpus.
+ * @param[in] index The index of the URL.
+ * @param[out] count Where to store the number of parameters.
+ *
+ * @return A pointer to the parameters, or NULL if out of range.
+ */
+const struct yuarel_corpus_param *yuarel_corpus_params(const struct yuarel_corpus *corpus, size_t index, size_t *count)
+{
+    if (NULL == corpus || NULL == count || index >= corpus->count)
+    {
+        return NULL;
+    }
+
+    *count = corpus->param_index[index + 1] - corpus->param_index[index];
+    return corpus->params + corpus->param_index[index];
+}
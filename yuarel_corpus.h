@@ -0,0 +1,188 @@
+/**
+ * @file yuarel_corpus.h
+ * @brief Memory mappable columnar file format for sets of parsed URLs.
+ *
+ * A `.yuc` file stores a parsed corpus of URLs in columns, so that later
+ * pipeline stages can mmap it and use the parsed components directly, with no
+ * re-parse and no deserialization copy:
+ *
+ *  - the raw URL bytes, as left by yuarel_parse() (components null terminated)
+ *  - the component offsets and decoded port of each URL (`yuarel_compact`)
+ *  - an index table of path segments per URL
+ *  - an index table of query parameters per URL
+ *
+ * The file starts with a versioned header and a checksum of all columns. The
+ * columns are written in native byte order, a file written on a host of the
+ * other byte order is rejected by the version check.
+ *
+ * @copyright Copyright (C) 2016 Jack Engqvist Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef INC_YUAREL_CORPUS_H
+#define INC_YUAREL_CORPUS_H
+
+#include "yuarel.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** @brief Format version written to and accepted from the file header */
+#define YUAREL_CORPUS_VERSION 1
+
+/** @brief Flag for yuarel_corpus_open(): verify the checksum and every entry of all columns */
+#define YUAREL_CORPUS_VERIFY 0x01
+
+/**
+ * @struct yuarel_corpus_span
+ * @brief A path segment, as an offset and length from the start of its URL.
+ */
+struct yuarel_corpus_span
+{
+    uint16_t off; /**< @brief Offset from the start of the URL */
+    uint16_t len; /**< @brief Length in bytes */
+};
+
+/**
+ * @struct yuarel_corpus_param
+ * @brief A query parameter, as offsets and lengths from the start of its URL.
+ */
+struct yuarel_corpus_param
+{
+    uint16_t key;     /**< @brief Offset of the key */
+    uint16_t key_len; /**< @brief Length of the key */
+    uint16_t val;     /**< @brief Offset of the value, 0 if there is no value */
+    uint16_t val_len; /**< @brief Length of the value */
+};
+
+/**
+ * @struct yuarel_corpus
+ * @brief An opened `.yuc` file. All pointers point into the mapping.
+ */
+struct yuarel_corpus
+{
+    void *map;                                /**< @brief Start of the mapping */
+    size_t map_size;                          /**< @brief Size of the mapping */
+    size_t count;                             /**< @brief Number of URLs */
+    const uint32_t *starts;                   /**< @brief Offset of each URL in `raw`, count + 1 entries */
+    const struct yuarel_compact *compact;     /**< @brief Components of each URL */
+    char *raw;                                /**< @brief Raw parsed URL bytes */
+    const uint32_t *seg_index;                /**< @brief First segment of each URL, count + 1 entries */
+    const struct yuarel_corpus_span *segs;    /**< @brief Path segments */
+    const uint32_t *param_index;              /**< @brief First parameter of each URL, count + 1 entries */
+    const struct yuarel_corpus_param *params; /**< @brief Query parameters */
+};
+
+/**
+ * @brief Parse a set of URLs and write them to a `.yuc` file.
+ *
+ * The URLs are parsed with yuarel_parse(), path segments are split like
+ * yuarel_split_path() and query parameters like yuarel_parse_query() with '&'
+ * as delimiter. URLs that fail to parse, or exceed the limits of
+ * `yuarel_compact`, are kept in the file but marked as invalid.
+ *
+ * @param[in] filename The file to write.
+ * @param[in] urls The URLs to store.
+ * @param[in] count The number of URLs.
+ *
+ * @return The number of valid URLs written, or -1 on error.
+ */
+extern long yuarel_corpus_write(const char *filename, const char *const *urls, size_t count);
+
+/**
+ * @brief Open a `.yuc` file by mapping it into memory.
+ *
+ * The mapping is private and writable, so the components can be modified in
+ * place (e.g. by yuarel_url_decode()) without changing the file.
+ *
+ * The index tables are always checked to be in order and within the file.
+ * With YUAREL_CORPUS_VERIFY, the checksum is checked as well, and so are the
+ * component offsets, path segments and query parameters of every URL.
+ *
+ * @param[out] corpus The corpus to open.
+ * @param[in] filename The file to open.
+ * @param[in] flags 0 or YUAREL_CORPUS_VERIFY.
+ *
+ * @return 0 on success, otherwise -1 on error or if the file is invalid.
+ */
+extern int yuarel_corpus_open(struct yuarel_corpus *corpus, const char *filename, int flags);
+
+/**
+ * @brief Unmap a corpus opened by yuarel_corpus_open().
+ *
+ * @param[in,out] corpus The corpus to close.
+ */
+extern void yuarel_corpus_close(struct yuarel_corpus *corpus);
+
+/**
+ * @brief Get the parsed components of one URL in a corpus.
+ *
+ * @param[in] corpus The corpus.
+ * @param[in] index The index of the URL.
+ * @param[out] url A pointer to the `yuarel` struct where the values will be stored.
+ *
+ * @return 0 on success, otherwise -1 if out of range or the URL was invalid.
+ */
+extern int yuarel_corpus_get(const struct yuarel_corpus *corpus, size_t index, struct yuarel *url);
+
+/**
+ * @brief Get the start of one URL in a corpus.
+ *
+ * The offsets in `yuarel_compact`, `yuarel_corpus_span` and
+ * `yuarel_corpus_param` are relative to this pointer.
+ *
+ * @param[in] corpus The corpus.
+ * @param[in] index The index of the URL.
+ *
+ * @return A pointer to the URL, or NULL if out of range.
+ */
+extern char *yuarel_corpus_base(const struct yuarel_corpus *corpus, size_t index);
+
+/**
+ * @brief Get the path segments of one URL in a corpus.
+ *
+ * @param[in] corpus The corpus.
+ * @param[in] index The index of the URL.
+ * @param[out] count Where to store the number of segments.
+ *
+ * @return A pointer to the segments, or NULL if out of range.
+ */
+extern const struct yuarel_corpus_span *yuarel_corpus_segments(const struct yuarel_corpus *corpus, size_t index, size_t *count);
+
+/**
+ * @brief Get the query parameters of one URL in a corpus.
+ *
+ * @param[in] corpus The corpus.
+ * @param[in] index The index of the URL.
+ * @param[out] count Where to store the number of parameters.
+ *
+ * @return A pointer to the parameters, or NULL if out of range.
+ */
+extern const struct yuarel_corpus_param *yuarel_corpus_params(const struct yuarel_corpus *corpus, size_t index, size_t *count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_YUAREL_CORPUS_H */
@@ -0,0 +1,414 @@
+/**
+ * Copyright (C) 2016,2017 Jack Engqvist Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "yuarel_form.h"
+#include "yuarel_internal.h"
+#include <string.h>
+
+#ifdef YUAREL_X86
+#include <immintrin.h>
+#endif
+
+/**
+ * Check if a byte ends a run of bytes that are copied as they are.
+ *
+ * @param c: The byte.
+ *
+ * @return: 1 for '&', '=', '%' and '+', otherwise 0.
+ */
+static inline int is_special(char c)
+{
+    return '&' == c || '=' == c || '%' == c || '+' == c;
+}
+
+/**
+ * @struct form_scan
+ * @brief The last block searched for special bytes within a chunk.
+ */
+struct form_scan
+{
+    size_t base;   /* Offset of the block in the chunk */
+    unsigned mask; /* Bit per special byte of the block */
+    int valid;     /* 1 once a block has been searched */
+#ifdef YUAREL_X86
+    int sse2;      /* 1 if the selected kernel allows SSE2 */
+#endif
+};
+
+#ifdef YUAREL_X86
+/**
+ * Find the special bytes of a block.
+ *
+ * @param str: The 16 bytes of the block.
+ *
+ * @return: A mask with one bit per '&', '=', '%' or '+'.
+ */
+static inline __attribute__((target("sse2"))) unsigned special_mask(const char *str)
+{
+    __m128i v = _mm_loadu_si128((const __m128i *)str);
+    __m128i hit = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('&')),
+                                            _mm_cmpeq_epi8(v, _mm_set1_epi8('='))),
+                               _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('%')),
+                                            _mm_cmpeq_epi8(v, _mm_set1_epi8('+'))));
+
+    return (unsigned)_mm_movemask_epi8(hit);
+}
+#endif
+
+/**
+ * Find the next '&', '=', '%' or '+' in a chunk.
+ *
+ * Unless the scalar kernel is selected, a block of 16 bytes is compared at a
+ * time with SSE2, and its bit mask is kept for the following calls, since
+ * the special bytes of a form are often only a few bytes apart.
+ *
+ * @param str: The chunk.
+ * @param len: The length of the chunk.
+ * @param i: The offset to search from.
+ * @param scan: The last block searched.
+ *
+ * @return: The offset of the next special byte, or `len` if none.
+ */
+static size_t next_special(const char *str, size_t len, size_t i, struct form_scan *scan)
+{
+#ifdef YUAREL_X86
+    while (scan->sse2)
+    {
+        if (scan->valid && i - scan->base < 16)
+        {
+            unsigned mask = scan->mask >> (i - scan->base);
+
+            if (mask)
+            {
+                return i + (size_t)__builtin_ctz(mask);
+            }
+            i = scan->base + 16;
+        }
+        if (i + 16 > len)
+        {
+            break;
+        }
+        scan->base = i;
+        scan->mask = special_mask(str + i);
+        scan->valid = 1;
+    }
+#else
+    (void)scan;
+#endif
+
+    while (i < len && !is_special(str[i]))
+    {
+        i++;
+    }
+    return i;
+}
+
+/**
+ * Append decoded bytes to the current pair.
+ *
+ * @param form: The parser.
+ * @param str: The bytes.
+ * @param len: The number of bytes.
+ *
+ * @return: 0 on success, otherwise -1 if the pair does not fit the buffer.
+ */
+static inline int put(struct yuarel_form *form, const char *str, size_t len)
+{
+    /* Keep room for the null terminator of the value */
+    if (len >= form->size - form->len)
+    {
+        form->error = 1;
+        return -1;
+    }
+    if (len > 16)
+    {
+        memcpy(form->buf + form->len, str, len);
+    }
+    else
+    {
+        /* Runs between escapes are short, a call costs more than the copy */
+        char *out = form->buf + form->len;
+        size_t i;
+
+        for (i = 0; i < len; i++)
+        {
+            out[i] = str[i];
+        }
+    }
+    form->len += len;
+    return 0;
+}
+
+/**
+ * Write out a '%' that did not start a valid escape, and the hex digit that
+ * followed it, if any.
+ *
+ * @param form: The parser.
+ *
+ * @return: 0 on success, otherwise -1 if the pair does not fit the buffer.
+ */
+static int put_escape(struct yuarel_form *form)
+{
+    int digit = (2 == form->escape);
+
+    form->escape = 0;
+    if (-1 == put(form, "%", 1))
+    {
+        return -1;
+    }
+    return digit ? put(form, &form->escape_hi, 1) : 0;
+}
+
+/**
+ * Pass the current pair to the callback and start the next one.
+ *
+ * @param form: The parser.
+ *
+ * @return: 0 on success, otherwise -1 if there are too many pairs or the
+ *          callback stopped the parser.
+ */
+static int end_pair(struct yuarel_form *form)
+{
+    const char *value = NULL;
+    size_t key_len = form->len;
+    size_t value_len = 0;
+
+    /* Skip empty pairs, as between "&&" */
+    if (0 == form->len && !form->in_value)
+    {
+        return 0;
+    }
+
+    if (form->max_pairs && form->pairs == form->max_pairs)
+    {
+        form->error = 1;
+        return -1;
+    }
+
+    form->buf[form->len] = '\0';
+    if (form->in_value)
+    {
+        key_len = form->key_len;
+        value = form->buf + key_len + 1;
+        value_len = form->len - key_len - 1;
+    }
+    form->len = 0;
+    form->in_value = 0;
+
+    if (0 != form->callback(form->arg, form->buf, key_len, value, value_len))
+    {
+        form->error = 1;
+        return -1;
+    }
+    form->pairs++;
+    return 0;
+}
+
+/**
+ * @brief Initialize a form parser for a new body.
+ *
+ * The callback is called once per pair, with the key and value decoded like
+ * yuarel_url_decode() and null terminated. The value is NULL for a key without
+ * '=', as with yuarel_parse_query(). Empty pairs, e.g. between "&&", are
+ * skipped. The key and value are only valid during the call. A non-zero
+ * return value stops the parser.
+ *
+ * @param[out] form The parser to initialize.
+ * @param[in] buf The buffer to decode each pair into. It has to hold the
+ *                largest decoded key and value, plus two null terminators.
+ * @param[in] size The size of `buf`.
+ * @param[in] max_pairs The largest number of pairs to accept, 0 for no limit.
+ * @param[in] callback The function to pass each pair to.
+ * @param[in] arg The first argument of `callback`.
+ *
+ * @return 0 on success, otherwise -1 on error.
+ */
+int yuarel_form_init(struct yuarel_form *form, char *buf, size_t size, size_t max_pairs,
+                     int (*callback)(void *arg, const char *key, size_t key_len, const char *value, size_t value_len),
+                     void *arg)
+{
+    if (NULL == form || NULL == buf || size < 2 || NULL == callback)
+    {
+        return -1;
+    }
+
+    memset(form, 0, sizeof(struct yuarel_form));
+    form->callback = callback;
+    form->arg = arg;
+    form->buf = buf;
+    form->size = size;
+    form->max_pairs = max_pairs;
+    return 0;
+}
+
+/**
+ * @brief Feed the next chunk of a body to a form parser.
+ *
+ * The chunk is not modified or kept. Every pair that ends in the chunk is
+ * passed to the callback before this function returns.
+ *
+ * @param[in,out] form The parser.
+ * @param[in] chunk The next bytes of the body.
+ * @param[in] len The number of bytes in `chunk`.
+ *
+ * @return 0 on success, otherwise -1 if a pair does not fit the buffer, the
+ *         body has more than `max_pairs` pairs, or the callback stopped the
+ *         parser. After an error every further call fails until the parser
+ *         is initialized again.
+ */
+int yuarel_form_feed(struct yuarel_form *form, const char *chunk, size_t len)
+{
+    struct form_scan scan;
+    size_t i = 0;
+
+    if (NULL == form || form->error || (NULL == chunk && len))
+    {
+        return -1;
+    }
+
+    scan.valid = 0;
+#ifdef YUAREL_X86
+    scan.sse2 = yuarel_simd_level() >= YUAREL_ISA_SSE2;
+#endif
+    while (i < len)
+    {
+        size_t run;
+        char c;
+
+        /* An escape split between chunks, or a '%' that starts none */
+        if (form->escape)
+        {
+            int hi = (2 == form->escape) ? hex_value(form->escape_hi) : -1;
+            int lo = hex_value(chunk[i]);
+
+            if (lo < 0)
+            {
+                if (-1 == put_escape(form))
+                {
+                    return -1;
+                }
+                /* The byte is not part of the escape, look at it again */
+                continue;
+            }
+            i++;
+            if (1 == form->escape)
+            {
+                form->escape_hi = chunk[i - 1];
+                form->escape = 2;
+                continue;
+            }
+            c = (char)(hi << 4 | lo);
+            form->escape = 0;
+            if (-1 == put(form, &c, 1))
+            {
+                return -1;
+            }
+            continue;
+        }
+
+        run = next_special(chunk, len, i, &scan) - i;
+        if (run > 0)
+        {
+            if (-1 == put(form, chunk + i, run))
+            {
+                return -1;
+            }
+            i += run;
+            if (i == len)
+            {
+                break;
+            }
+        }
+
+        c = chunk[i++];
+        switch (c)
+        {
+            case '%':
+                /* Decode escapes within the chunk directly */
+                if (i + 1 < len && hex_value(chunk[i]) >= 0 && hex_value(chunk[i + 1]) >= 0)
+                {
+                    c = (char)(hex_value(chunk[i]) << 4 | hex_value(chunk[i + 1]));
+                    i += 2;
+                    if (-1 == put(form, &c, 1))
+                    {
+                        return -1;
+                    }
+                }
+                else
+                {
+                    form->escape = 1;
+                }
+                break;
+
+            case '+':
+                c = ' ';
+                if (-1 == put(form, &c, 1))
+                {
+                    return -1;
+                }
+                break;
+
+            case '=':
+                /* Only the first '=' separates the key from the value */
+                if (!form->in_value)
+                {
+                    c = '\0';
+                    form->key_len = form->len;
+                    form->in_value = 1;
+                }
+                if (-1 == put(form, &c, 1))
+                {
+                    return -1;
+                }
+                break;
+
+            default:
+                if (-1 == end_pair(form))
+                {
+                    return -1;
+                }
+                break;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Signal the end of a body and pass the last pair to the callback.
+ *
+ * @param[in,out] form The parser.
+ *
+ * @return The number of pairs in the body, otherwise -1 on error.
+ */
+long yuarel_form_finish(struct yuarel_form *form)
+{
+    if (NULL == form || form->error)
+    {
+        return -1;
+    }
+
+    if ((form->escape && -1 == put_escape(form)) || -1 == end_pair(form))
+    {
+        return -1;
+    }
+    return (long)form->pairs;
+}
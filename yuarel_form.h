@@ -0,0 +1,121 @@
+/**
+ * @file yuarel_form.h
+ * @brief Streaming parser for application/x-www-form-urlencoded bodies.
+ *
+ * Form bodies use the same "key=value&key=value" syntax as query strings, but
+ * can be many megabytes long and arrive in chunks. The form parser keeps its
+ * state between calls, so the body is never buffered as a whole. Each pair is
+ * percent-decoded into a buffer provided by the caller, also when a key, value
+ * or "%XX" escape is split between chunks, and is passed to a callback once
+ * its end has been seen.
+ *
+ * @copyright Copyright (C) 2016 Jack Engqvist Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef INC_YUAREL_FORM_H
+#define INC_YUAREL_FORM_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @struct yuarel_form
+ * @brief State of a streaming form parser.
+ *
+ * The public members may be read at any time.
+ */
+struct yuarel_form
+{
+    size_t pairs; /**< @brief Number of pairs passed to the callback so far */
+
+    /* Private parser state */
+    int (*callback)(void *arg, const char *key, size_t key_len, const char *value, size_t value_len);
+    void *arg;
+    char *buf;
+    size_t size;
+    size_t max_pairs;
+    size_t len;
+    size_t key_len;
+    int in_value;
+    int escape;
+    char escape_hi;
+    int error;
+};
+
+/**
+ * @brief Initialize a form parser for a new body.
+ *
+ * The callback is called once per pair, with the key and value decoded like
+ * yuarel_url_decode() and null terminated. The value is NULL for a key without
+ * '=', as with yuarel_parse_query(). Empty pairs, e.g. between "&&", are
+ * skipped. The key and value are only valid during the call. A non-zero
+ * return value stops the parser.
+ *
+ * @param[out] form The parser to initialize.
+ * @param[in] buf The buffer to decode each pair into. It has to hold the
+ *                largest decoded key and value, plus two null terminators.
+ * @param[in] size The size of `buf`.
+ * @param[in] max_pairs The largest number of pairs to accept, 0 for no limit.
+ * @param[in] callback The function to pass each pair to.
+ * @param[in] arg The first argument of `callback`.
+ *
+ * @return 0 on success, otherwise -1 on error.
+ */
+extern int yuarel_form_init(struct yuarel_form *form, char *buf, size_t size, size_t max_pairs,
+                            int (*callback)(void *arg, const char *key, size_t key_len, const char *value,
+                                            size_t value_len),
+                            void *arg);
+
+/**
+ * @brief Feed the next chunk of a body to a form parser.
+ *
+ * The chunk is not modified or kept. Every pair that ends in the chunk is
+ * passed to the callback before this function returns.
+ *
+ * @param[in,out] form The parser.
+ * @param[in] chunk The next bytes of the body.
+ * @param[in] len The number of bytes in `chunk`.
+ *
+ * @return 0 on success, otherwise -1 if a pair does not fit the buffer, the
+ *         body has more than `max_pairs` pairs, or the callback stopped the
+ *         parser. After an error every further call fails until the parser
+ *         is initialized again.
+ */
+extern int yuarel_form_feed(struct yuarel_form *form, const char *chunk, size_t len);
+
+/**
+ * @brief Signal the end of a body and pass the last pair to the callback.
+ *
+ * @param[in,out] form The parser.
+ *
+ * @return The number of pairs in the body, otherwise -1 on error.
+ */
+extern long yuarel_form_finish(struct yuarel_form *form);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_YUAREL_FORM_H */
@@ -0,0 +1,454 @@
+/**
+ * Copyright (C) 2016,2017 Jack Engqvist Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "yuarel_http.h"
+#include "yuarel_internal.h"
+#include <string.h>
+
+#ifdef YUAREL_X86
+#include <immintrin.h>
+#endif
+
+/* Marks a delimiter that was not found */
+#define NONE ((size_t)-1)
+
+/**
+ * Check if a byte is allowed in a method token (RFC 9110 tchar).
+ *
+ * @param c: The byte to check.
+ *
+ * @return: 1 if allowed, otherwise 0.
+ */
+static inline int is_tchar(char c)
+{
+    if (('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z') || ('0' <= c && c <= '9'))
+    {
+        return 1;
+    }
+    return '\0' != c && NULL != strchr("!#$%&'*+-.^_`|~", c);
+}
+
+/**
+ * Check if a byte ends the request target, i.e. is a space, a control
+ * character or DEL.
+ *
+ * @param c: The byte to check.
+ *
+ * @return: 1 if the target ends at this byte, otherwise 0.
+ */
+static inline int is_target_stop(char c)
+{
+    return (unsigned char)c <= ' ' || 0x7f == c;
+}
+
+/**
+ * Find the end of a request target from an offset on, and the first '?' and
+ * '#' before it that were not found yet.
+ *
+ * @param str: The start of the target.
+ * @param len: The number of bytes available.
+ * @param i: The offset to scan from.
+ * @param query: The offset of the first '?', or NONE, set if found.
+ * @param fragment: The offset of the first '#', or NONE, set if found.
+ *
+ * @return: The offset of the first byte that ends the target, or `len`.
+ */
+static inline __attribute__((always_inline)) size_t scan_target_from(const char *str, size_t len, size_t i,
+                                                                      size_t *query, size_t *fragment)
+{
+    for (; i < len; i++)
+    {
+        char c = str[i];
+
+        if (is_target_stop(c))
+        {
+            return i;
+        }
+        if ('?' == c && NONE == *query)
+        {
+            *query = i;
+        }
+        else if ('#' == c && NONE == *fragment)
+        {
+            *fragment = i;
+        }
+    }
+
+    return len;
+}
+
+#ifdef YUAREL_X86
+/**
+ * Find the end of a request target, and the first '?' and '#' before it,
+ * comparing 16 bytes at a time.
+ *
+ * @param str: The start of the target.
+ * @param len: The number of bytes available.
+ * @param query: Set to the offset of the first '?', or NONE.
+ * @param fragment: Set to the offset of the first '#', or NONE.
+ *
+ * @return: The offset of the first byte that ends the target, or `len`.
+ */
+static __attribute__((target("sse2"))) size_t scan_target_sse2(const char *str, size_t len, size_t *query,
+                                                               size_t *fragment)
+{
+    const __m128i space = _mm_set1_epi8(' ');
+    const __m128i del = _mm_set1_epi8(0x7f);
+    const __m128i qmark = _mm_set1_epi8('?');
+    const __m128i hash = _mm_set1_epi8('#');
+    size_t i;
+
+    for (i = 0; i + 16 <= len; i += 16)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i *)(str + i));
+        /* c <= ' ' unsigned, is max(c, ' ') == ' ' */
+        __m128i low = _mm_cmpeq_epi8(_mm_max_epu8(v, space), space);
+        int stop = _mm_movemask_epi8(_mm_or_si128(low, _mm_cmpeq_epi8(v, del)));
+        int q = _mm_movemask_epi8(_mm_cmpeq_epi8(v, qmark));
+        int h = _mm_movemask_epi8(_mm_cmpeq_epi8(v, hash));
+
+        if (stop)
+        {
+            /* Only delimiters before the end of the target count */
+            int before = (stop & -stop) - 1;
+            q &= before;
+            h &= before;
+        }
+        if (NONE == *query && q)
+        {
+            *query = i + __builtin_ctz(q);
+        }
+        if (NONE == *fragment && h)
+        {
+            *fragment = i + __builtin_ctz(h);
+        }
+        if (stop)
+        {
+            return i + __builtin_ctz(stop);
+        }
+    }
+
+    return scan_target_from(str, len, i, query, fragment);
+}
+#endif
+
+/**
+ * Find the end of a request target, and the first '?' and '#' before it.
+ *
+ * @param str: The start of the target.
+ * @param len: The number of bytes available.
+ * @param query: Set to the offset of the first '?', or NONE.
+ * @param fragment: Set to the offset of the first '#', or NONE.
+ *
+ * @return: The offset of the first byte that ends the target, or `len`.
+ */
+static size_t scan_target(const char *str, size_t len, size_t *query, size_t *fragment)
+{
+    *query = NONE;
+    *fragment = NONE;
+
+#ifdef YUAREL_X86
+    /* Less than a block skips the kernel lookup */
+    if (len >= 16 && yuarel_simd_level() >= YUAREL_ISA_SSE2)
+    {
+        return scan_target_sse2(str, len, query, fragment);
+    }
+#endif
+    return scan_target_from(str, len, 0, query, fragment);
+}
+
+/**
+ * Parse a null terminated "host[:port]" string, as found in the Host header
+ * and in authority form targets, into the host and port of a URL.
+ *
+ * @param url: The URL to set the host and port of.
+ * @param str: The string to parse. It will be modified.
+ *
+ * @return: 0 on success, otherwise -1 on error.
+ */
+static int parse_host_port(struct yuarel *url, char *str)
+{
+    char *port;
+    int value = 0;
+
+    if ('[' == *str)
+    {
+        /* IPv6 literal, only a port may follow */
+        char *close = strchr(str, ']');
+        if (NULL == close || close == str + 1 || (':' != close[1] && '\0' != close[1]))
+        {
+            return -1;
+        }
+        *close = '\0';
+        url->host = str + 1;
+        port = (':' == close[1]) ? close + 2 : NULL;
+    }
+    else
+    {
+        port = strchr(str, ':');
+        if (NULL != port)
+        {
+            *port++ = '\0';
+        }
+        if ('\0' == *str)
+        {
+            return -1;
+        }
+        url->host = str;
+    }
+
+    if (NULL != port)
+    {
+        if ('\0' == *port)
+        {
+            /* Missing port */
+            return -1;
+        }
+        for (; '\0' != *port; port++)
+        {
+            if (*port < '0' || *port > '9' || value > 65535)
+            {
+                return -1;
+            }
+            value = value * 10 + (*port - '0');
+        }
+        if (value > 65535)
+        {
+            return -1;
+        }
+        url->port = value;
+    }
+
+    return 0;
+}
+
+/**
+ * Split the query and fragment off a target, using the delimiters found while
+ * scanning it.
+ *
+ * @param url: The URL to fill in.
+ * @param target: The target, null terminated.
+ * @param query: The offset of the first '?', or NONE.
+ * @param fragment: The offset of the first '#', or NONE.
+ */
+static void split_query_fragment(struct yuarel *url, char *target, size_t query, size_t fragment)
+{
+    if (NONE != fragment)
+    {
+        target[fragment] = '\0';
+        url->fragment = target + fragment + 1;
+        if (query > fragment)
+        {
+            /* A '?' in the fragment does not start a query */
+            query = NONE;
+        }
+    }
+
+    if (NONE != query)
+    {
+        target[query] = '\0';
+        url->query = target + query + 1;
+    }
+}
+
+/**
+ * Split an absolute form target, using the delimiters found while scanning
+ * it. Only the scheme and authority are parsed with yuarel_parse(), the path,
+ * query and fragment are cut at the offsets that are already known.
+ *
+ * @param url: The URL to fill in.
+ * @param target: The target, null terminated.
+ * @param len: The length of the target.
+ * @param query: The offset of the first '?', or NONE.
+ * @param fragment: The offset of the first '#', or NONE.
+ *
+ * @return: 0 on success, otherwise -1 if the target has no scheme and host.
+ */
+static int split_absolute(struct yuarel *url, char *target, size_t len, size_t query, size_t fragment)
+{
+    size_t end = len;
+    char *colon;
+    char *slash;
+    size_t auth;
+
+    /* The authority ends at the path, query or fragment */
+    if (query < end)
+    {
+        end = query;
+    }
+    if (fragment < end)
+    {
+        end = fragment;
+    }
+
+    colon = memchr(target, ':', end);
+    if (NULL == colon || (size_t)(colon - target) + 3 > end || '/' != colon[1] || '/' != colon[2])
+    {
+        return -1;
+    }
+    auth = (size_t)(colon - target) + 3;
+    slash = memchr(target + auth, '/', end - auth);
+
+    /* Parse "scheme://authority" on its own, as yuarel_parse() cuts it off the path */
+    if (NULL != slash)
+    {
+        *slash = '\0';
+    }
+    else if (end < len)
+    {
+        target[end] = '\0';
+    }
+    if (-1 == yuarel_parse(url, target) || NULL == url->host)
+    {
+        return -1;
+    }
+
+    url->path = (NULL != slash) ? slash + 1 : NULL;
+    split_query_fragment(url, target, query, fragment);
+    return 0;
+}
+
+/**
+ * @brief Parse an HTTP/1.x request line.
+ *
+ * The line ends at "\r\n", "\n" or the end of the buffer. The method and the
+ * target components are null terminated in place, nothing is written past the
+ * line. The bytes of the target are checked for spaces and control characters
+ * 16 at a time unless yuarel_simd_kernel() is "scalar".
+ *
+ * For origin and asterisk form targets, the host and port are taken from
+ * `host_header` when given. The header value is modified the same way as the
+ * URL string. For authority form targets only the host and port are set.
+ *
+ * @warning: Modifies the input buffer as part of the parsing process.
+ *
+ * @param[out] req Where to store the parsed request line.
+ * @param[in,out] buf The buffer holding the request line. It will be modified.
+ * @param[in] len The number of bytes in `buf`.
+ * @param[in,out] host_header The value of the Host header, or NULL.
+ *
+ * @return The number of bytes consumed, including the line ending, or -1 on error.
+ */
+long yuarel_parse_request_line(struct yuarel_request *req, char *buf, size_t len, char *host_header)
+{
+    char *target;
+    size_t method_len = 0;
+    size_t target_len;
+    size_t query, fragment;
+    size_t pos;
+
+    if (NULL == req || NULL == buf)
+    {
+        return -1;
+    }
+
+    memset(req, 0, sizeof(struct yuarel_request));
+
+    /* Method */
+    while (method_len < len && is_tchar(buf[method_len]))
+    {
+        method_len++;
+    }
+    if (0 == method_len || method_len == len || ' ' != buf[method_len])
+    {
+        return -1;
+    }
+    buf[method_len] = '\0';
+    req->method = buf;
+
+    /* Request target */
+    target = buf + method_len + 1;
+    pos = method_len + 1;
+    target_len = scan_target(target, len - pos, &query, &fragment);
+    if (0 == target_len || pos + target_len == len || ' ' != target[target_len])
+    {
+        return -1;
+    }
+    target[target_len] = '\0';
+    pos += target_len + 1;
+
+    /* Version, "HTTP/" DIGIT "." DIGIT */
+    if (len - pos < 8 || 0 != memcmp(buf + pos, "HTTP/", 5) || '.' != buf[pos + 6] ||
+        buf[pos + 5] < '0' || buf[pos + 5] > '9' || buf[pos + 7] < '0' || buf[pos + 7] > '9')
+    {
+        return -1;
+    }
+    req->version_major = buf[pos + 5] - '0';
+    req->version_minor = buf[pos + 7] - '0';
+    pos += 8;
+
+    /* Line ending, or the end of the buffer */
+    if (pos < len)
+    {
+        if ('\r' == buf[pos] && pos + 1 < len && '\n' == buf[pos + 1])
+        {
+            pos += 2;
+        }
+        else if ('\n' == buf[pos])
+        {
+            pos++;
+        }
+        else
+        {
+            return -1;
+        }
+    }
+
+    if ('/' == *target)
+    {
+        req->form = YUAREL_TARGET_ORIGIN;
+        req->url.path = target + 1;
+        split_query_fragment(&req->url, target, query, fragment);
+    }
+    else if (1 == target_len && '*' == *target)
+    {
+        req->form = YUAREL_TARGET_ASTERISK;
+    }
+    else if (0 == strcmp(req->method, "CONNECT"))
+    {
+        req->form = YUAREL_TARGET_AUTHORITY;
+        if (-1 == parse_host_port(&req->url, target) || 0 == req->url.port)
+        {
+            return -1;
+        }
+        return (long)pos;
+    }
+    else
+    {
+        req->form = YUAREL_TARGET_ABSOLUTE;
+        if (-1 == split_absolute(&req->url, target, target_len, query, fragment))
+        {
+            return -1;
+        }
+        return (long)pos;
+    }
+
+    /* Origin and asterisk forms take the authority from the Host header */
+    if (NULL != host_header && '\0' != *host_header)
+    {
+        if (-1 == parse_host_port(&req->url, host_header))
+        {
+            return -1;
+        }
+    }
+
+    return (long)pos;
+}
@@ -0,0 +1,98 @@
+/**
+ * @file yuarel_http.h
+ * @brief Zero-copy HTTP/1.x request-line parsing.
+ *
+ * Splits a request line such as `GET /path?x=1 HTTP/1.1` into method, request
+ * target and version in one pass, and parses the target directly into a
+ * `yuarel` struct. All four request-target forms of RFC 9112 are handled:
+ *
+ *  - origin form:    `GET /index.html?q=1 HTTP/1.1`
+ *  - absolute form:  `GET http://example.com/index.html HTTP/1.1`
+ *  - authority form: `CONNECT example.com:443 HTTP/1.1`
+ *  - asterisk form:  `OPTIONS * HTTP/1.1`
+ *
+ * @copyright Copyright (C) 2016 Jack Engqvist Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef INC_YUAREL_HTTP_H
+#define INC_YUAREL_HTTP_H
+
+#include "yuarel.h"
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @enum yuarel_target_form
+ * @brief The form of an HTTP request target.
+ */
+enum yuarel_target_form
+{
+    YUAREL_TARGET_ORIGIN,    /**< @brief `/path?query` */
+    YUAREL_TARGET_ABSOLUTE,  /**< @brief `scheme://host/path?query` */
+    YUAREL_TARGET_AUTHORITY, /**< @brief `host:port`, for CONNECT */
+    YUAREL_TARGET_ASTERISK   /**< @brief `*`, for OPTIONS */
+};
+
+/**
+ * @struct yuarel_request
+ * @brief Structure that stores a parsed HTTP request line.
+ */
+struct yuarel_request
+{
+    char *method;      /**< @brief Request method, e.g. "GET" */
+    int form;          /**< @brief One of the yuarel_target_form values */
+    int version_major; /**< @brief Major HTTP version */
+    int version_minor; /**< @brief Minor HTTP version */
+    struct yuarel url; /**< @brief The parsed request target */
+};
+
+/**
+ * @brief Parse an HTTP/1.x request line.
+ *
+ * The line ends at "\r\n", "\n" or the end of the buffer. The method and the
+ * target components are null terminated in place, nothing is written past the
+ * line. The bytes of the target are checked for spaces and control characters
+ * 16 at a time unless yuarel_simd_kernel() is "scalar".
+ *
+ * For origin and asterisk form targets, the host and port are taken from
+ * `host_header` when given. The header value is modified the same way as the
+ * URL string. For authority form targets only the host and port are set.
+ *
+ * @warning: Modifies the input buffer as part of the parsing process.
+ *
+ * @param[out] req Where to store the parsed request line.
+ * @param[in,out] buf The buffer holding the request line. It will be modified.
+ * @param[in] len The number of bytes in `buf`.
+ * @param[in,out] host_header The value of the Host header, or NULL.
+ *
+ * @return The number of bytes consumed, including the line ending, or -1 on error.
+ */
+extern long yuarel_parse_request_line(struct yuarel_request *req, char *buf, size_t len, char *host_header);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_YUAREL_HTTP_H */
@@ -0,0 +1,86 @@
+/**
+ * @file yuarel_idna.h
+ * @brief Offline conversion of internationalized hostnames.
+ *
+ * Converts hostnames between their Unicode form and their ASCII form with
+ * Punycode "xn--" labels (RFC 3492, RFC 5891), so that equal hosts compare
+ * equal whichever form they arrived in. The mapping and normalization tables
+ * are compiled in, nothing is loaded at run time.
+ *
+ * @copyright Copyright (C) 2016 Jack Engqvist Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef INC_YUAREL_IDNA_H
+#define INC_YUAREL_IDNA_H
+
+#include "yuarel.h"
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief Convert a hostname to its ASCII form.
+ *
+ * Every label is mapped to lowercase, with full-width characters replaced by
+ * their ASCII forms and default ignorable characters removed, and normalized
+ * to NFC: decomposed, with combining marks in canonical order, and composed
+ * again, Hangul syllables included. Labels that are then not pure ASCII are
+ * Punycode encoded with an "xn--" prefix. Pure ASCII labels are only
+ * lowercased. "xn--" labels in the input are checked to decode to a mapped
+ * label in NFC.
+ *
+ * U+3002, U+FF0E and U+FF61 separate labels like '.'.
+ *
+ * @param[in] host The null terminated hostname, in UTF-8.
+ * @param[out] buf Where to write the result. May be NULL if `size` is 0.
+ * @param[in] size The size of `buf`.
+ *
+ * @return The length of the result, or -1 if the hostname is invalid. Like
+ *         snprintf(), the result is truncated to fit `size`.
+ */
+extern long yuarel_host_to_ascii(const char *host, char *buf, size_t size);
+
+/**
+ * @brief Convert a hostname to its Unicode form.
+ *
+ * "xn--" labels are Punycode decoded to UTF-8. Other labels are mapped the
+ * same way as by yuarel_host_to_ascii(). Hosts that only differ in case,
+ * full-width forms, ignorable characters or canonically equivalent sequences
+ * give the same result whichever form they are given in. Other mappings of
+ * UTS #46, e.g. of compatibility characters, are not applied.
+ *
+ * @param[in] host The null terminated hostname, in UTF-8.
+ * @param[out] buf Where to write the result. May be NULL if `size` is 0.
+ * @param[in] size The size of `buf`.
+ *
+ * @return The length of the result, or -1 if the hostname is invalid. Like
+ *         snprintf(), the result is truncated to fit `size`.
+ */
+extern long yuarel_host_to_unicode(const char *host, char *buf, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_YUAREL_IDNA_H */
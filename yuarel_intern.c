@@ -0,0 +1,685 @@
+/**
+ * Copyright (C) 2016,2017 Jack Engqvist Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "yuarel_intern.h"
+#include "yuarel_internal.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_PIECES 10
+
+struct yuarel_intern_entry
+{
+    const char *str;
+    uint32_t len;
+    int field;
+    uint64_t hash;
+    /* For URLs, the IDs of the host and the path, and the next URLs in their lists */
+    uint32_t host;
+    uint32_t path;
+    uint32_t next_host;
+    uint32_t next_path;
+    /* For hosts and paths, the most recently added URL with them */
+    uint32_t head;
+    /* Stored once the entry is in a slot, YUAREL_INTERN_NONE until then */
+    uint32_t id;
+};
+
+/* A canonical key, as pieces of the parsed URL */
+struct intern_key
+{
+    int field;
+    int count;
+    const char *str[MAX_PIECES];
+    size_t len[MAX_PIECES];
+    int lower[MAX_PIECES];
+    size_t total;
+    char port[8];
+};
+
+/**
+ * Append a piece to a key.
+ *
+ * @param key: The key.
+ * @param str: The piece.
+ * @param len: The length of the piece.
+ * @param lower: 1 if the piece is compared and stored lowercased.
+ */
+static void key_add(struct intern_key *key, const char *str, size_t len, int lower)
+{
+    key->str[key->count] = str;
+    key->len[key->count] = len;
+    key->lower[key->count] = lower;
+    key->count++;
+    key->total += len;
+}
+
+/**
+ * Build the canonical key of a URL or a component.
+ *
+ * @param key: The key to build.
+ * @param url: The parsed URL.
+ * @param field: YUAREL_FIELD_ALL, YUAREL_FIELD_HOST or YUAREL_FIELD_PATH.
+ *
+ * @return: 0 on success, or -1 if the URL has no such component.
+ */
+static int key_init(struct intern_key *key, const struct yuarel *url, int field)
+{
+    const char *path = (NULL != url->path) ? url->path : "";
+
+    key->field = field;
+    key->count = 0;
+    key->total = 0;
+
+    if (YUAREL_FIELD_HOST == field)
+    {
+        if (NULL == url->host)
+        {
+            return -1;
+        }
+        key_add(key, url->host, strlen(url->host), 1);
+        return 0;
+    }
+
+    if (YUAREL_FIELD_ALL == field && NULL != url->scheme)
+    {
+        key_add(key, url->scheme, strlen(url->scheme), 1);
+        key_add(key, "://", 3, 0);
+    }
+    if (YUAREL_FIELD_ALL == field && NULL != url->host)
+    {
+        /* yuarel_parse() drops the brackets, they keep the port apart */
+        int ipv6 = NULL != strchr(url->host, ':');
+
+        if (ipv6)
+        {
+            key_add(key, "[", 1, 0);
+        }
+        key_add(key, url->host, strlen(url->host), 1);
+        if (ipv6)
+        {
+            key_add(key, "]", 1, 0);
+        }
+        if (0 != url->port)
+        {
+            int port = url->port;
+            int i = sizeof(key->port);
+
+            do
+            {
+                key->port[--i] = (char)('0' + port % 10);
+                port /= 10;
+            } while (0 != port && i > 1);
+            key->port[--i] = ':';
+            key_add(key, key->port + i, sizeof(key->port) - i, 0);
+        }
+    }
+    if (YUAREL_FIELD_ALL != field && YUAREL_FIELD_PATH != field)
+    {
+        return -1;
+    }
+
+    key_add(key, "/", 1, 0);
+    key_add(key, path, strlen(path), 0);
+    if (YUAREL_FIELD_ALL == field && NULL != url->query)
+    {
+        key_add(key, "?", 1, 0);
+        key_add(key, url->query, strlen(url->query), 0);
+    }
+    return 0;
+}
+
+/**
+ * Hash a key, with 64 bit FNV-1a and a final mix so that both the low bits,
+ * used for the slot, and the high bits, used as the tag, are well spread.
+ *
+ * @param key: The key.
+ *
+ * @return: The hash.
+ */
+static uint64_t key_hash(const struct intern_key *key)
+{
+    uint64_t hash = 14695981039346656037u ^ (uint64_t)key->field;
+    int k;
+
+    for (k = 0; k < key->count; k++)
+    {
+        const unsigned char *str = (const unsigned char *)key->str[k];
+        size_t i;
+
+        for (i = 0; i < key->len[k]; i++)
+        {
+            hash ^= key->lower[k] ? to_lower(str[i]) : str[i];
+            hash *= 1099511628211u;
+        }
+    }
+
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdu;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53u;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+/**
+ * Compare a key to an interned entry.
+ *
+ * @param key: The key.
+ * @param hash: The hash of the key.
+ * @param entry: The entry.
+ *
+ * @return: 1 if they are equal, otherwise 0.
+ */
+static int key_equals(const struct intern_key *key, uint64_t hash, const struct yuarel_intern_entry *entry)
+{
+    const unsigned char *str = (const unsigned char *)entry->str;
+    int k;
+
+    if (hash != entry->hash || key->field != entry->field || key->total != entry->len)
+    {
+        return 0;
+    }
+
+    for (k = 0; k < key->count; k++)
+    {
+        const unsigned char *piece = (const unsigned char *)key->str[k];
+        size_t i;
+
+        if (!key->lower[k])
+        {
+            if (0 != memcmp(str, piece, key->len[k]))
+            {
+                return 0;
+            }
+        }
+        else
+        {
+            for (i = 0; i < key->len[k]; i++)
+            {
+                if (str[i] != to_lower(piece[i]))
+                {
+                    return 0;
+                }
+            }
+        }
+        str += key->len[k];
+    }
+    return 1;
+}
+
+/**
+ * Copy the canonical form of a key into an arena.
+ *
+ * @param key: The key.
+ * @param arena: The arena.
+ *
+ * @return: The null terminated copy, or NULL if out of memory.
+ */
+static char *key_copy(const struct intern_key *key, struct yuarel_arena *arena)
+{
+    char *copy = yuarel_arena_alloc(arena, key->total + 1);
+    char *out = copy;
+    int k;
+
+    if (NULL == copy)
+    {
+        return NULL;
+    }
+
+    for (k = 0; k < key->count; k++)
+    {
+        size_t i;
+
+        if (key->lower[k])
+        {
+            for (i = 0; i < key->len[k]; i++)
+            {
+                out[i] = (char)to_lower((unsigned char)key->str[k][i]);
+            }
+        }
+        else if (0 != key->len[k])
+        {
+            memcpy(out, key->str[k], key->len[k]);
+        }
+        out += key->len[k];
+    }
+    *out = '\0';
+    return copy;
+}
+
+/**
+ * Get the ID of the entry of a slot if it holds a key. The thread that put
+ * the entry in the slot stores its ID right after, wait for that if needed.
+ *
+ * @param entry: The entry of the slot.
+ * @param key: The key.
+ * @param hash: The hash of the key.
+ *
+ * @return: The ID, or YUAREL_INTERN_NONE if the slot holds another key.
+ */
+static uint32_t match_slot(const struct yuarel_intern_entry *entry, const struct intern_key *key, uint64_t hash)
+{
+    uint32_t id;
+
+    if (!key_equals(key, hash, entry))
+    {
+        return YUAREL_INTERN_NONE;
+    }
+    do
+    {
+        id = __atomic_load_n(&entry->id, __ATOMIC_ACQUIRE);
+    } while (YUAREL_INTERN_NONE == id);
+    return id;
+}
+
+/**
+ * Get the entry of an ID.
+ *
+ * @param table: The table.
+ * @param id: The ID.
+ *
+ * @return: The entry, or NULL if the ID was not handed out.
+ */
+static const struct yuarel_intern_entry *entry_of(const struct yuarel_intern *table, uint32_t id)
+{
+    const struct yuarel_intern_entry *entry;
+
+    if (id >= yuarel_intern_count(table))
+    {
+        return NULL;
+    }
+    /* The entry is stored right after its ID is taken */
+    do
+    {
+        entry = __atomic_load_n(&table->entries[id], __ATOMIC_ACQUIRE);
+    } while (NULL == entry);
+    return entry;
+}
+
+/**
+ * Find the ID of a key.
+ *
+ * @param table: The table.
+ * @param key: The key.
+ * @param hash: The hash of the key.
+ *
+ * @return: The ID, or YUAREL_INTERN_NONE if the key was not interned.
+ */
+static uint32_t find_key(const struct yuarel_intern *table, const struct intern_key *key, uint64_t hash)
+{
+    uint32_t i = (uint32_t)hash & table->mask;
+    uint32_t id;
+
+    for (;;)
+    {
+        const struct yuarel_intern_entry *entry = __atomic_load_n(&table->slots[i], __ATOMIC_ACQUIRE);
+
+        if (NULL == entry)
+        {
+            return YUAREL_INTERN_NONE;
+        }
+        id = match_slot(entry, key, hash);
+        if (YUAREL_INTERN_NONE != id)
+        {
+            return id;
+        }
+        i = (i + 1) & table->mask;
+    }
+}
+
+/**
+ * Push a URL onto the list of a host or a path.
+ *
+ * @param head: The head of the list.
+ * @param next: The link of the URL.
+ * @param id: The ID of the URL.
+ */
+static void push_url(uint32_t *head, uint32_t *next, uint32_t id)
+{
+    uint32_t old = __atomic_load_n(head, __ATOMIC_RELAXED);
+
+    do
+    {
+        *next = old;
+    } while (!__atomic_compare_exchange_n(head, &old, id, 1, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+}
+
+/**
+ * Insert a key, or find the ID it already has.
+ *
+ * The key is copied and its entry filled in, in the arena, before a slot is
+ * claimed for it with a single compare and swap, so other threads never see
+ * a partial entry. Only then is an ID taken and stored, so IDs stay dense:
+ * an entry dropped because another thread claimed a slot with the same key
+ * first, or an insert that ran out of memory, takes none. A place in the
+ * table is reserved up front, so that no more than `max_ids` slots are ever
+ * claimed.
+ *
+ * @param table: The table.
+ * @param arena: The arena to copy the key into.
+ * @param key: The key.
+ * @param hash: The hash of the key.
+ * @param host: For a URL, the ID of its host, otherwise YUAREL_INTERN_NONE.
+ * @param path: For a URL, the ID of its path, otherwise YUAREL_INTERN_NONE.
+ *
+ * @return: The ID, or YUAREL_INTERN_NONE if the table is full or out of memory.
+ */
+static uint32_t insert_key(struct yuarel_intern *table, struct yuarel_arena *arena, const struct intern_key *key,
+                           uint64_t hash, uint32_t host, uint32_t path)
+{
+    uint32_t i = (uint32_t)hash & table->mask;
+    struct yuarel_intern_entry *entry = NULL;
+    uint32_t id;
+
+    for (;;)
+    {
+        struct yuarel_intern_entry *value = __atomic_load_n(&table->slots[i], __ATOMIC_ACQUIRE);
+
+        if (NULL == value)
+        {
+            if (NULL == entry)
+            {
+                if (__atomic_load_n(&table->claimed, __ATOMIC_RELAXED) >= table->max_ids ||
+                    __atomic_fetch_add(&table->claimed, 1, __ATOMIC_RELAXED) >= table->max_ids)
+                {
+                    return YUAREL_INTERN_NONE;
+                }
+
+                entry = yuarel_arena_alloc(arena, sizeof(*entry));
+                if (NULL == entry || NULL == (entry->str = key_copy(key, arena)))
+                {
+                    __atomic_fetch_sub(&table->claimed, 1, __ATOMIC_RELAXED);
+                    return YUAREL_INTERN_NONE;
+                }
+                entry->len = (uint32_t)key->total;
+                entry->field = key->field;
+                entry->hash = hash;
+                entry->host = host;
+                entry->path = path;
+                entry->next_host = YUAREL_INTERN_NONE;
+                entry->next_path = YUAREL_INTERN_NONE;
+                entry->head = YUAREL_INTERN_NONE;
+                entry->id = YUAREL_INTERN_NONE;
+            }
+
+            if (__atomic_compare_exchange_n(&table->slots[i], &value, entry, 0, __ATOMIC_RELEASE,
+                                            __ATOMIC_ACQUIRE))
+            {
+                /* At most max_ids slots are ever claimed, so the ID fits */
+                id = __atomic_fetch_add(&table->next_id, 1, __ATOMIC_RELAXED);
+                __atomic_store_n(&table->entries[id], entry, __ATOMIC_RELEASE);
+                __atomic_store_n(&entry->id, id, __ATOMIC_RELEASE);
+                if (YUAREL_INTERN_NONE != host)
+                {
+                    push_url(&table->entries[host]->head, &entry->next_host, id);
+                }
+                if (YUAREL_INTERN_NONE != path)
+                {
+                    push_url(&table->entries[path]->head, &entry->next_path, id);
+                }
+                return id;
+            }
+            /* Another thread took the slot, look at what it holds */
+        }
+
+        id = match_slot(value, key, hash);
+        if (YUAREL_INTERN_NONE != id)
+        {
+            if (NULL != entry)
+            {
+                /* The entry prepared here is dropped, its place is given back */
+                __atomic_fetch_sub(&table->claimed, 1, __ATOMIC_RELAXED);
+            }
+            return id;
+        }
+        i = (i + 1) & table->mask;
+    }
+}
+
+/**
+ * @brief Initialize a table.
+ *
+ * @param[out] table The table to initialize.
+ * @param[in] max_ids The maximum number of IDs, at most YUAREL_INTERN_MAX_IDS.
+ *
+ * @return 0 on success, otherwise -1 on error.
+ */
+int yuarel_intern_init(struct yuarel_intern *table, uint32_t max_ids)
+{
+    uint32_t slots = 2;
+
+    if (NULL == table || 0 == max_ids || max_ids > YUAREL_INTERN_MAX_IDS)
+    {
+        return -1;
+    }
+
+    while (slots < 2 * max_ids)
+    {
+        slots *= 2;
+    }
+    table->slots = calloc(slots, sizeof(*table->slots));
+    table->entries = calloc(max_ids, sizeof(*table->entries));
+    if (NULL == table->slots || NULL == table->entries)
+    {
+        free(table->slots);
+        free(table->entries);
+        return -1;
+    }
+    table->mask = slots - 1;
+    table->max_ids = max_ids;
+    table->next_id = 0;
+    table->claimed = 0;
+    return 0;
+}
+
+/**
+ * @brief Free a table.
+ *
+ * The keys and their entries stay in the arenas they were built in.
+ *
+ * @param[in,out] table The table to free.
+ */
+void yuarel_intern_free(struct yuarel_intern *table)
+{
+    if (NULL == table)
+    {
+        return;
+    }
+    free(table->slots);
+    free(table->entries);
+    table->slots = NULL;
+    table->entries = NULL;
+    table->max_ids = 0;
+    table->next_id = 0;
+    table->claimed = 0;
+}
+
+/**
+ * @brief Intern a URL or one of its components.
+ *
+ * With `field` YUAREL_FIELD_ALL the whole URL is interned, together with its
+ * host and its path. With YUAREL_FIELD_HOST or YUAREL_FIELD_PATH only that
+ * component is. If the key is new, it is copied into `arena`, which must stay
+ * valid as long as the table is used. Use one arena per thread.
+ *
+ * Safe to call from several threads at once, without locks. If several
+ * threads add the same new key at once, they all get the ID of the first one
+ * to store it, and only wait for that thread to store the ID it took right
+ * after claiming the slot.
+ *
+ * @param[in,out] table The table.
+ * @param[in,out] arena The arena of the calling thread.
+ * @param[in] url The parsed URL.
+ * @param[in] field YUAREL_FIELD_ALL, YUAREL_FIELD_HOST or YUAREL_FIELD_PATH.
+ *
+ * @return The ID, or YUAREL_INTERN_NONE on error or if the table is full.
+ */
+uint32_t yuarel_intern_add(struct yuarel_intern *table, struct yuarel_arena *arena, const struct yuarel *url, int field)
+{
+    struct intern_key key;
+    uint32_t host = YUAREL_INTERN_NONE;
+    uint32_t path = YUAREL_INTERN_NONE;
+    uint32_t id;
+    uint64_t hash;
+
+    if (NULL == table || NULL == table->slots || NULL == arena || NULL == url || -1 == key_init(&key, url, field))
+    {
+        return YUAREL_INTERN_NONE;
+    }
+    hash = key_hash(&key);
+
+    if (YUAREL_FIELD_ALL == field)
+    {
+        /* Most URLs were seen before, skip the components for them */
+        id = find_key(table, &key, hash);
+        if (YUAREL_INTERN_NONE != id)
+        {
+            return id;
+        }
+        if (NULL != url->host)
+        {
+            host = yuarel_intern_add(table, arena, url, YUAREL_FIELD_HOST);
+        }
+        path = yuarel_intern_add(table, arena, url, YUAREL_FIELD_PATH);
+    }
+
+    return insert_key(table, arena, &key, hash, host, path);
+}
+
+/**
+ * @brief Look up the ID of a URL or one of its components, without adding it.
+ *
+ * Safe to call from several threads at once, and concurrently with
+ * yuarel_intern_add().
+ *
+ * @param[in] table The table.
+ * @param[in] url The parsed URL.
+ * @param[in] field YUAREL_FIELD_ALL, YUAREL_FIELD_HOST or YUAREL_FIELD_PATH.
+ *
+ * @return The ID, or YUAREL_INTERN_NONE if it was not interned.
+ */
+uint32_t yuarel_intern_find(const struct yuarel_intern *table, const struct yuarel *url, int field)
+{
+    struct intern_key key;
+
+    if (NULL == table || NULL == table->slots || NULL == url || -1 == key_init(&key, url, field))
+    {
+        return YUAREL_INTERN_NONE;
+    }
+    return find_key(table, &key, key_hash(&key));
+}
+
+/**
+ * @brief Get the canonical form of an interned key.
+ *
+ * A URL is returned as "scheme://host:port/path?query", a path with its
+ * leading '/'.
+ *
+ * @param[in] table The table.
+ * @param[in] id An ID returned by yuarel_intern_add() or yuarel_intern_find().
+ * @param[out] len Set to the length of the key, or NULL.
+ *
+ * @return The null terminated key, or NULL if the ID was not handed out.
+ */
+const char *yuarel_intern_get(const struct yuarel_intern *table, uint32_t id, size_t *len)
+{
+    const struct yuarel_intern_entry *entry;
+
+    if (NULL == table || NULL == (entry = entry_of(table, id)))
+    {
+        return NULL;
+    }
+    if (NULL != len)
+    {
+        *len = entry->len;
+    }
+    return entry->str;
+}
+
+/**
+ * @brief Get the first URL that has a host or a path.
+ *
+ * Together with yuarel_intern_next(), lists the IDs of all URLs that share a
+ * component, most recently added first. URLs added while listing may be
+ * missed.
+ *
+ * @param[in] table The table.
+ * @param[in] component The ID of a host or a path.
+ *
+ * @return The ID of a URL, or YUAREL_INTERN_NONE if there is none.
+ */
+uint32_t yuarel_intern_first(const struct yuarel_intern *table, uint32_t component)
+{
+    const struct yuarel_intern_entry *entry;
+
+    if (NULL == table || NULL == (entry = entry_of(table, component)))
+    {
+        return YUAREL_INTERN_NONE;
+    }
+    return __atomic_load_n(&entry->head, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * @brief Get the next URL that has a host or a path.
+ *
+ * @param[in] table The table.
+ * @param[in] component The ID of the host or the path.
+ * @param[in] id The ID of the previous URL.
+ *
+ * @return The ID of the next URL, or YUAREL_INTERN_NONE if there is none.
+ */
+uint32_t yuarel_intern_next(const struct yuarel_intern *table, uint32_t component, uint32_t id)
+{
+    const struct yuarel_intern_entry *entry;
+
+    if (NULL == table || NULL == entry_of(table, component) || NULL == (entry = entry_of(table, id)))
+    {
+        return YUAREL_INTERN_NONE;
+    }
+    if (component == entry->host)
+    {
+        return entry->next_host;
+    }
+    if (component == entry->path)
+    {
+        return entry->next_path;
+    }
+    return YUAREL_INTERN_NONE;
+}
+
+/**
+ * @brief Get the number of IDs handed out.
+ *
+ * The IDs are 0 to the count - 1, each of an interned key.
+ *
+ * @param[in] table The table.
+ *
+ * @return The number of IDs.
+ */
+uint32_t yuarel_intern_count(const struct yuarel_intern *table)
+{
+    if (NULL == table)
+    {
+        return 0;
+    }
+    return __atomic_load_n(&table->next_id, __ATOMIC_ACQUIRE);
+}
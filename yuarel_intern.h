@@ -0,0 +1,185 @@
+/**
+ * @file yuarel_intern.h
+ * @brief Concurrent interning of URLs, hosts and paths to dense IDs.
+ *
+ * A table maps each distinct URL, host or path to a 32 bit ID, counting up
+ * from 0. Keys are the canonical forms of parsed components: the scheme and
+ * host are lowercased, and the user info and fragment of a URL are left out.
+ * The table uses open addressing, and inserts and lookups from any number of
+ * threads take no locks: the entry of a new key is built in an arena owned by
+ * the calling thread and put in a slot with a compare-and-swap, and only the
+ * thread that wins the slot takes the next ID, so the IDs have no holes.
+ *
+ * Every URL is linked to the IDs of its host and its path, so all URLs that
+ * share a host, or a path, can be listed.
+ *
+ * @copyright Copyright (C) 2016 Jack Engqvist Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef INC_YUAREL_INTERN_H
+#define INC_YUAREL_INTERN_H
+
+#include "yuarel.h"
+#include "yuarel_arena.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** @brief Returned instead of an ID when there is none. */
+#define YUAREL_INTERN_NONE 0xffffffffu
+
+/** @brief The maximum number of IDs of a table. */
+#define YUAREL_INTERN_MAX_IDS (1u << 30)
+
+struct yuarel_intern_entry;
+
+/**
+ * @struct yuarel_intern
+ * @brief A table of interned URLs and components.
+ *
+ * The number of slots is fixed at twice the maximum number of IDs, rounded
+ * up to a power of two, so probe sequences stay short and the table never
+ * needs to grow.
+ */
+struct yuarel_intern
+{
+    struct yuarel_intern_entry **slots;   /**< @brief The entry of each slot, NULL when empty */
+    struct yuarel_intern_entry **entries; /**< @brief The entries, by ID */
+    uint32_t mask;                        /**< @brief Number of slots - 1 */
+    uint32_t max_ids;                     /**< @brief The maximum number of IDs */
+    uint32_t next_id;                     /**< @brief The next ID to hand out */
+    uint32_t claimed;                     /**< @brief Number of slots claimed or about to be */
+};
+
+/**
+ * @brief Initialize a table.
+ *
+ * @param[out] table The table to initialize.
+ * @param[in] max_ids The maximum number of IDs, at most YUAREL_INTERN_MAX_IDS.
+ *
+ * @return 0 on success, otherwise -1 on error.
+ */
+extern int yuarel_intern_init(struct yuarel_intern *table, uint32_t max_ids);
+
+/**
+ * @brief Free a table.
+ *
+ * The keys and their entries stay in the arenas they were built in.
+ *
+ * @param[in,out] table The table to free.
+ */
+extern void yuarel_intern_free(struct yuarel_intern *table);
+
+/**
+ * @brief Intern a URL or one of its components.
+ *
+ * With `field` YUAREL_FIELD_ALL the whole URL is interned, together with its
+ * host and its path. With YUAREL_FIELD_HOST or YUAREL_FIELD_PATH only that
+ * component is. If the key is new, it is copied into `arena`, which must stay
+ * valid as long as the table is used. Use one arena per thread.
+ *
+ * Safe to call from several threads at once, without locks. If several
+ * threads add the same new key at once, they all get the ID of the first one
+ * to store it, and only wait for that thread to store the ID it took right
+ * after claiming the slot.
+ *
+ * @param[in,out] table The table.
+ * @param[in,out] arena The arena of the calling thread.
+ * @param[in] url The parsed URL.
+ * @param[in] field YUAREL_FIELD_ALL, YUAREL_FIELD_HOST or YUAREL_FIELD_PATH.
+ *
+ * @return The ID, or YUAREL_INTERN_NONE on error or if the table is full.
+ */
+extern uint32_t yuarel_intern_add(struct yuarel_intern *table, struct yuarel_arena *arena, const struct yuarel *url, int field);
+
+/**
+ * @brief Look up the ID of a URL or one of its components, without adding it.
+ *
+ * Safe to call from several threads at once, and concurrently with
+ * yuarel_intern_add().
+ *
+ * @param[in] table The table.
+ * @param[in] url The parsed URL.
+ * @param[in] field YUAREL_FIELD_ALL, YUAREL_FIELD_HOST or YUAREL_FIELD_PATH.
+ *
+ * @return The ID, or YUAREL_INTERN_NONE if it was not interned.
+ */
+extern uint32_t yuarel_intern_find(const struct yuarel_intern *table, const struct yuarel *url, int field);
+
+/**
+ * @brief Get the canonical form of an interned key.
+ *
+ * A URL is returned as "scheme://host:port/path?query", a path with its
+ * leading '/'.
+ *
+ * @param[in] table The table.
+ * @param[in] id An ID returned by yuarel_intern_add() or yuarel_intern_find().
+ * @param[out] len Set to the length of the key, or NULL.
+ *
+ * @return The null terminated key, or NULL if the ID was not handed out.
+ */
+extern const char *yuarel_intern_get(const struct yuarel_intern *table, uint32_t id, size_t *len);
+
+/**
+ * @brief Get the first URL that has a host or a path.
+ *
+ * Together with yuarel_intern_next(), lists the IDs of all URLs that share a
+ * component, most recently added first. URLs added while listing may be
+ * missed.
+ *
+ * @param[in] table The table.
+ * @param[in] component The ID of a host or a path.
+ *
+ * @return The ID of a URL, or YUAREL_INTERN_NONE if there is none.
+ */
+extern uint32_t yuarel_intern_first(const struct yuarel_intern *table, uint32_t component);
+
+/**
+ * @brief Get the next URL that has a host or a path.
+ *
+ * @param[in] table The table.
+ * @param[in] component The ID of the host or the path.
+ * @param[in] id The ID of the previous URL.
+ *
+ * @return The ID of the next URL, or YUAREL_INTERN_NONE if there is none.
+ */
+extern uint32_t yuarel_intern_next(const struct yuarel_intern *table, uint32_t component, uint32_t id);
+
+/**
+ * @brief Get the number of IDs handed out.
+ *
+ * The IDs are 0 to the count - 1, each of an interned key.
+ *
+ * @param[in] table The table.
+ *
+ * @return The number of IDs.
+ */
+extern uint32_t yuarel_intern_count(const struct yuarel_intern *table);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_YUAREL_INTERN_H */
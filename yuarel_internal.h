@@ -0,0 +1,118 @@
+/**
+ * @file yuarel_internal.h
+ * @brief Helpers shared by the modules of the library, not installed.
+ *
+ * Holds the byte classes several modules need, and lets the modules with
+ * their own SIMD loops follow the kernel the scanners of yuarel.c use, so
+ * that YUAREL_FORCE_ISA and yuarel_simd_select() apply to them too.
+ *
+ * @copyright Copyright (C) 2016 Jack Engqvist Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef INC_YUAREL_INTERNAL_H
+#define INC_YUAREL_INTERNAL_H
+
+#include "yuarel.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define YUAREL_X86
+#endif
+
+/* Shared within the library only, and static like the API in the single header */
+#ifndef YUAREL_INTERNAL
+#if defined(YUAREL_STATIC)
+#define YUAREL_INTERNAL static inline
+#elif defined(__GNUC__)
+#define YUAREL_INTERNAL extern __attribute__((visibility("hidden")))
+#else
+#define YUAREL_INTERNAL extern
+#endif
+#endif
+
+/* Value plus one of each hex digit, 0 for other bytes */
+static const unsigned char hex_digit[256] = {
+    ['0'] = 1, ['1'] = 2, ['2'] = 3, ['3'] = 4, ['4'] = 5, ['5'] = 6, ['6'] = 7, ['7'] = 8, ['8'] = 9, ['9'] = 10,
+    ['A'] = 11, ['B'] = 12, ['C'] = 13, ['D'] = 14, ['E'] = 15, ['F'] = 16,
+    ['a'] = 11, ['b'] = 12, ['c'] = 13, ['d'] = 14, ['e'] = 15, ['f'] = 16};
+
+/* One bit per byte, set for the unreserved characters (RFC 3986 section 2.3) */
+static const uint64_t unreserved_bits[4] = {
+    /* '-', '.' and '0' to '9' */
+    (1ull << '-') | (1ull << '.') | (0x3ffull << '0'),
+    /* 'A' to 'Z', '_', 'a' to 'z' and '~' */
+    (0x3ffffffull << ('A' - 64)) | (1ull << ('_' - 64)) | (0x3ffffffull << ('a' - 64)) | (1ull << ('~' - 64)),
+    0,
+    0};
+
+/**
+ * Get the value of a hex digit.
+ *
+ * @param c: The digit.
+ *
+ * @return: The value, or -1 if not a hex digit.
+ */
+static inline int hex_value(char c) { return hex_digit[(unsigned char)c] - 1; }
+
+/**
+ * Check if a byte is an unreserved character, with one lookup.
+ *
+ * @param c: The byte to check.
+ *
+ * @return: 1 if unreserved, otherwise 0.
+ */
+static inline int is_unreserved(unsigned char c) { return (int)((unreserved_bits[c >> 6] >> (c & 63)) & 1); }
+
+/**
+ * Lowercase an ASCII letter.
+ *
+ * @param c: The byte.
+ *
+ * @return: The lowercase byte.
+ */
+static inline unsigned char to_lower(unsigned char c)
+{
+    return ('A' <= c && c <= 'Z') ? (unsigned char)(c | 0x20) : c;
+}
+
+/* Instruction sets of the SIMD kernels, see yuarel_simd_level() */
+#define YUAREL_ISA_SCALAR 0
+#define YUAREL_ISA_SSE2 1
+#define YUAREL_ISA_AVX2 2
+#define YUAREL_ISA_AVX512 3
+
+/**
+ * Get the instruction set of the SIMD kernel in use, choosing the kernel on
+ * first use like yuarel_simd_kernel().
+ *
+ * @return: One of the YUAREL_ISA_* values.
+ */
+YUAREL_INTERNAL int yuarel_simd_level(void);
+
+/**
+ * Check if code compiled for SSSE3 may run, choosing the kernel on first use
+ * like yuarel_simd_kernel().
+ *
+ * @return: 1 with the avx2 and avx512bw kernels, and with the sse2 kernel on
+ *          a CPU with SSSE3 unless a kernel was asked for by name, otherwise 0.
+ */
+YUAREL_INTERNAL int yuarel_simd_ssse3(void);
+
+#endif /* INC_YUAREL_INTERNAL_H */
@@ -0,0 +1,1667 @@
+/**
+ * Copyright (C) 2016,2017 Jack Engqvist Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#define _POSIX_C_SOURCE 200809L
+
+#include "yuarel_matcher.h"
+#include "yuarel_internal.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define MATCHER_MAGIC "YUM\x1a"
+
+/* Rule flags */
+#define RULE_ALLOW 0x01        /* An exception rule */
+#define RULE_ANCHOR_START 0x02 /* Matches at the start of the path only */
+#define RULE_ANCHOR_END 0x04   /* Matches at the end of the URL only */
+#define RULE_FLOATING 0x08     /* A '*' comes before the keyword */
+#define RULE_HOST 0x10         /* Follows the host of a host rule, not in the automaton */
+
+/* Marks a '*' that has not been seen, or a host rule without a path */
+#define NONE ((size_t)-1)
+
+/* Longest rule line read, longer lines are skipped */
+#define RULE_LINE_MAX 4096
+
+/* Blob header, followed by the sections in the order of the counts */
+struct matcher_header
+{
+    char magic[4];
+    uint32_t version;
+    uint32_t host_count;
+    uint32_t state_count;
+    uint32_t edge_count;
+    uint32_t output_count;
+    uint32_t host_output_count;
+    uint32_t rule_count;
+    uint32_t label_size;
+    uint32_t pattern_size;
+    uint32_t header_size;
+};
+
+/* Host rule while compiling */
+struct host_rule
+{
+    const char *host;
+    size_t len;
+    size_t rule; /* Path and query rule following the host, or NONE */
+    uint32_t line;
+    int allow;
+};
+
+/* Host trie node used while compiling */
+struct build_host
+{
+    const char *label;
+    size_t label_len;
+    uint32_t block;
+    uint32_t allow;
+    uint32_t *rules;
+    size_t rule_count;
+    size_t rule_cap;
+    struct build_host *children;
+    size_t child_count;
+    size_t child_cap;
+};
+
+/* Automaton state used while compiling */
+struct build_state
+{
+    struct yuarel_matcher_edge *edges;
+    size_t edge_count;
+    size_t edge_cap;
+    uint32_t *rules;
+    size_t rule_count;
+    size_t rule_cap;
+    uint32_t fail;
+    uint32_t output;
+};
+
+/* Growing pool of strings */
+struct pool
+{
+    char *data;
+    size_t size;
+    size_t cap;
+};
+
+/* Everything collected from the rule list */
+struct build
+{
+    struct host_rule *hosts;
+    size_t host_count;
+    size_t host_cap;
+    struct pool host_pool;
+    struct pool pattern_pool;
+    struct yuarel_matcher_rule *rules;
+    size_t rule_count;
+    size_t rule_cap;
+    struct build_state *states;
+    size_t state_count;
+    size_t state_cap;
+};
+
+/* The path and query of a URL, as matched by the patterns */
+struct match_text
+{
+    const char *part[4];
+    size_t len[4];
+    size_t total;
+};
+
+/**
+ * Check if a byte matches '^', i.e. is not a letter, a digit or one of "_-.%".
+ *
+ * @param c: The byte.
+ *
+ * @return: 1 if it is a separator, otherwise 0.
+ */
+static inline int is_separator(unsigned char c)
+{
+    if (('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z') || ('0' <= c && c <= '9') || c >= 0x80)
+    {
+        return 0;
+    }
+    return '_' != c && '-' != c && '.' != c && '%' != c;
+}
+
+/**
+ * Compare a host label with a label of the list, ignoring the case of the host.
+ *
+ * @param host: The host label.
+ * @param host_len: The length of the host label.
+ * @param label: The lowercase label of the list.
+ * @param label_len: The length of the label of the list.
+ *
+ * @return: Less than, equal to or greater than 0, like memcmp().
+ */
+static int label_cmp(const char *host, size_t host_len, const char *label, size_t label_len)
+{
+    size_t n = host_len < label_len ? host_len : label_len;
+    size_t i;
+
+    for (i = 0; i < n; i++)
+    {
+        int d = (int)to_lower((unsigned char)host[i]) - (int)(unsigned char)label[i];
+        if (0 != d)
+        {
+            return d;
+        }
+    }
+
+    return (host_len > label_len) - (host_len < label_len);
+}
+
+/**
+ * Find the start of the label that ends at `end`.
+ *
+ * @param host: The hostname.
+ * @param end: The end of the label.
+ *
+ * @return: The offset of the first byte of the label.
+ */
+static inline size_t label_start(const char *host, size_t end)
+{
+    while (end > 0 && '.' != host[end - 1])
+    {
+        end--;
+    }
+    return end;
+}
+
+/**
+ * qsort() callback ordering host rules by their labels, from the last, then
+ * by line.
+ *
+ * @param a: The first rule.
+ * @param b: The second rule.
+ *
+ * @return: Less than, equal to or greater than 0.
+ */
+static int host_rule_cmp(const void *a, const void *b)
+{
+    const struct host_rule *x = a;
+    const struct host_rule *y = b;
+    size_t x_end = x->len;
+    size_t y_end = y->len;
+
+    while (x_end > 0 && y_end > 0)
+    {
+        size_t x_start = label_start(x->host, x_end);
+        size_t y_start = label_start(y->host, y_end);
+        int cmp = label_cmp(x->host + x_start, x_end - x_start, y->host + y_start, y_end - y_start);
+
+        if (0 != cmp)
+        {
+            return cmp;
+        }
+        x_end = (x_start > 0) ? x_start - 1 : 0;
+        y_end = (y_start > 0) ? y_start - 1 : 0;
+    }
+
+    if (x_end > 0 || y_end > 0)
+    {
+        return (x_end > 0) - (y_end > 0);
+    }
+
+    /* Duplicates in the order of the list */
+    return (x->line > y->line) - (x->line < y->line);
+}
+
+/**
+ * qsort() callback ordering automaton edges by byte.
+ *
+ * @param a: The first edge.
+ * @param b: The second edge.
+ *
+ * @return: Less than, equal to or greater than 0.
+ */
+static int edge_cmp(const void *a, const void *b)
+{
+    const struct yuarel_matcher_edge *x = a;
+    const struct yuarel_matcher_edge *y = b;
+
+    return (x->byte > y->byte) - (x->byte < y->byte);
+}
+
+/**
+ * Make room for one more element in a growing array.
+ *
+ * @param data: The array, updated when it moves.
+ * @param count: The number of elements in use.
+ * @param cap: The number of elements allocated, updated.
+ * @param size: The size of an element.
+ *
+ * @return: 0 on success, otherwise -1 if out of memory.
+ */
+static int grow(void **data, size_t count, size_t *cap, size_t size)
+{
+    size_t grown_cap;
+    void *grown;
+
+    if (count < *cap)
+    {
+        return 0;
+    }
+
+    grown_cap = *cap ? *cap * 2 : 16;
+    grown = realloc(*data, grown_cap * size);
+    if (NULL == grown)
+    {
+        return -1;
+    }
+    *data = grown;
+    *cap = grown_cap;
+    return 0;
+}
+
+/**
+ * Add a string to a pool.
+ *
+ * @param pool: The pool.
+ * @param str: The string.
+ * @param len: The length of the string.
+ *
+ * @return: The offset of the string in the pool, or -1 if out of memory.
+ */
+static long add_string(struct pool *pool, const char *str, size_t len)
+{
+    size_t offset = pool->size;
+
+    while (pool->size + len > pool->cap)
+    {
+        if (grow((void **)&pool->data, pool->cap, &pool->cap, 1))
+        {
+            return -1;
+        }
+    }
+
+    memcpy(pool->data + offset, str, len);
+    pool->size += len;
+    return (long)offset;
+}
+
+/**
+ * Find the state an edge of an automaton state leads to.
+ *
+ * @param edges: The sorted edges of the state.
+ * @param count: The number of edges.
+ * @param c: The byte of the edge.
+ *
+ * @return: The next state, or 0 if there is no such edge.
+ */
+static uint32_t find_edge(const struct yuarel_matcher_edge *edges, size_t count, unsigned char c)
+{
+    size_t lo = 0;
+    size_t hi = count;
+
+    while (lo < hi)
+    {
+        size_t mid = lo + (hi - lo) / 2;
+
+        if (edges[mid].byte == c)
+        {
+            return edges[mid].target;
+        }
+        if (edges[mid].byte < c)
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * Add a keyword to the automaton, with the rule it belongs to.
+ *
+ * @param b: The build.
+ * @param keyword: The lowercase keyword.
+ * @param len: The length of the keyword, at least 1.
+ * @param rule: The index of the rule.
+ *
+ * @return: 0 on success, otherwise -1 if out of memory.
+ */
+static int add_keyword(struct build *b, const char *keyword, size_t len, uint32_t rule)
+{
+    struct build_state *s;
+    uint32_t state = 0;
+    size_t i, j;
+
+    for (i = 0; i < len; i++)
+    {
+        uint32_t next = 0;
+
+        s = &b->states[state];
+        for (j = 0; j < s->edge_count; j++)
+        {
+            if (s->edges[j].byte == (unsigned char)keyword[i])
+            {
+                next = s->edges[j].target;
+                break;
+            }
+        }
+
+        if (0 == next)
+        {
+            if (grow((void **)&b->states, b->state_count, &b->state_cap, sizeof(struct build_state)))
+            {
+                return -1;
+            }
+            s = &b->states[state];
+            if (grow((void **)&s->edges, s->edge_count, &s->edge_cap, sizeof(struct yuarel_matcher_edge)))
+            {
+                return -1;
+            }
+
+            next = (uint32_t)b->state_count++;
+            memset(&b->states[next], 0, sizeof(struct build_state));
+            s->edges[s->edge_count].byte = (unsigned char)keyword[i];
+            s->edges[s->edge_count].target = next;
+            s->edge_count++;
+        }
+        state = next;
+    }
+
+    s = &b->states[state];
+    if (grow((void **)&s->rules, s->rule_count, &s->rule_cap, sizeof(uint32_t)))
+    {
+        return -1;
+    }
+    s->rules[s->rule_count++] = rule;
+    return 0;
+}
+
+/**
+ * Add a path and query rule, e.g. "/banner/ad", or the path of a host rule.
+ *
+ * @param b: The build.
+ * @param pattern: The lowercase pattern, with its anchors.
+ * @param len: The length of the pattern.
+ * @param line: The line of the rule.
+ * @param allow: Nonzero for an exception rule.
+ * @param host: Nonzero if the pattern follows the host of a host rule. It is
+ *              then anchored at the start, and kept out of the automaton.
+ *
+ * @return: 1 if added, 0 if skipped, or -1 if out of memory.
+ */
+static int add_pattern_rule(struct build *b, const char *pattern, size_t len, uint32_t line, int allow, int host)
+{
+    struct yuarel_matcher_rule *rule;
+    size_t keyword_off = 0;
+    size_t keyword_len = 0;
+    size_t run = 0;
+    size_t i;
+    int flags = allow ? RULE_ALLOW : 0;
+    long offset;
+
+    /* Regular expressions */
+    if (!host && len > 2 && '/' == pattern[0] && '/' == pattern[len - 1])
+    {
+        return 0;
+    }
+
+    if (host)
+    {
+        flags |= RULE_HOST | RULE_ANCHOR_START;
+    }
+    else if (len > 0 && '|' == pattern[0])
+    {
+        flags |= RULE_ANCHOR_START;
+        pattern++;
+        len--;
+    }
+    if (len > 0 && '|' == pattern[len - 1])
+    {
+        flags |= RULE_ANCHOR_END;
+        len--;
+    }
+
+    /* The longest run without wildcards is the keyword */
+    for (i = 0; i <= len; i++)
+    {
+        if (i < len && '*' != pattern[i] && '^' != pattern[i])
+        {
+            run++;
+        }
+        else
+        {
+            if (run > keyword_len)
+            {
+                keyword_off = i - run;
+                keyword_len = run;
+            }
+            run = 0;
+        }
+    }
+    if ((0 == keyword_len && !host) || len > UINT16_MAX)
+    {
+        return 0;
+    }
+    if (NULL != memchr(pattern, '*', keyword_off))
+    {
+        flags |= RULE_FLOATING;
+    }
+
+    offset = add_string(&b->pattern_pool, pattern, len);
+    if (offset < 0 || b->rule_count >= UINT32_MAX ||
+        grow((void **)&b->rules, b->rule_count, &b->rule_cap, sizeof(struct yuarel_matcher_rule)) ||
+        (!host && add_keyword(b, pattern + keyword_off, keyword_len, (uint32_t)b->rule_count)))
+    {
+        return -1;
+    }
+
+    rule = &b->rules[b->rule_count++];
+    memset(rule, 0, sizeof(struct yuarel_matcher_rule));
+    rule->pattern = (uint32_t)offset;
+    rule->pattern_len = (uint16_t)len;
+    rule->keyword_off = (uint16_t)keyword_off;
+    rule->keyword_len = (uint16_t)keyword_len;
+    rule->flags = (uint16_t)flags;
+    rule->line = line;
+    return 1;
+}
+
+/**
+ * Add a host rule, e.g. "ads.example.com" of "||ads.example.com^", or
+ * "tracker.net" and "/pixel" of "||tracker.net/pixel".
+ *
+ * @param b: The build.
+ * @param host: The lowercase host.
+ * @param len: The length of the host.
+ * @param path: The pattern following the host, starting with '/' or '^', or
+ *              NULL if the rule matches the whole host.
+ * @param path_len: The length of the pattern.
+ * @param line: The line of the rule.
+ * @param allow: Nonzero for an exception rule.
+ *
+ * @return: 1 if added, 0 if skipped, or -1 if out of memory.
+ */
+static int add_host_rule(struct build *b, const char *host, size_t len, const char *path, size_t path_len,
+                         uint32_t line, int allow)
+{
+    size_t rule = NONE;
+    long offset;
+    size_t i;
+
+    if (0 == len || '.' == host[0] || '.' == host[len - 1])
+    {
+        return 0;
+    }
+    for (i = 0; i < len; i++)
+    {
+        if (NULL != strchr("/*^|:?#@", host[i]) || ('.' == host[i] && i + 1 < len && '.' == host[i + 1]))
+        {
+            return 0;
+        }
+    }
+
+    if (NULL != path)
+    {
+        int added = add_pattern_rule(b, path, path_len, line, allow, 1);
+
+        if (added <= 0)
+        {
+            return added;
+        }
+        rule = b->rule_count - 1;
+    }
+
+    offset = add_string(&b->host_pool, host, len);
+    if (offset < 0 || grow((void **)&b->hosts, b->host_count, &b->host_cap, sizeof(struct host_rule)))
+    {
+        return -1;
+    }
+
+    /* Pointers into the pool are set once it stops moving */
+    b->hosts[b->host_count].host = (const char *)(size_t)offset;
+    b->hosts[b->host_count].len = len;
+    b->hosts[b->host_count].rule = rule;
+    b->hosts[b->host_count].line = line;
+    b->hosts[b->host_count].allow = allow;
+    b->host_count++;
+    return 1;
+}
+
+/**
+ * Add one line of the rule list.
+ *
+ * @param b: The build.
+ * @param rule: The line, lowercase, without surrounding whitespace.
+ * @param len: The length of the line.
+ * @param line: The line number.
+ *
+ * @return: 1 if added, 0 if skipped, or -1 if out of memory.
+ */
+static int add_rule(struct build *b, const char *rule, size_t len, uint32_t line)
+{
+    int allow = 0;
+    size_t i;
+
+    /* Comments and the "[Adblock Plus 2.0]" header */
+    if (0 == len || '!' == rule[0] || '[' == rule[0])
+    {
+        return 0;
+    }
+
+    /* Element hiding rules and options */
+    for (i = 0; i < len; i++)
+    {
+        if ('$' == rule[i] || ('#' == rule[i] && i + 1 < len && NULL != strchr("#@?$", rule[i + 1])))
+        {
+            return 0;
+        }
+    }
+
+    if (len >= 2 && '@' == rule[0] && '@' == rule[1])
+    {
+        allow = 1;
+        rule += 2;
+        len -= 2;
+    }
+
+    if (len >= 2 && '|' == rule[0] && '|' == rule[1])
+    {
+        rule += 2;
+        len -= 2;
+
+        /* The host ends at the first '/' or '^', anything after it is a path */
+        for (i = 0; i < len && '/' != rule[i] && '^' != rule[i]; i++)
+        {
+        }
+        if (i == len || (i == len - 1 && '^' == rule[i]))
+        {
+            return add_host_rule(b, rule, i, NULL, 0, line, allow);
+        }
+        return add_host_rule(b, rule, i, rule + i, len - i, line, allow);
+    }
+
+    return add_pattern_rule(b, rule, len, line, allow, 0);
+}
+
+/**
+ * Free the children and rule lists of a host trie build node, recursively.
+ *
+ * @param node: The node.
+ */
+static void build_host_free(struct build_host *node)
+{
+    size_t i;
+
+    for (i = 0; i < node->child_count; i++)
+    {
+        build_host_free(&node->children[i]);
+    }
+    free(node->children);
+    free(node->rules);
+}
+
+/**
+ * Build the host trie from the host rules, sorted by host_rule_cmp(). As the
+ * rules are sorted, an existing child can only be the last one added.
+ *
+ * @param b: The build.
+ * @param root: The root node to fill in.
+ * @param count: Set to the number of nodes, the root included.
+ * @param label_size: Set to the total length of the labels.
+ *
+ * @return: 0 on success, otherwise -1 if out of memory.
+ */
+static int build_host_trie(const struct build *b, struct build_host *root, size_t *count, size_t *label_size)
+{
+    size_t i;
+
+    *count = 1;
+    *label_size = 0;
+
+    for (i = 0; i < b->host_count; i++)
+    {
+        const struct host_rule *r = &b->hosts[i];
+        struct build_host *node = root;
+        size_t end = r->len;
+
+        while (end > 0)
+        {
+            size_t start = label_start(r->host, end);
+            struct build_host *last = node->child_count ? &node->children[node->child_count - 1] : NULL;
+
+            if (NULL == last || 0 != label_cmp(r->host + start, end - start, last->label, last->label_len))
+            {
+                if (grow((void **)&node->children, node->child_count, &node->child_cap, sizeof(struct build_host)))
+                {
+                    return -1;
+                }
+                last = &node->children[node->child_count++];
+                memset(last, 0, sizeof(struct build_host));
+                last->label = r->host + start;
+                last->label_len = end - start;
+                (*count)++;
+                *label_size += end - start;
+            }
+
+            node = last;
+            end = (start > 0) ? start - 1 : 0;
+        }
+
+        /* The first of duplicate rules wins */
+        if (NONE != r->rule)
+        {
+            if (grow((void **)&node->rules, node->rule_count, &node->rule_cap, sizeof(uint32_t)))
+            {
+                return -1;
+            }
+            node->rules[node->rule_count++] = (uint32_t)r->rule;
+        }
+        else if (r->allow && 0 == node->allow)
+        {
+            node->allow = r->line;
+        }
+        else if (!r->allow && 0 == node->block)
+        {
+            node->block = r->line;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * Compute the fail and output links of the automaton, and number the states
+ * breadth first so that both links always point to an earlier state.
+ *
+ * @param b: The build.
+ * @param order: Set to the states in breadth first order.
+ * @param number: Set to the new number of each state.
+ */
+static void build_links(struct build *b, uint32_t *order, uint32_t *number)
+{
+    size_t head, tail = 1;
+
+    order[0] = 0;
+    number[0] = 0;
+
+    for (head = 0; head < tail; head++)
+    {
+        struct build_state *s = &b->states[order[head]];
+        size_t i;
+
+        if (s->edge_count > 1)
+        {
+            qsort(s->edges, s->edge_count, sizeof(struct yuarel_matcher_edge), edge_cmp);
+        }
+
+        for (i = 0; i < s->edge_count; i++)
+        {
+            uint32_t target = s->edges[i].target;
+            unsigned char c = (unsigned char)s->edges[i].byte;
+            struct build_state *t = &b->states[target];
+
+            number[target] = (uint32_t)tail;
+            order[tail++] = target;
+
+            /* Longest proper suffix that continues with c */
+            t->fail = 0;
+            if (0 != order[head])
+            {
+                uint32_t f = s->fail;
+
+                for (;;)
+                {
+                    uint32_t next = find_edge(b->states[f].edges, b->states[f].edge_count, c);
+
+                    if (0 != next || 0 == f)
+                    {
+                        t->fail = next;
+                        break;
+                    }
+                    f = b->states[f].fail;
+                }
+            }
+            t->output = (t->rule_count > 0) ? target : b->states[t->fail].output;
+        }
+    }
+}
+
+/**
+ * Free everything collected for a rule list.
+ *
+ * @param b: The build.
+ */
+static void build_free(struct build *b)
+{
+    size_t i;
+
+    for (i = 0; i < b->state_count; i++)
+    {
+        free(b->states[i].edges);
+        free(b->states[i].rules);
+    }
+    free(b->states);
+    free(b->hosts);
+    free(b->host_pool.data);
+    free(b->pattern_pool.data);
+    free(b->rules);
+}
+
+/**
+ * Read a rule list.
+ *
+ * @param b: The build to add the rules to.
+ * @param in: The rule list.
+ *
+ * @return: The number of rules added, or -1 if out of memory.
+ */
+static long read_rules(struct build *b, FILE *in)
+{
+    char line[RULE_LINE_MAX];
+    uint32_t line_no = 0;
+    long rules = 0;
+
+    while (NULL != fgets(line, sizeof(line), in))
+    {
+        size_t len = strlen(line);
+        char *rule = line;
+        int added;
+        size_t i;
+
+        line_no++;
+        if (len == sizeof(line) - 1 && '\n' != line[len - 1])
+        {
+            /* Too long, skip the rest of the line */
+            int c;
+
+            while (EOF != (c = fgetc(in)) && '\n' != c)
+            {
+            }
+            continue;
+        }
+
+        while (len > 0 && NULL != strchr(" \t\r\n", rule[len - 1]))
+        {
+            len--;
+        }
+        while (len > 0 && (' ' == *rule || '\t' == *rule))
+        {
+            rule++;
+            len--;
+        }
+        for (i = 0; i < len; i++)
+        {
+            rule[i] = (char)to_lower((unsigned char)rule[i]);
+        }
+
+        added = add_rule(b, rule, len, line_no);
+        if (added < 0)
+        {
+            return -1;
+        }
+        rules += added;
+    }
+
+    return rules;
+}
+
+/**
+ * Write a section of the blob.
+ *
+ * @param out: The blob file.
+ * @param data: The elements, may be NULL if there are none.
+ * @param size: The size of an element.
+ * @param count: The number of elements.
+ *
+ * @return: 1 on success, otherwise 0.
+ */
+static int write_all(FILE *out, const void *data, size_t size, size_t count)
+{
+    return 0 == count || count == fwrite(data, size, count, out);
+}
+
+/**
+ * @brief Compile a list of Adblock style rules into a blob file.
+ *
+ * Supported rules are host rules `||host^`, which match the host and its
+ * subdomains, and patterns over the path and query such as `/banner/ad`,
+ * `|/ads/` or `.gif|`, with `*` for any run of bytes, `^` for a separator or
+ * the end and `|` anchoring the start or end. Patterns are matched against "/", the
+ * path, and "?" and the query if there is one. A host rule with a path, such as
+ * `||tracker.net/pixel`, matches when the host rule does and its pattern matches
+ * from the start. `@@` turns a rule into an exception. Rules are case
+ * insensitive.
+ *
+ * Comments, element hiding rules, regular expressions and rules with `$`
+ * options are skipped, as are host rules with a port or a `*` in the host and
+ * patterns without any literal byte.
+ *
+ * @param[in] rules_filename The rule list to read.
+ * @param[in] blob_filename The blob file to write.
+ *
+ * @return The number of rules compiled, or -1 on error.
+ */
+long yuarel_matcher_compile(const char *rules_filename, const char *blob_filename)
+{
+    struct build b;
+    struct build_host root;
+    struct matcher_header header;
+    struct yuarel_matcher_host *hosts = NULL;
+    struct yuarel_matcher_state *states = NULL;
+    struct yuarel_matcher_edge *edges = NULL;
+    const struct build_host **queue = NULL;
+    uint32_t *order = NULL;
+    uint32_t *number = NULL;
+    uint32_t *outputs = NULL;
+    uint32_t *host_outputs = NULL;
+    uint32_t root_next[256];
+    char *labels = NULL;
+    size_t host_count, label_size, edge_count = 0, output_count = 0, host_output_count = 0;
+    size_t head, tail, label_off = 0;
+    size_t i;
+    long rules;
+    long rc = -1;
+    FILE *in;
+    FILE *out = NULL;
+
+    if (NULL == rules_filename || NULL == blob_filename)
+    {
+        return -1;
+    }
+
+    in = fopen(rules_filename, "r");
+    if (NULL == in)
+    {
+        return -1;
+    }
+
+    memset(&b, 0, sizeof(b));
+    memset(&root, 0, sizeof(root));
+
+    /* The root state of the automaton */
+    if (grow((void **)&b.states, 0, &b.state_cap, sizeof(struct build_state)))
+    {
+        goto out;
+    }
+    memset(b.states, 0, sizeof(struct build_state));
+    b.state_count = 1;
+
+    rules = read_rules(&b, in);
+    if (rules < 0)
+    {
+        goto out;
+    }
+
+    /* Host trie */
+    for (i = 0; i < b.host_count; i++)
+    {
+        b.hosts[i].host = b.host_pool.data + (size_t)b.hosts[i].host;
+        host_output_count += (NONE != b.hosts[i].rule);
+    }
+    if (b.host_count > 1)
+    {
+        qsort(b.hosts, b.host_count, sizeof(struct host_rule), host_rule_cmp);
+    }
+    if (build_host_trie(&b, &root, &host_count, &label_size))
+    {
+        goto out;
+    }
+    if (host_count > UINT32_MAX || label_size > UINT32_MAX || b.state_count > UINT32_MAX ||
+        b.pattern_pool.size > UINT32_MAX)
+    {
+        goto out;
+    }
+
+    hosts = calloc(host_count, sizeof(struct yuarel_matcher_host));
+    queue = malloc(host_count * sizeof(*queue));
+    labels = malloc(label_size + 1);
+    host_outputs = malloc((host_output_count + 1) * sizeof(uint32_t));
+    if (NULL == hosts || NULL == queue || NULL == labels || NULL == host_outputs)
+    {
+        goto out;
+    }
+
+    /* Breadth first, so the children of every node are next to each other */
+    queue[0] = &root;
+    tail = 1;
+    host_output_count = 0;
+    for (head = 0; head < tail; head++)
+    {
+        const struct build_host *n = queue[head];
+
+        if (n->label_len > 0)
+        {
+            memcpy(labels + label_off, n->label, n->label_len);
+        }
+        hosts[head].label = (uint32_t)label_off;
+        hosts[head].label_len = (uint32_t)n->label_len;
+        hosts[head].first_child = (uint32_t)tail;
+        hosts[head].child_count = (uint32_t)n->child_count;
+        hosts[head].block = n->block;
+        hosts[head].allow = n->allow;
+        hosts[head].first_rule = (uint32_t)host_output_count;
+        hosts[head].rule_count = (uint32_t)n->rule_count;
+        label_off += n->label_len;
+
+        for (i = 0; i < n->rule_count; i++)
+        {
+            host_outputs[host_output_count++] = n->rules[i];
+        }
+
+        for (i = 0; i < n->child_count; i++)
+        {
+            queue[tail++] = &n->children[i];
+        }
+    }
+
+    /* Keyword automaton */
+    order = malloc(b.state_count * sizeof(uint32_t));
+    number = malloc(b.state_count * sizeof(uint32_t));
+    states = calloc(b.state_count, sizeof(struct yuarel_matcher_state));
+    if (NULL == order || NULL == number || NULL == states)
+    {
+        goto out;
+    }
+    build_links(&b, order, number);
+
+    for (i = 0; i < b.state_count; i++)
+    {
+        edge_count += b.states[i].edge_count;
+        output_count += b.states[i].rule_count;
+    }
+    if (edge_count > UINT32_MAX || output_count > UINT32_MAX)
+    {
+        goto out;
+    }
+    edges = malloc((edge_count + 1) * sizeof(struct yuarel_matcher_edge));
+    outputs = malloc((output_count + 1) * sizeof(uint32_t));
+    if (NULL == edges || NULL == outputs)
+    {
+        goto out;
+    }
+
+    edge_count = 0;
+    output_count = 0;
+    for (i = 0; i < b.state_count; i++)
+    {
+        const struct build_state *s = &b.states[order[i]];
+        size_t j;
+
+        states[i].first_edge = (uint32_t)edge_count;
+        states[i].edge_count = (uint32_t)s->edge_count;
+        states[i].fail = number[s->fail];
+        states[i].output = number[s->output];
+        states[i].first_rule = (uint32_t)output_count;
+        states[i].rule_count = (uint32_t)s->rule_count;
+
+        for (j = 0; j < s->edge_count; j++)
+        {
+            edges[edge_count].byte = s->edges[j].byte;
+            edges[edge_count].target = number[s->edges[j].target];
+            edge_count++;
+        }
+        for (j = 0; j < s->rule_count; j++)
+        {
+            outputs[output_count++] = s->rules[j];
+        }
+    }
+
+    memset(root_next, 0, sizeof(root_next));
+    for (i = 0; i < states[0].edge_count; i++)
+    {
+        root_next[edges[i].byte] = edges[i].target;
+    }
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, MATCHER_MAGIC, 4);
+    header.version = YUAREL_MATCHER_VERSION;
+    header.host_count = (uint32_t)host_count;
+    header.state_count = (uint32_t)b.state_count;
+    header.edge_count = (uint32_t)edge_count;
+    header.output_count = (uint32_t)output_count;
+    header.host_output_count = (uint32_t)host_output_count;
+    header.rule_count = (uint32_t)b.rule_count;
+    header.label_size = (uint32_t)label_size;
+    header.pattern_size = (uint32_t)b.pattern_pool.size;
+    header.header_size = sizeof(struct matcher_header);
+
+    out = fopen(blob_filename, "wb");
+    if (NULL == out ||
+        !write_all(out, &header, sizeof(header), 1) ||
+        !write_all(out, hosts, sizeof(struct yuarel_matcher_host), host_count) ||
+        !write_all(out, states, sizeof(struct yuarel_matcher_state), b.state_count) ||
+        !write_all(out, root_next, sizeof(root_next), 1) ||
+        !write_all(out, edges, sizeof(struct yuarel_matcher_edge), edge_count) ||
+        !write_all(out, outputs, sizeof(uint32_t), output_count) ||
+        !write_all(out, host_outputs, sizeof(uint32_t), host_output_count) ||
+        !write_all(out, b.rules, sizeof(struct yuarel_matcher_rule), b.rule_count) ||
+        !write_all(out, labels, 1, label_size) ||
+        !write_all(out, b.pattern_pool.data, 1, b.pattern_pool.size))
+    {
+        goto out;
+    }
+
+    rc = rules;
+
+out:
+    if (NULL != out && 0 != fclose(out))
+    {
+        rc = -1;
+    }
+    fclose(in);
+    build_host_free(&root);
+    build_free(&b);
+    free(hosts);
+    free(queue);
+    free(labels);
+    free(order);
+    free(number);
+    free(states);
+    free(edges);
+    free(outputs);
+    free(host_outputs);
+    return rc;
+}
+
+/**
+ * @brief Use a compiled blob that is already in memory.
+ *
+ * The blob is not copied and must outlive the matcher. It must be aligned to 4
+ * bytes.
+ *
+ * @param[out] matcher The matcher to load.
+ * @param[in] data The blob.
+ * @param[in] size The size of the blob.
+ *
+ * @return 0 on success, otherwise -1 if the blob is invalid.
+ */
+int yuarel_matcher_load(struct yuarel_matcher *matcher, const void *data, size_t size)
+{
+    struct yuarel_matcher *m = matcher;
+    const unsigned char *blob = data;
+    struct matcher_header header;
+    size_t output_count;
+    size_t host_output_count;
+    size_t i;
+
+    if (NULL == m || NULL == data || size < sizeof(struct matcher_header))
+    {
+        return -1;
+    }
+
+    memset(m, 0, sizeof(struct yuarel_matcher));
+
+    memcpy(&header, blob, sizeof(header));
+    if (0 != memcmp(header.magic, MATCHER_MAGIC, 4) ||
+        YUAREL_MATCHER_VERSION != header.version ||
+        sizeof(struct matcher_header) != header.header_size ||
+        0 == header.host_count ||
+        0 == header.state_count ||
+        size != sizeof(header) + (size_t)header.host_count * sizeof(struct yuarel_matcher_host) +
+                    (size_t)header.state_count * sizeof(struct yuarel_matcher_state) + 256 * sizeof(uint32_t) +
+                    (size_t)header.edge_count * sizeof(struct yuarel_matcher_edge) +
+                    (size_t)header.output_count * sizeof(uint32_t) +
+                    (size_t)header.host_output_count * sizeof(uint32_t) +
+                    (size_t)header.rule_count * sizeof(struct yuarel_matcher_rule) + header.label_size +
+                    header.pattern_size)
+    {
+        return -1;
+    }
+
+    m->host_count = header.host_count;
+    m->state_count = header.state_count;
+    m->edge_count = header.edge_count;
+    m->rule_count = header.rule_count;
+    output_count = header.output_count;
+    host_output_count = header.host_output_count;
+    m->hosts = (const struct yuarel_matcher_host *)(blob + sizeof(header));
+    m->states = (const struct yuarel_matcher_state *)(m->hosts + m->host_count);
+    m->root = (const uint32_t *)(m->states + m->state_count);
+    m->edges = (const struct yuarel_matcher_edge *)(m->root + 256);
+    m->outputs = (const uint32_t *)(m->edges + m->edge_count);
+    m->host_rules = m->outputs + output_count;
+    m->rules = (const struct yuarel_matcher_rule *)(m->host_rules + host_output_count);
+    m->labels = (const char *)(m->rules + m->rule_count);
+    m->patterns = m->labels + header.label_size;
+
+    /* Children always follow their parent, so lookups terminate */
+    for (i = 0; i < m->host_count; i++)
+    {
+        const struct yuarel_matcher_host *n = &m->hosts[i];
+
+        if ((size_t)n->label + n->label_len > header.label_size ||
+            (size_t)n->first_rule + n->rule_count > host_output_count ||
+            (n->child_count > 0 && (n->first_child <= i || (size_t)n->first_child + n->child_count > m->host_count)))
+        {
+            goto invalid;
+        }
+    }
+
+    /* Fail and output links point back, so following them terminates */
+    for (i = 0; i < m->state_count; i++)
+    {
+        const struct yuarel_matcher_state *s = &m->states[i];
+
+        if ((i > 0 && s->fail >= i) || (0 == i && (0 != s->fail || 0 != s->rule_count)) || s->output > i ||
+            (size_t)s->first_edge + s->edge_count > m->edge_count ||
+            (size_t)s->first_rule + s->rule_count > output_count)
+        {
+            goto invalid;
+        }
+    }
+    for (i = 0; i < m->edge_count; i++)
+    {
+        if (m->edges[i].byte > 0xff || m->edges[i].target >= m->state_count)
+        {
+            goto invalid;
+        }
+    }
+    for (i = 0; i < 256; i++)
+    {
+        if (m->root[i] >= m->state_count)
+        {
+            goto invalid;
+        }
+    }
+    for (i = 0; i < output_count; i++)
+    {
+        if (m->outputs[i] >= m->rule_count)
+        {
+            goto invalid;
+        }
+    }
+    for (i = 0; i < host_output_count; i++)
+    {
+        if (m->host_rules[i] >= m->rule_count)
+        {
+            goto invalid;
+        }
+    }
+    for (i = 0; i < m->rule_count; i++)
+    {
+        const struct yuarel_matcher_rule *r = &m->rules[i];
+
+        if ((size_t)r->pattern + r->pattern_len > header.pattern_size ||
+            (0 == r->keyword_len && !(r->flags & RULE_HOST)) ||
+            (size_t)r->keyword_off + r->keyword_len > r->pattern_len)
+        {
+            goto invalid;
+        }
+    }
+
+    return 0;
+
+invalid:
+    memset(m, 0, sizeof(struct yuarel_matcher));
+    return -1;
+}
+
+/**
+ * @brief Open a compiled blob file by mapping it into memory.
+ *
+ * @param[out] matcher The matcher to open.
+ * @param[in] filename The blob file to open.
+ *
+ * @return 0 on success, otherwise -1 on error or if the blob is invalid.
+ */
+int yuarel_matcher_open(struct yuarel_matcher *matcher, const char *filename)
+{
+    struct stat st;
+    void *map;
+    int fd;
+
+    if (NULL == matcher || NULL == filename)
+    {
+        return -1;
+    }
+
+    memset(matcher, 0, sizeof(struct yuarel_matcher));
+
+    fd = open(filename, O_RDONLY);
+    if (fd < 0)
+    {
+        return -1;
+    }
+
+    if (0 != fstat(fd, &st) || (size_t)st.st_size < sizeof(struct matcher_header))
+    {
+        close(fd);
+        return -1;
+    }
+
+    map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (MAP_FAILED == map)
+    {
+        return -1;
+    }
+
+    if (0 != yuarel_matcher_load(matcher, map, (size_t)st.st_size))
+    {
+        munmap(map, (size_t)st.st_size);
+        return -1;
+    }
+
+    matcher->map = map;
+    matcher->map_size = (size_t)st.st_size;
+    return 0;
+}
+
+/**
+ * @brief Unmap a matcher opened by yuarel_matcher_open().
+ *
+ * @param[in,out] matcher The matcher to close.
+ */
+void yuarel_matcher_close(struct yuarel_matcher *matcher)
+{
+    if (NULL == matcher)
+    {
+        return;
+    }
+
+    if (NULL != matcher->map)
+    {
+        munmap(matcher->map, matcher->map_size);
+    }
+    memset(matcher, 0, sizeof(struct yuarel_matcher));
+}
+
+/**
+ * Find the child of a host trie node with a given label.
+ *
+ * @param m: The matcher.
+ * @param node: The parent node.
+ * @param label: The host label, in any case.
+ * @param len: The length of the label.
+ *
+ * @return: The child, or NULL if there is none.
+ */
+static const struct yuarel_matcher_host *find_child(const struct yuarel_matcher *m,
+                                                    const struct yuarel_matcher_host *node, const char *label,
+                                                    size_t len)
+{
+    size_t lo = node->first_child;
+    size_t hi = lo + node->child_count;
+
+    while (lo < hi)
+    {
+        size_t mid = lo + (hi - lo) / 2;
+        const struct yuarel_matcher_host *child = &m->hosts[mid];
+        int cmp = label_cmp(label, len, m->labels + child->label, child->label_len);
+
+        if (0 == cmp)
+        {
+            return child;
+        }
+        if (cmp < 0)
+        {
+            hi = mid;
+        }
+        else
+        {
+            lo = mid + 1;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Get a byte of the path and query, in lowercase.
+ *
+ * @param t: The text.
+ * @param i: The offset, less than `t->total`.
+ *
+ * @return: The byte.
+ */
+static inline unsigned char text_at(const struct match_text *t, size_t i)
+{
+    size_t k = 0;
+
+    while (i >= t->len[k])
+    {
+        i -= t->len[k++];
+    }
+    return to_lower((unsigned char)t->part[k][i]);
+}
+
+/**
+ * Match a pattern, with '*' and '^' wildcards, against the text at an offset.
+ *
+ * @param t: The text.
+ * @param start: The offset to match at.
+ * @param p: The pattern, without anchors.
+ * @param len: The length of the pattern.
+ * @param anchor_end: Nonzero if the pattern must match up to the end.
+ * @param floating: Nonzero to match at any offset from `start` on.
+ *
+ * @return: 1 if the pattern matches, otherwise 0.
+ */
+static int glob_match(const struct match_text *t, size_t start, const char *p, size_t len, int anchor_end,
+                      int floating)
+{
+    size_t ti = start;
+    size_t pi = 0;
+    size_t star_p = floating ? 0 : NONE;
+    size_t star_t = start;
+
+    for (;;)
+    {
+        if (pi < len && '*' == p[pi])
+        {
+            star_p = ++pi;
+            star_t = ti;
+            continue;
+        }
+
+        if (pi == len)
+        {
+            if (!anchor_end || ti == t->total)
+            {
+                return 1;
+            }
+        }
+        else if (ti < t->total)
+        {
+            unsigned char c = text_at(t, ti);
+
+            if ('^' == p[pi] ? is_separator(c) : (unsigned char)p[pi] == c)
+            {
+                pi++;
+                ti++;
+                continue;
+            }
+        }
+        else if ('^' == p[pi])
+        {
+            /* '^' also matches the end */
+            pi++;
+            continue;
+        }
+
+        /* Let the last '*' take one more byte */
+        if (NONE == star_p || star_t >= t->total)
+        {
+            return 0;
+        }
+        pi = star_p;
+        ti = ++star_t;
+    }
+}
+
+/**
+ * Check a rule whose keyword was found in the text.
+ *
+ * @param m: The matcher.
+ * @param t: The text.
+ * @param rule: The rule.
+ * @param end: The offset just past the keyword.
+ *
+ * @return: 1 if the rule matches, otherwise 0.
+ */
+static int rule_matches(const struct yuarel_matcher *m, const struct match_text *t,
+                        const struct yuarel_matcher_rule *rule, size_t end)
+{
+    const char *p = m->patterns + rule->pattern;
+    size_t before = (size_t)rule->keyword_off + rule->keyword_len;
+    int anchor_end = rule->flags & RULE_ANCHOR_END;
+
+    if (rule->flags & RULE_FLOATING)
+    {
+        return glob_match(t, 0, p, rule->pattern_len, anchor_end, !(rule->flags & RULE_ANCHOR_START));
+    }
+
+    /* Without a '*' before it, the keyword fixes where the pattern starts */
+    if (end < before || ((rule->flags & RULE_ANCHOR_START) && end != before))
+    {
+        return 0;
+    }
+    return glob_match(t, end - before, p, rule->pattern_len, anchor_end, 0);
+}
+
+/**
+ * Look a host up in the host trie. The rules of the host and of all its parent
+ * domains match, those with a path only if it matches the text too.
+ *
+ * @param m: The matcher.
+ * @param host: The hostname.
+ * @param t: The text.
+ * @param block: Set to the line of a matching blocking rule, if not set yet.
+ *
+ * @return: The line of a matching exception rule, or 0.
+ */
+static uint32_t match_host(const struct yuarel_matcher *m, const char *host, const struct match_text *t,
+                           uint32_t *block)
+{
+    const struct yuarel_matcher_host *node = m->hosts;
+    size_t end = strlen(host);
+    size_t r;
+
+    if (end > 0 && '.' == host[end - 1])
+    {
+        end--;
+    }
+
+    while (end > 0)
+    {
+        size_t start = label_start(host, end);
+
+        node = find_child(m, node, host + start, end - start);
+        if (NULL == node)
+        {
+            break;
+        }
+        if (0 != node->allow)
+        {
+            return node->allow;
+        }
+        if (0 != node->block && 0 == *block)
+        {
+            *block = node->block;
+        }
+        for (r = 0; r < node->rule_count; r++)
+        {
+            const struct yuarel_matcher_rule *rule = &m->rules[m->host_rules[node->first_rule + r]];
+
+            if ((0 != *block && !(rule->flags & RULE_ALLOW)) ||
+                !glob_match(t, 0, m->patterns + rule->pattern, rule->pattern_len, rule->flags & RULE_ANCHOR_END, 0))
+            {
+                continue;
+            }
+            if (rule->flags & RULE_ALLOW)
+            {
+                return rule->line;
+            }
+            *block = rule->line;
+        }
+        if (0 == start)
+        {
+            break;
+        }
+        end = start - 1;
+    }
+
+    return 0;
+}
+
+/**
+ * Find the next state of the automaton.
+ *
+ * @param m: The matcher.
+ * @param state: The current state.
+ * @param c: The next lowercase byte.
+ *
+ * @return: The next state.
+ */
+static inline uint32_t next_state(const struct yuarel_matcher *m, uint32_t state, unsigned char c)
+{
+    while (0 != state)
+    {
+        const struct yuarel_matcher_state *s = &m->states[state];
+        uint32_t next = find_edge(m->edges + s->first_edge, s->edge_count, c);
+
+        if (0 != next)
+        {
+            return next;
+        }
+        state = s->fail;
+    }
+
+    return m->root[c];
+}
+
+/**
+ * Run the path and query through the automaton, and check the rules of every
+ * keyword found.
+ *
+ * @param m: The matcher.
+ * @param t: The text.
+ * @param block: Set to the line of a matching blocking rule, if not set yet.
+ *
+ * @return: The line of a matching exception rule, or 0.
+ */
+static uint32_t match_text(const struct yuarel_matcher *m, const struct match_text *t, uint32_t *block)
+{
+    uint32_t state = 0;
+    size_t pos = 0;
+    size_t k, i;
+
+    for (k = 0; k < 4; k++)
+    {
+        const char *part = t->part[k];
+
+        for (i = 0; i < t->len[k]; i++)
+        {
+            uint32_t out;
+
+            /* Bytes that no keyword starts with leave the root at once */
+            if (0 == state)
+            {
+                size_t skip = i;
+
+                while (skip < t->len[k] && 0 == m->root[to_lower((unsigned char)part[skip])])
+                {
+                    skip++;
+                }
+                pos += skip - i;
+                i = skip;
+                if (i == t->len[k])
+                {
+                    break;
+                }
+            }
+
+            state = next_state(m, state, to_lower((unsigned char)part[i]));
+            pos++;
+
+            for (out = m->states[state].output; 0 != out; out = m->states[m->states[out].fail].output)
+            {
+                const struct yuarel_matcher_state *s = &m->states[out];
+                size_t r;
+
+                for (r = 0; r < s->rule_count; r++)
+                {
+                    const struct yuarel_matcher_rule *rule = &m->rules[m->outputs[s->first_rule + r]];
+
+                    /* Once blocked, only exceptions can change the result */
+                    if ((0 != *block && !(rule->flags & RULE_ALLOW)) || !rule_matches(m, t, rule, pos))
+                    {
+                        continue;
+                    }
+                    if (rule->flags & RULE_ALLOW)
+                    {
+                        return rule->line;
+                    }
+                    *block = rule->line;
+                }
+            }
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Match a parsed URL against the rules.
+ *
+ * The host is looked up in the host trie, and the path and query are run
+ * through the keyword automaton once. An exception rule wins over any
+ * blocking rule. Does not allocate.
+ *
+ * @param[in] matcher The matcher.
+ * @param[in] url The parsed URL.
+ * @param[out] line Where to store the line of the deciding rule, or NULL.
+ *
+ * @return One of the yuarel_match_result values, or -1 if the matcher or the
+ *         URL is missing.
+ */
+int yuarel_matcher_match(const struct yuarel_matcher *matcher, const struct yuarel *url, uint32_t *line)
+{
+    struct match_text t;
+    uint32_t block = 0;
+    uint32_t allow = 0;
+
+    if (NULL == matcher || NULL == matcher->hosts || NULL == url)
+    {
+        return -1;
+    }
+
+    memset(&t, 0, sizeof(t));
+    t.part[0] = "/";
+    t.len[0] = 1;
+    if (NULL != url->path)
+    {
+        t.part[1] = url->path;
+        t.len[1] = strlen(url->path);
+    }
+    if (NULL != url->query)
+    {
+        t.part[2] = "?";
+        t.len[2] = 1;
+        t.part[3] = url->query;
+        t.len[3] = strlen(url->query);
+    }
+    t.total = t.len[0] + t.len[1] + t.len[2] + t.len[3];
+
+    if (NULL != url->host)
+    {
+        allow = match_host(matcher, url->host, &t, &block);
+    }
+    if (0 == allow)
+    {
+        allow = match_text(matcher, &t, &block);
+    }
+
+    if (NULL != line)
+    {
+        *line = (0 != allow) ? allow : block;
+    }
+    if (0 != allow)
+    {
+        return YUAREL_MATCH_ALLOW;
+    }
+    return (0 != block) ? YUAREL_MATCH_BLOCK : YUAREL_MATCH_NONE;
+}
@@ -0,0 +1,213 @@
+/**
+ * @file yuarel_matcher.h
+ * @brief Compiled matching of URLs against Adblock style block and allow lists.
+ *
+ * A list of rules such as `||ads.example.com^` and `/banner/ad` is compiled once
+ * into a blob. Host rules are kept in a trie of reversed host labels, like the
+ * public suffix list of yuarel_psl.h. The path of a host rule such as
+ * `||tracker.net/pixel` is kept with its trie node, and is only checked once the
+ * host matches. Every other rule contributes its longest
+ * literal run as a keyword to an Aho-Corasick automaton, which is run over the
+ * path and query of a URL in a single pass. Rules whose keyword is found are
+ * then checked in full. The blob is position independent and is used directly
+ * from an mmap'd file, and matching never allocates.
+ *
+ * @copyright Copyright (C) 2016 Jack Engqvist Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef INC_YUAREL_MATCHER_H
+#define INC_YUAREL_MATCHER_H
+
+#include "yuarel.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** @brief Format version written to and accepted from the blob header */
+#define YUAREL_MATCHER_VERSION 2
+
+/**
+ * @enum yuarel_match_result
+ * @brief The outcome of matching a URL.
+ */
+enum yuarel_match_result
+{
+    YUAREL_MATCH_NONE,  /**< @brief No rule matched */
+    YUAREL_MATCH_BLOCK, /**< @brief A blocking rule matched, and no exception */
+    YUAREL_MATCH_ALLOW  /**< @brief An exception rule (`@@`) matched */
+};
+
+/**
+ * @struct yuarel_matcher_host
+ * @brief A trie node of the host rules.
+ */
+struct yuarel_matcher_host
+{
+    uint32_t label;       /**< @brief Offset of the lowercase label in the label pool */
+    uint32_t label_len;   /**< @brief Length of the label */
+    uint32_t first_child; /**< @brief Index of the first child, children are sorted by label */
+    uint32_t child_count; /**< @brief Number of children */
+    uint32_t block;       /**< @brief Line of a blocking rule ending at this node, or 0 */
+    uint32_t allow;       /**< @brief Line of an exception rule ending at this node, or 0 */
+    uint32_t first_rule;  /**< @brief Index of the first rule in the host rule index list */
+    uint32_t rule_count;  /**< @brief Number of host rules with a path ending at this node */
+};
+
+/**
+ * @struct yuarel_matcher_state
+ * @brief A state of the keyword automaton.
+ */
+struct yuarel_matcher_state
+{
+    uint32_t first_edge; /**< @brief Index of the first edge, edges are sorted by byte */
+    uint32_t edge_count; /**< @brief Number of edges */
+    uint32_t fail;       /**< @brief State of the longest proper suffix that is a state */
+    uint32_t output;     /**< @brief Nearest state on the fail chain with rules, itself included, or 0 */
+    uint32_t first_rule; /**< @brief Index of the first rule in the rule index list */
+    uint32_t rule_count; /**< @brief Number of rules whose keyword ends at this state */
+};
+
+/**
+ * @struct yuarel_matcher_edge
+ * @brief A transition of the keyword automaton.
+ */
+struct yuarel_matcher_edge
+{
+    uint32_t byte;   /**< @brief The lowercase byte */
+    uint32_t target; /**< @brief The next state */
+};
+
+/**
+ * @struct yuarel_matcher_rule
+ * @brief A path and query rule.
+ */
+struct yuarel_matcher_rule
+{
+    uint32_t pattern;     /**< @brief Offset of the lowercase pattern in the pattern pool */
+    uint16_t pattern_len; /**< @brief Length of the pattern, without anchors */
+    uint16_t keyword_off; /**< @brief Offset of the keyword in the pattern */
+    uint16_t keyword_len; /**< @brief Length of the keyword */
+    uint16_t flags;       /**< @brief Anchor and exception flags */
+    uint32_t line;        /**< @brief Line of the rule in the list */
+};
+
+/**
+ * @struct yuarel_matcher
+ * @brief A loaded rule list. All pointers point into the blob.
+ */
+struct yuarel_matcher
+{
+    void *map;                                 /**< @brief Start of the mapping, NULL if loaded from memory */
+    size_t map_size;                           /**< @brief Size of the mapping */
+    size_t host_count;                         /**< @brief Number of host trie nodes, the root is the first */
+    size_t state_count;                        /**< @brief Number of automaton states, the root is the first */
+    size_t edge_count;                         /**< @brief Number of automaton edges */
+    size_t rule_count;                         /**< @brief Number of path and query rules */
+    const struct yuarel_matcher_host *hosts;   /**< @brief Host trie nodes */
+    const struct yuarel_matcher_state *states; /**< @brief Automaton states */
+    const uint32_t *root;                      /**< @brief Next state from the root for each byte */
+    const struct yuarel_matcher_edge *edges;   /**< @brief Automaton edges */
+    const uint32_t *outputs;                   /**< @brief Rule index lists of the states */
+    const uint32_t *host_rules;                /**< @brief Rule index lists of the host trie nodes */
+    const struct yuarel_matcher_rule *rules;   /**< @brief Path and query rules */
+    const char *labels;                        /**< @brief Label pool */
+    const char *patterns;                      /**< @brief Pattern pool */
+};
+
+/**
+ * @brief Compile a list of Adblock style rules into a blob file.
+ *
+ * Supported rules are host rules `||host^`, which match the host and its
+ * subdomains, and patterns over the path and query such as `/banner/ad`,
+ * `|/ads/` or `.gif|`, with `*` for any run of bytes, `^` for a separator or
+ * the end and `|` anchoring the start or end. Patterns are matched against "/", the
+ * path, and "?" and the query if there is one. A host rule with a path, such as
+ * `||tracker.net/pixel`, matches when the host rule does and its pattern matches
+ * from the start. `@@` turns a rule into an exception. Rules are case
+ * insensitive.
+ *
+ * Comments, element hiding rules, regular expressions and rules with `$`
+ * options are skipped, as are host rules with a port or a `*` in the host and
+ * patterns without any literal byte.
+ *
+ * @param[in] rules_filename The rule list to read.
+ * @param[in] blob_filename The blob file to write.
+ *
+ * @return The number of rules compiled, or -1 on error.
+ */
+extern long yuarel_matcher_compile(const char *rules_filename, const char *blob_filename);
+
+/**
+ * @brief Open a compiled blob file by mapping it into memory.
+ *
+ * @param[out] matcher The matcher to open.
+ * @param[in] filename The blob file to open.
+ *
+ * @return 0 on success, otherwise -1 on error or if the blob is invalid.
+ */
+extern int yuarel_matcher_open(struct yuarel_matcher *matcher, const char *filename);
+
+/**
+ * @brief Use a compiled blob that is already in memory.
+ *
+ * The blob is not copied and must outlive the matcher. It must be aligned to 4
+ * bytes.
+ *
+ * @param[out] matcher The matcher to load.
+ * @param[in] data The blob.
+ * @param[in] size The size of the blob.
+ *
+ * @return 0 on success, otherwise -1 if the blob is invalid.
+ */
+extern int yuarel_matcher_load(struct yuarel_matcher *matcher, const void *data, size_t size);
+
+/**
+ * @brief Unmap a matcher opened by yuarel_matcher_open().
+ *
+ * @param[in,out] matcher The matcher to close.
+ */
+extern void yuarel_matcher_close(struct yuarel_matcher *matcher);
+
+/**
+ * @brief Match a parsed URL against the rules.
+ *
+ * The host is looked up in the host trie, and the path and query are run
+ * through the keyword automaton once. An exception rule wins over any
+ * blocking rule. Does not allocate.
+ *
+ * @param[in] matcher The matcher.
+ * @param[in] url The parsed URL.
+ * @param[out] line Where to store the line of the deciding rule, or NULL.
+ *
+ * @return One of the yuarel_match_result values, or -1 if the matcher or the
+ *         URL is missing.
+ */
+extern int yuarel_matcher_match(const struct yuarel_matcher *matcher, const struct yuarel *url, uint32_t *line);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_YUAREL_MATCHER_H */
@@ -0,0 +1,774 @@
+/**
+ * Copyright (C) 2016,2017 Jack Engqvist Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#define _POSIX_C_SOURCE 200809L
+
+#include "yuarel_psl.h"
+#include "yuarel_internal.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define PSL_MAGIC "YUP\x1a"
+
+/* Node flags */
+#define PSL_RULE 0x01      /* A rule ends at this node */
+#define PSL_WILDCARD 0x02  /* "*." followed by this node is a rule */
+#define PSL_EXCEPTION 0x04 /* "!" followed by this node is a rule */
+
+/* Blob header, followed by the nodes and the label pool */
+struct psl_header
+{
+    char magic[4];
+    uint32_t version;
+    uint32_t node_count;
+    uint32_t label_size;
+    uint32_t rule_count;
+    uint32_t header_size;
+};
+
+/* Trie node used while compiling */
+struct build_node
+{
+    char label[256];
+    size_t label_len;
+    int flags;
+    struct build_node *children;
+    size_t child_count;
+    size_t child_cap;
+};
+
+/**
+ * Compare a host label with a label of the list, ignoring the case of the host.
+ *
+ * @param host: The host label.
+ * @param host_len: The length of the host label.
+ * @param label: The lowercase label of the list.
+ * @param label_len: The length of the label of the list.
+ *
+ * @return: Less than, equal to or greater than 0, like memcmp().
+ */
+static int label_cmp(const char *host, size_t host_len, const char *label, size_t label_len)
+{
+    size_t n = host_len < label_len ? host_len : label_len;
+    size_t i;
+
+    for (i = 0; i < n; i++)
+    {
+        int d = (int)to_lower((unsigned char)host[i]) - (int)(unsigned char)label[i];
+        if (0 != d)
+        {
+            return d;
+        }
+    }
+
+    return (host_len > label_len) - (host_len < label_len);
+}
+
+/**
+ * qsort() callback ordering build nodes by label.
+ *
+ * @param a: The first node.
+ * @param b: The second node.
+ *
+ * @return: Less than, equal to or greater than 0.
+ */
+static int build_node_cmp(const void *a, const void *b)
+{
+    const struct build_node *x = a;
+    const struct build_node *y = b;
+
+    return label_cmp(x->label, x->label_len, y->label, y->label_len);
+}
+
+/**
+ * Find or add the child of a node with a given label.
+ *
+ * @param node: The parent node.
+ * @param label: The lowercase label.
+ * @param len: The length of the label, at most 255.
+ *
+ * @return: The child, or NULL if out of memory.
+ */
+static struct build_node *build_child(struct build_node *node, const char *label, size_t len)
+{
+    struct build_node *child;
+    size_t i;
+
+    for (i = 0; i < node->child_count; i++)
+    {
+        if (0 == label_cmp(label, len, node->children[i].label, node->children[i].label_len))
+        {
+            return &node->children[i];
+        }
+    }
+
+    if (node->child_count == node->child_cap)
+    {
+        size_t cap = node->child_cap ? node->child_cap * 2 : 4;
+        struct build_node *grown = realloc(node->children, cap * sizeof(struct build_node));
+
+        if (NULL == grown)
+        {
+            return NULL;
+        }
+        node->children = grown;
+        node->child_cap = cap;
+    }
+
+    child = &node->children[node->child_count++];
+    memset(child, 0, sizeof(struct build_node));
+    memcpy(child->label, label, len);
+    child->label_len = len;
+    return child;
+}
+
+/**
+ * Free the children of a build node, recursively.
+ *
+ * @param node: The node.
+ */
+static void build_free(struct build_node *node)
+{
+    size_t i;
+
+    for (i = 0; i < node->child_count; i++)
+    {
+        build_free(&node->children[i]);
+    }
+    free(node->children);
+}
+
+/**
+ * Add one rule of the list to the trie.
+ *
+ * @param root: The root node.
+ * @param rule: The rule, lowercase, without comments or whitespace.
+ * @param len: The length of the rule.
+ *
+ * @return: 1 if added, 0 if skipped, or -1 if out of memory.
+ */
+static int build_rule(struct build_node *root, const char *rule, size_t len)
+{
+    struct build_node *node = root;
+    int flag = PSL_RULE;
+    size_t end = len;
+
+    if ('!' == *rule)
+    {
+        /* An exception needs a parent label to leave as the suffix */
+        if (NULL == memchr(rule, '.', len))
+        {
+            return 0;
+        }
+        flag = PSL_EXCEPTION;
+        rule++;
+        end--;
+    }
+    else if (len > 2 && '*' == rule[0] && '.' == rule[1])
+    {
+        flag = PSL_WILDCARD;
+        rule += 2;
+        end -= 2;
+    }
+
+    if (0 == end || NULL != memchr(rule, '*', end) || '.' == rule[0] || '.' == rule[end - 1])
+    {
+        return 0;
+    }
+
+    /* Labels from right to left */
+    while (end > 0)
+    {
+        size_t start = end;
+
+        while (start > 0 && '.' != rule[start - 1])
+        {
+            start--;
+        }
+        if (start == end || end - start > 255)
+        {
+            return 0;
+        }
+
+        node = build_child(node, rule + start, end - start);
+        if (NULL == node)
+        {
+            return -1;
+        }
+        end = (start > 0) ? start - 1 : 0;
+    }
+
+    node->flags |= flag;
+    return 1;
+}
+
+/**
+ * Sort the children of every node, so they can be binary searched.
+ *
+ * @param node: The node to start at.
+ */
+static void build_sort(struct build_node *node)
+{
+    size_t i;
+
+    if (node->child_count > 1)
+    {
+        qsort(node->children, node->child_count, sizeof(struct build_node), build_node_cmp);
+    }
+    for (i = 0; i < node->child_count; i++)
+    {
+        build_sort(&node->children[i]);
+    }
+}
+
+/**
+ * Count the nodes and label bytes below a node, the node included.
+ *
+ * @param node: The node.
+ * @param label_size: Incremented by the label bytes.
+ *
+ * @return: The number of nodes.
+ */
+static size_t build_count(const struct build_node *node, size_t *label_size)
+{
+    size_t count = 1;
+    size_t i;
+
+    *label_size += node->label_len;
+    for (i = 0; i < node->child_count; i++)
+    {
+        count += build_count(&node->children[i], label_size);
+    }
+    return count;
+}
+
+/**
+ * @brief Compile a public_suffix_list.dat file into a blob file.
+ *
+ * Both the ICANN and the private sections are included. Labels are stored in
+ * lowercase, rules with a wildcard other than as their leftmost label are
+ * skipped.
+ *
+ * @param[in] dat_filename The public suffix list to read.
+ * @param[in] blob_filename The blob file to write.
+ *
+ * @return The number of rules compiled, or -1 on error.
+ */
+long yuarel_psl_compile(const char *dat_filename, const char *blob_filename)
+{
+    struct build_node root;
+    struct psl_header header;
+    struct yuarel_psl_node *nodes = NULL;
+    const struct build_node **queue = NULL;
+    char *labels = NULL;
+    char line[1024];
+    size_t node_count, label_size = 0;
+    size_t head, tail, label_off = 0;
+    long rules = 0;
+    long rc = -1;
+    FILE *in;
+    FILE *out = NULL;
+
+    if (NULL == dat_filename || NULL == blob_filename)
+    {
+        return -1;
+    }
+
+    in = fopen(dat_filename, "r");
+    if (NULL == in)
+    {
+        return -1;
+    }
+
+    memset(&root, 0, sizeof(root));
+
+    while (NULL != fgets(line, sizeof(line), in))
+    {
+        char *rule = line;
+        size_t len = 0;
+        int added;
+
+        /* The rule is the first word of the line */
+        while (' ' == *rule || '\t' == *rule)
+        {
+            rule++;
+        }
+        while ('\0' != rule[len] && ' ' != rule[len] && '\t' != rule[len] && '\r' != rule[len] && '\n' != rule[len])
+        {
+            rule[len] = (char)to_lower((unsigned char)rule[len]);
+            len++;
+        }
+        if (0 == len || 0 == strncmp(rule, "//", 2))
+        {
+            continue;
+        }
+
+        added = build_rule(&root, rule, len);
+        if (added < 0)
+        {
+            goto out;
+        }
+        rules += added;
+    }
+
+    build_sort(&root);
+    node_count = build_count(&root, &label_size);
+    if (node_count > UINT32_MAX || label_size > UINT32_MAX)
+    {
+        goto out;
+    }
+
+    nodes = calloc(node_count, sizeof(struct yuarel_psl_node));
+    queue = malloc(node_count * sizeof(*queue));
+    labels = malloc(label_size + 1);
+    if (NULL == nodes || NULL == queue || NULL == labels)
+    {
+        goto out;
+    }
+
+    /* Breadth first, so the children of every node are next to each other */
+    queue[0] = &root;
+    tail = 1;
+    for (head = 0; head < tail; head++)
+    {
+        const struct build_node *b = queue[head];
+        size_t i;
+
+        if (b->child_count > UINT16_MAX)
+        {
+            goto out;
+        }
+
+        memcpy(labels + label_off, b->label, b->label_len);
+        nodes[head].label = (uint32_t)label_off;
+        nodes[head].label_len = (uint8_t)b->label_len;
+        nodes[head].flags = (uint8_t)b->flags;
+        nodes[head].child_count = (uint16_t)b->child_count;
+        nodes[head].first_child = (uint32_t)tail;
+        label_off += b->label_len;
+
+        for (i = 0; i < b->child_count; i++)
+        {
+            queue[tail++] = &b->children[i];
+        }
+    }
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, PSL_MAGIC, 4);
+    header.version = YUAREL_PSL_VERSION;
+    header.node_count = (uint32_t)node_count;
+    header.label_size = (uint32_t)label_size;
+    header.rule_count = (uint32_t)rules;
+    header.header_size = sizeof(struct psl_header);
+
+    out = fopen(blob_filename, "wb");
+    if (NULL == out ||
+        1 != fwrite(&header, sizeof(header), 1, out) ||
+        node_count != fwrite(nodes, sizeof(struct yuarel_psl_node), node_count, out) ||
+        label_size != fwrite(labels, 1, label_size, out))
+    {
+        goto out;
+    }
+
+    rc = rules;
+
+out:
+    if (NULL != out && 0 != fclose(out))
+    {
+        rc = -1;
+    }
+    fclose(in);
+    build_free(&root);
+    free(nodes);
+    free(queue);
+    free(labels);
+    return rc;
+}
+
+/**
+ * @brief Use a compiled blob that is already in memory.
+ *
+ * The blob is not copied and must outlive the list. It must be aligned to 4
+ * bytes.
+ *
+ * @param[out] psl The list to load.
+ * @param[in] data The blob.
+ * @param[in] size The size of the blob.
+ *
+ * @return 0 on success, otherwise -1 if the blob is invalid.
+ */
+int yuarel_psl_load(struct yuarel_psl *psl, const void *data, size_t size)
+{
+    const unsigned char *blob = data;
+    struct psl_header header;
+    size_t i;
+
+    if (NULL == psl || NULL == data || size < sizeof(struct psl_header))
+    {
+        return -1;
+    }
+
+    memset(psl, 0, sizeof(struct yuarel_psl));
+
+    memcpy(&header, blob, sizeof(header));
+    if (0 != memcmp(header.magic, PSL_MAGIC, 4) ||
+        YUAREL_PSL_VERSION != header.version ||
+        sizeof(struct psl_header) != header.header_size ||
+        0 == header.node_count ||
+        size != sizeof(header) + (size_t)header.node_count * sizeof(struct yuarel_psl_node) + header.label_size)
+    {
+        return -1;
+    }
+
+    psl->node_count = header.node_count;
+    psl->nodes = (const struct yuarel_psl_node *)(blob + sizeof(header));
+    psl->labels = (const char *)(psl->nodes + psl->node_count);
+
+    /* Children always follow their parent, so lookups terminate */
+    for (i = 0; i < psl->node_count; i++)
+    {
+        const struct yuarel_psl_node *n = &psl->nodes[i];
+
+        if ((size_t)n->label + n->label_len > header.label_size ||
+            (n->child_count > 0 && (n->first_child <= i || (size_t)n->first_child + n->child_count > psl->node_count)))
+        {
+            memset(psl, 0, sizeof(struct yuarel_psl));
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Open a compiled blob file by mapping it into memory.
+ *
+ * @param[out] psl The list to open.
+ * @param[in] filename The blob file to open.
+ *
+ * @return 0 on success, otherwise -1 on error or if the blob is invalid.
+ */
+int yuarel_psl_open(struct yuarel_psl *psl, const char *filename)
+{
+    struct stat st;
+    void *map;
+    int fd;
+
+    if (NULL == psl || NULL == filename)
+    {
+        return -1;
+    }
+
+    memset(psl, 0, sizeof(struct yuarel_psl));
+
+    fd = open(filename, O_RDONLY);
+    if (fd < 0)
+    {
+        return -1;
+    }
+
+    if (0 != fstat(fd, &st) || (size_t)st.st_size < sizeof(struct psl_header))
+    {
+        close(fd);
+        return -1;
+    }
+
+    map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (MAP_FAILED == map)
+    {
+        return -1;
+    }
+
+    if (0 != yuarel_psl_load(psl, map, (size_t)st.st_size))
+    {
+        munmap(map, (size_t)st.st_size);
+        return -1;
+    }
+
+    psl->map = map;
+    psl->map_size = (size_t)st.st_size;
+    return 0;
+}
+
+/**
+ * @brief Unmap a list opened by yuarel_psl_open().
+ *
+ * @param[in,out] psl The list to close.
+ */
+void yuarel_psl_close(struct yuarel_psl *psl)
+{
+    if (NULL == psl)
+    {
+        return;
+    }
+
+    if (NULL != psl->map)
+    {
+        munmap(psl->map, psl->map_size);
+    }
+    memset(psl, 0, sizeof(struct yuarel_psl));
+}
+
+/**
+ * Find the child of a node with a given label.
+ *
+ * @param psl: The list.
+ * @param node: The parent node.
+ * @param label: The host label, in any case.
+ * @param len: The length of the label.
+ *
+ * @return: The child, or NULL if there is none.
+ */
+static const struct yuarel_psl_node *find_child(const struct yuarel_psl *psl, const struct yuarel_psl_node *node,
+                                                const char *label, size_t len)
+{
+    size_t lo = node->first_child;
+    size_t hi = lo + node->child_count;
+
+    while (lo < hi)
+    {
+        size_t mid = lo + (hi - lo) / 2;
+        const struct yuarel_psl_node *child = &psl->nodes[mid];
+        int cmp = label_cmp(label, len, psl->labels + child->label, child->label_len);
+
+        if (0 == cmp)
+        {
+            return child;
+        }
+        if (cmp < 0)
+        {
+            hi = mid;
+        }
+        else
+        {
+            lo = mid + 1;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Check that a hostname can have a public suffix, and strip a trailing dot.
+ *
+ * @param host: The hostname.
+ * @param len: The length of the hostname, updated without the trailing dot.
+ *
+ * @return: 0 if valid, or -1 if empty, with an empty label or an IP address.
+ */
+static int check_host(const char *host, size_t *len)
+{
+    size_t n = *len;
+    size_t i;
+    int numeric = 1;
+
+    if (n > 0 && '.' == host[n - 1])
+    {
+        n--;
+    }
+    if (0 == n || '.' == host[0] || NULL != memchr(host, ':', n))
+    {
+        return -1;
+    }
+
+    for (i = 0; i + 1 < n; i++)
+    {
+        if ('.' == host[i] && '.' == host[i + 1])
+        {
+            return -1;
+        }
+    }
+
+    /* A numeric last label means an IPv4 address */
+    for (i = n; i > 0 && '.' != host[i - 1]; i--)
+    {
+        if (host[i - 1] < '0' || host[i - 1] > '9')
+        {
+            numeric = 0;
+        }
+    }
+    if (numeric)
+    {
+        return -1;
+    }
+
+    *len = n;
+    return 0;
+}
+
+/**
+ * Count the labels of the public suffix of a valid hostname.
+ *
+ * Walks the trie from the last label. A wildcard matches any one label, an
+ * exception cuts its own label off the suffix and overrides everything else.
+ *
+ * @param psl: The list.
+ * @param host: The hostname, checked by check_host().
+ * @param len: The length of the hostname.
+ *
+ * @return: The number of labels in the public suffix, at least 1.
+ */
+static size_t suffix_labels(const struct yuarel_psl *psl, const char *host, size_t len)
+{
+    const struct yuarel_psl_node *node = psl->nodes;
+    size_t suffix = 1;
+    size_t depth = 0;
+    size_t end = len;
+
+    while (end > 0)
+    {
+        const struct yuarel_psl_node *child;
+        size_t start = end;
+
+        while (start > 0 && '.' != host[start - 1])
+        {
+            start--;
+        }
+
+        if (node->flags & PSL_WILDCARD)
+        {
+            suffix = depth + 1;
+        }
+
+        child = find_child(psl, node, host + start, end - start);
+        if (NULL == child)
+        {
+            break;
+        }
+        if (child->flags & PSL_EXCEPTION)
+        {
+            suffix = depth;
+            break;
+        }
+
+        depth++;
+        if (child->flags & PSL_RULE)
+        {
+            suffix = depth;
+        }
+        node = child;
+        end = (start > 0) ? start - 1 : 0;
+    }
+
+    return suffix;
+}
+
+/**
+ * Find the start of the last labels of a hostname.
+ *
+ * @param host: The hostname.
+ * @param len: The length of the hostname.
+ * @param labels: The number of labels to include.
+ *
+ * @return: The offset of the first of the labels, or -1 if the hostname has
+ *          fewer labels.
+ */
+static long labels_start(const char *host, size_t len, size_t labels)
+{
+    size_t i = len;
+
+    while (i > 0)
+    {
+        if ('.' == host[i - 1] && 0 == --labels)
+        {
+            return (long)i;
+        }
+        i--;
+    }
+
+    return (1 == labels) ? 0 : -1;
+}
+
+/**
+ * @brief Find the public suffix (eTLD) of a hostname.
+ *
+ * Unlisted top level domains are public suffixes of their own, as by the
+ * implicit "*" rule. Labels are compared case insensitively, and one trailing
+ * dot is ignored.
+ *
+ * @param[in] psl The list.
+ * @param[in] host The hostname, e.g. `url->host`. Need not be null terminated.
+ * @param[in] len The length of the hostname.
+ * @param[out] suffix Where to store the offset and length of the suffix in `host`.
+ *
+ * @return 0 on success, otherwise -1 if the host is empty, has an empty label
+ *         or is an IP address.
+ */
+int yuarel_public_suffix(const struct yuarel_psl *psl, const char *host, size_t len, struct yuarel_span *suffix)
+{
+    long start;
+
+    if (NULL == psl || NULL == psl->nodes || NULL == host || NULL == suffix || -1 == check_host(host, &len))
+    {
+        return -1;
+    }
+
+    start = labels_start(host, len, suffix_labels(psl, host, len));
+    if (start < 0)
+    {
+        return -1;
+    }
+
+    suffix->off = (size_t)start;
+    suffix->len = len - (size_t)start;
+    return 0;
+}
+
+/**
+ * @brief Find the registrable domain (eTLD+1) of a hostname.
+ *
+ * The registrable domain is the public suffix and one more label, e.g.
+ * "example.co.uk" for "www.example.co.uk". Runs in time proportional to the
+ * length of the hostname, and does not allocate.
+ *
+ * @param[in] psl The list.
+ * @param[in] host The hostname, e.g. `url->host`. Need not be null terminated.
+ * @param[in] len The length of the hostname.
+ * @param[out] domain Where to store the offset and length of the domain in `host`.
+ *
+ * @return 0 on success, otherwise -1 if the host is invalid or is a public
+ *         suffix itself.
+ */
+int yuarel_registrable_domain(const struct yuarel_psl *psl, const char *host, size_t len, struct yuarel_span *domain)
+{
+    long start;
+
+    if (NULL == psl || NULL == psl->nodes || NULL == host || NULL == domain || -1 == check_host(host, &len))
+    {
+        return -1;
+    }
+
+    start = labels_start(host, len, suffix_labels(psl, host, len) + 1);
+    if (start < 0)
+    {
+        return -1;
+    }
+
+    domain->off = (size_t)start;
+    domain->len = len - (size_t)start;
+    return 0;
+}
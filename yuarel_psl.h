@@ -0,0 +1,157 @@
+/**
+ * @file yuarel_psl.h
+ * @brief Public suffix aware registrable domain (eTLD+1) lookup.
+ *
+ * A public_suffix_list.dat file is compiled once into a blob holding a trie of
+ * reversed host labels ("com" -> "example" -> ...). Children of a node are
+ * stored next to each other and sorted, so each label is found with a binary
+ * search. Wildcard ("*.ck") and exception ("!www.ck") rules are flags on the
+ * nodes. The blob is position independent and is used directly from an mmap'd
+ * file, and lookups never allocate.
+ *
+ * @copyright Copyright (C) 2016 Jack Engqvist Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef INC_YUAREL_PSL_H
+#define INC_YUAREL_PSL_H
+
+#include "yuarel.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** @brief Format version written to and accepted from the blob header */
+#define YUAREL_PSL_VERSION 1
+
+/**
+ * @struct yuarel_psl_node
+ * @brief A trie node in a compiled public suffix list.
+ */
+struct yuarel_psl_node
+{
+    uint32_t label;       /**< @brief Offset of the lowercase label in the label pool */
+    uint8_t label_len;    /**< @brief Length of the label */
+    uint8_t flags;        /**< @brief Rule flags of the node */
+    uint16_t child_count; /**< @brief Number of children */
+    uint32_t first_child; /**< @brief Index of the first child, children are sorted by label */
+};
+
+/**
+ * @struct yuarel_psl
+ * @brief A loaded public suffix list. All pointers point into the blob.
+ */
+struct yuarel_psl
+{
+    void *map;                            /**< @brief Start of the mapping, NULL if loaded from memory */
+    size_t map_size;                      /**< @brief Size of the mapping */
+    size_t node_count;                    /**< @brief Number of trie nodes, the root is the first */
+    const struct yuarel_psl_node *nodes;  /**< @brief Trie nodes */
+    const char *labels;                   /**< @brief Label pool */
+};
+
+/**
+ * @brief Compile a public_suffix_list.dat file into a blob file.
+ *
+ * Both the ICANN and the private sections are included. Labels are stored in
+ * lowercase, rules with a wildcard other than as their leftmost label are
+ * skipped.
+ *
+ * @param[in] dat_filename The public suffix list to read.
+ * @param[in] blob_filename The blob file to write.
+ *
+ * @return The number of rules compiled, or -1 on error.
+ */
+extern long yuarel_psl_compile(const char *dat_filename, const char *blob_filename);
+
+/**
+ * @brief Open a compiled blob file by mapping it into memory.
+ *
+ * @param[out] psl The list to open.
+ * @param[in] filename The blob file to open.
+ *
+ * @return 0 on success, otherwise -1 on error or if the blob is invalid.
+ */
+extern int yuarel_psl_open(struct yuarel_psl *psl, const char *filename);
+
+/**
+ * @brief Use a compiled blob that is already in memory.
+ *
+ * The blob is not copied and must outlive the list. It must be aligned to 4
+ * bytes.
+ *
+ * @param[out] psl The list to load.
+ * @param[in] data The blob.
+ * @param[in] size The size of the blob.
+ *
+ * @return 0 on success, otherwise -1 if the blob is invalid.
+ */
+extern int yuarel_psl_load(struct yuarel_psl *psl, const void *data, size_t size);
+
+/**
+ * @brief Unmap a list opened by yuarel_psl_open().
+ *
+ * @param[in,out] psl The list to close.
+ */
+extern void yuarel_psl_close(struct yuarel_psl *psl);
+
+/**
+ * @brief Find the public suffix (eTLD) of a hostname.
+ *
+ * Unlisted top level domains are public suffixes of their own, as by the
+ * implicit "*" rule. Labels are compared case insensitively, and one trailing
+ * dot is ignored.
+ *
+ * @param[in] psl The list.
+ * @param[in] host The hostname, e.g. `url->host`. Need not be null terminated.
+ * @param[in] len The length of the hostname.
+ * @param[out] suffix Where to store the offset and length of the suffix in `host`.
+ *
+ * @return 0 on success, otherwise -1 if the host is empty, has an empty label
+ *         or is an IP address.
+ */
+extern int yuarel_public_suffix(const struct yuarel_psl *psl, const char *host, size_t len, struct yuarel_span *suffix);
+
+/**
+ * @brief Find the registrable domain (eTLD+1) of a hostname.
+ *
+ * The registrable domain is the public suffix and one more label, e.g.
+ * "example.co.uk" for "www.example.co.uk". Runs in time proportional to the
+ * length of the hostname, and does not allocate.
+ *
+ * @param[in] psl The list.
+ * @param[in] host The hostname, e.g. `url->host`. Need not be null terminated.
+ * @param[in] len The length of the hostname.
+ * @param[out] domain Where to store the offset and length of the domain in `host`.
+ *
+ * @return 0 on success, otherwise -1 if the host is invalid or is a public
+ *         suffix itself.
+ */
+extern int yuarel_registrable_domain(const struct yuarel_psl *psl, const char *host, size_t len, struct yuarel_span *domain);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_YUAREL_PSL_H */
@@ -0,0 +1,1043 @@
+/**
+ * Copyright (C) 2016,2017 Jack Engqvist Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "yuarel_query.h"
+#include "yuarel_internal.h"
+#include <string.h>
+
+#ifdef YUAREL_X86
+#include <immintrin.h>
+#endif
+
+/* Largest number of parameters sorted by insertion */
+#define INSERTION_MAX 16
+
+/* Radix sort levels before falling back to insertion sort, bounds the stack use */
+#define RADIX_MAX_DEPTH 16
+
+/**
+ * Normalize the percent escapes of a null terminated string in place.
+ *
+ * Escapes of unreserved characters are decoded, other escapes get uppercase
+ * hex digits. A '%' that does not start an escape is kept as it is.
+ *
+ * @param str: The string to normalize.
+ * @param delimiter: The parameter delimiter, which is never decoded.
+ *
+ * @return: The new length of the string.
+ */
+static size_t normalize_escapes(char *str, char delimiter)
+{
+    static const char hex[] = "0123456789ABCDEF";
+    char *read = str;
+    char *write = str;
+
+    while ('\0' != *read)
+    {
+        int hi, lo;
+
+        if ('%' != *read || (hi = hex_value(read[1])) < 0 || (lo = hex_value(read[2])) < 0)
+        {
+            *write++ = *read++;
+            continue;
+        }
+
+        if (is_unreserved((unsigned char)(hi << 4 | lo)) && (hi << 4 | lo) != (unsigned char)delimiter)
+        {
+            *write++ = (char)(hi << 4 | lo);
+        }
+        else
+        {
+            *write++ = '%';
+            *write++ = hex[hi];
+            *write++ = hex[lo];
+        }
+        read += 3;
+    }
+
+    *write = '\0';
+    return write - str;
+}
+
+/**
+ * Get a byte of a key in the compacted query. The key ends at '=', at the
+ * delimiter or at the end of the query, which all read as 0.
+ *
+ * @param key: The key.
+ * @param i: The offset of the byte, at most the length of the key.
+ * @param delimiter: The parameter delimiter.
+ *
+ * @return: The byte, or 0 at the end of the key.
+ */
+static inline int key_byte(const char *key, size_t i, char delimiter)
+{
+    char c = key[i];
+
+    return ('=' == c || delimiter == c) ? 0 : (unsigned char)c;
+}
+
+/**
+ * Compare two parameters by key from a given offset on. Equal keys are
+ * ordered by their position in the query, which keeps the sort stable.
+ *
+ * @param a: The first parameter.
+ * @param b: The second parameter.
+ * @param depth: The offset of the first byte to compare.
+ * @param delimiter: The parameter delimiter.
+ *
+ * @return: Less than, equal to or greater than 0.
+ */
+static int param_cmp(const struct yuarel_param *a, const struct yuarel_param *b, size_t depth, char delimiter)
+{
+    size_t i;
+
+    for (i = depth;; i++)
+    {
+        int ca = key_byte(a->key, i, delimiter);
+        int cb = key_byte(b->key, i, delimiter);
+
+        if (ca != cb)
+        {
+            return ca - cb;
+        }
+        if (0 == ca)
+        {
+            break;
+        }
+    }
+
+    return (a->key > b->key) - (a->key < b->key);
+}
+
+/**
+ * Insertion sort parameters whose keys share their first `depth` bytes.
+ *
+ * @param params: The parameters.
+ * @param count: The number of parameters.
+ * @param depth: The length of the shared prefix.
+ * @param delimiter: The parameter delimiter.
+ */
+static void insertion_sort(struct yuarel_param *params, size_t count, size_t depth, char delimiter)
+{
+    size_t i;
+
+    for (i = 1; i < count; i++)
+    {
+        struct yuarel_param param = params[i];
+        size_t j = i;
+
+        while (j > 0 && param_cmp(&params[j - 1], &param, depth, delimiter) > 0)
+        {
+            params[j] = params[j - 1];
+            j--;
+        }
+        params[j] = param;
+    }
+}
+
+/**
+ * Sort parameters whose keys share their first `depth` bytes, with an in
+ * place most significant digit radix sort (American flag sort).
+ *
+ * The permutation is not stable by itself, so keys that end at the same byte
+ * are put back in query order by insertion sort.
+ *
+ * @param params: The parameters.
+ * @param count: The number of parameters.
+ * @param depth: The length of the shared prefix.
+ * @param delimiter: The parameter delimiter.
+ */
+static void radix_sort(struct yuarel_param *params, size_t count, size_t depth, char delimiter)
+{
+    size_t bucket_count[256];
+    size_t bucket_start[256];
+    size_t bucket_next[256];
+    size_t i;
+    int b;
+
+    if (count <= INSERTION_MAX || depth >= RADIX_MAX_DEPTH)
+    {
+        insertion_sort(params, count, depth, delimiter);
+        return;
+    }
+
+    memset(bucket_count, 0, sizeof(bucket_count));
+    for (i = 0; i < count; i++)
+    {
+        bucket_count[key_byte(params[i].key, depth, delimiter)]++;
+    }
+
+    bucket_start[0] = 0;
+    bucket_next[0] = 0;
+    for (b = 1; b < 256; b++)
+    {
+        bucket_start[b] = bucket_start[b - 1] + bucket_count[b - 1];
+        bucket_next[b] = bucket_start[b];
+    }
+
+    /* Move every parameter into its bucket, following the cycles */
+    for (b = 0; b < 256; b++)
+    {
+        while (bucket_next[b] < bucket_start[b] + bucket_count[b])
+        {
+            struct yuarel_param param = params[bucket_next[b]];
+            int c = key_byte(param.key, depth, delimiter);
+
+            while (c != b)
+            {
+                struct yuarel_param swap = params[bucket_next[c]];
+                params[bucket_next[c]++] = param;
+                param = swap;
+                c = key_byte(param.key, depth, delimiter);
+            }
+            params[bucket_next[b]++] = param;
+        }
+    }
+
+    /* Keys that ended here are equal */
+    insertion_sort(params, bucket_count[0], depth, delimiter);
+
+    for (b = 1; b < 256; b++)
+    {
+        if (bucket_count[b] > 1)
+        {
+            radix_sort(params + bucket_start[b], bucket_count[b], depth + 1, delimiter);
+        }
+    }
+}
+
+/**
+ * Get the length of a parameter in the compacted query.
+ *
+ * @param param: The parameter.
+ * @param delimiter: The parameter delimiter.
+ *
+ * @return: The length of the key, '=' and value.
+ */
+static size_t param_len(const struct yuarel_param *param, char delimiter)
+{
+    const char *p = param->key;
+
+    while ('\0' != *p && delimiter != *p)
+    {
+        p++;
+    }
+    return p - param->key;
+}
+
+/**
+ * Reverse a range of bytes.
+ *
+ * @param start: The first byte.
+ * @param end: Just past the last byte.
+ */
+static void reverse(char *start, char *end)
+{
+    while (start + 1 < end)
+    {
+        char c = *start;
+        *start++ = *--end;
+        *end = c;
+    }
+}
+
+/**
+ * Reverse a range of parameters.
+ *
+ * @param start: The first parameter.
+ * @param end: Just past the last parameter.
+ */
+static void reverse_params(struct yuarel_param *start, struct yuarel_param *end)
+{
+    while (start + 1 < end)
+    {
+        struct yuarel_param param = *start;
+        *start++ = *--end;
+        *end = param;
+    }
+}
+
+/**
+ * Swap two adjacent runs of parameters in a query by three reversals, and
+ * move their pointers along. Every parameter is followed by a delimiter.
+ *
+ * @param params: The parameters of both runs, in query order.
+ * @param left: The number of parameters in the first run, at least 1.
+ * @param count: The number of parameters in both runs, more than `left`.
+ * @param end: Just past the delimiter of the last parameter.
+ */
+static void swap_runs(struct yuarel_param *params, size_t left, size_t count, char *end)
+{
+    char *start = params[0].key;
+    char *mid = params[left].key;
+    size_t i;
+
+    reverse(start, mid);
+    reverse(mid, end);
+    reverse(start, end);
+
+    for (i = 0; i < count; i++)
+    {
+        size_t shift = (i < left) ? (size_t)(end - mid) : (size_t)(mid - start);
+        int forward = (i < left);
+
+        params[i].key = forward ? params[i].key + shift : params[i].key - shift;
+        if (NULL != params[i].val)
+        {
+            params[i].val = forward ? params[i].val + shift : params[i].val - shift;
+        }
+    }
+
+    reverse_params(params, params + left);
+    reverse_params(params + left, params + count);
+    reverse_params(params, params + count);
+}
+
+/**
+ * Merge two adjacent sorted runs of parameters in a query without a buffer.
+ *
+ * One run is cut in half, the other at the same key, and the middle parts are
+ * swapped, which leaves two smaller merges. Every byte is moved O(log n)
+ * times. Parameters are always compared with their position in the query as
+ * the last resort, which keeps the merge stable.
+ *
+ * @param params: The parameters of both runs, in query order.
+ * @param left: The number of parameters in the first run.
+ * @param count: The number of parameters in both runs.
+ * @param end: Just past the delimiter of the last parameter.
+ * @param delimiter: The parameter delimiter.
+ */
+static void merge_runs(struct yuarel_param *params, size_t left, size_t count, char *end, char delimiter)
+{
+    size_t cut1, cut2, lo, hi, mid;
+
+    if (0 == left || left == count)
+    {
+        return;
+    }
+    if (2 == count)
+    {
+        if (param_cmp(&params[1], &params[0], 0, delimiter) < 0)
+        {
+            swap_runs(params, 1, 2, end);
+        }
+        return;
+    }
+
+    if (left > count - left)
+    {
+        /* Halve the first run, find its middle in the second */
+        cut1 = left / 2;
+        lo = left;
+        hi = count;
+        while (lo < hi)
+        {
+            mid = lo + (hi - lo) / 2;
+            if (param_cmp(&params[mid], &params[cut1], 0, delimiter) < 0)
+            {
+                lo = mid + 1;
+            }
+            else
+            {
+                hi = mid;
+            }
+        }
+        cut2 = lo;
+    }
+    else
+    {
+        /* Halve the second run, find its middle in the first */
+        cut2 = left + (count - left) / 2;
+        lo = 0;
+        hi = left;
+        while (lo < hi)
+        {
+            mid = lo + (hi - lo) / 2;
+            if (param_cmp(&params[mid], &params[cut2], 0, delimiter) < 0)
+            {
+                lo = mid + 1;
+            }
+            else
+            {
+                hi = mid;
+            }
+        }
+        cut1 = lo;
+    }
+
+    if (cut1 < left && left < cut2)
+    {
+        swap_runs(params + cut1, left - cut1, cut2 - cut1, (cut2 < count) ? params[cut2].key : end);
+    }
+    mid = cut1 + (cut2 - left);
+
+    merge_runs(params, cut1, mid, (mid < count) ? params[mid].key : end, delimiter);
+    merge_runs(params + mid, cut2 - mid, count - mid, end, delimiter);
+}
+
+/**
+ * Sort the parameters of a compacted query in place, with a merge sort that
+ * merges without a buffer. Every parameter must be followed by a delimiter.
+ *
+ * @param params: The parameters, in query order.
+ * @param count: The number of parameters.
+ * @param end: Just past the delimiter of the last parameter.
+ * @param delimiter: The parameter delimiter.
+ */
+static void merge_sort(struct yuarel_param *params, size_t count, char *end, char delimiter)
+{
+    size_t left = count / 2;
+
+    if (count < 2)
+    {
+        return;
+    }
+
+    merge_sort(params, left, params[left].key, delimiter);
+    merge_sort(params + left, count - left, end, delimiter);
+    merge_runs(params, left, count, end, delimiter);
+}
+
+/**
+ * Append bytes to an output buffer, counting the bytes that do not fit.
+ *
+ * @param out: The buffer.
+ * @param size: The size of the buffer.
+ * @param used: The number of bytes appended so far, updated.
+ * @param str: The bytes to append.
+ * @param len: The number of bytes.
+ */
+static void out_put(char *out, size_t size, size_t *used, const char *str, size_t len)
+{
+    size_t avail = (*used + 1 < size) ? size - 1 - *used : 0;
+
+    if (avail > 0)
+    {
+        memcpy(out + *used, str, (len < avail) ? len : avail);
+    }
+    *used += len;
+}
+
+/**
+ * @brief Rewrite a query string into its canonical form.
+ *
+ * The query is split with yuarel_parse_query(), using `params` as scratch
+ * space. In every key and value, escapes of unreserved characters are decoded
+ * (e.g. "%7E" becomes "~") and the hex digits of other escapes are
+ * uppercased. Empty parameters are dropped, and the rest are sorted stably by
+ * key, so parameters with the same key keep their order. When writing to
+ * `out`, small queries are insertion sorted and larger ones radix sorted, then
+ * copied in one pass. In place, the parameters are merge sorted within the
+ * query by swapping runs, which moves every byte O(log^2 n) times.
+ *
+ * When `out` is NULL the canonical query replaces `query` in place. Otherwise
+ * it is written to `out` and, like snprintf(), truncated to fit `out_size`.
+ * In both cases `query` is modified.
+ *
+ * @warning: Modifies the input string as part of the parsing process.
+ *
+ * @param[in,out] query The query string to canonicalize. It will be modified.
+ * @param[in] delimiter The character that separates key-value pairs in the query.
+ * @param[out] params Scratch space for the parsed parameters.
+ * @param[in] max_params The number of entries in `params`.
+ * @param[out] out The buffer to write to, or NULL to rewrite `query`.
+ * @param[in] out_size The size of `out`.
+ *
+ * @return The length of the canonical query, or -1 if it has more than
+ *         `max_params` parameters or on error.
+ */
+long yuarel_query_canonicalize(char *query, char delimiter, struct yuarel_param *params, int max_params, char *out, size_t out_size)
+{
+    const char *p;
+    char *write;
+    size_t count = 0;
+    size_t used = 0;
+    size_t total;
+    int n = 1;
+    int i;
+
+    if (NULL == query || NULL == params || '\0' == delimiter || (NULL == out && out_size > 0))
+    {
+        return -1;
+    }
+
+    /* Fail before modifying anything if the parameters do not fit */
+    for (p = strchr(query, delimiter); NULL != p; p = strchr(p + 1, delimiter))
+    {
+        n++;
+    }
+    if (n > max_params)
+    {
+        return -1;
+    }
+
+    n = ('\0' != *query) ? yuarel_parse_query(query, delimiter, params, max_params) : 0;
+
+    /* Normalize and compact in query order, nothing grows so it never overtakes */
+    write = query;
+    for (i = 0; i < n; i++)
+    {
+        size_t key_len = normalize_escapes(params[i].key, delimiter);
+        char *key = params[i].key;
+        char *val = params[i].val;
+
+        if (0 == key_len && NULL == val)
+        {
+            continue;
+        }
+
+        if (count > 0)
+        {
+            *write++ = delimiter;
+        }
+        memmove(write, key, key_len);
+        params[count].key = write;
+        write += key_len;
+
+        if (NULL != val)
+        {
+            size_t val_len = normalize_escapes(val, delimiter);
+
+            *write++ = '=';
+            memmove(write, val, val_len);
+            params[count].val = write;
+            write += val_len;
+        }
+        else
+        {
+            params[count].val = NULL;
+        }
+        count++;
+    }
+    *write = '\0';
+    total = write - query;
+
+    if (NULL == out)
+    {
+        /* The terminator stands in for the delimiter after the last parameter */
+        if (count > 0)
+        {
+            query[total] = delimiter;
+            merge_sort(params, count, query + total + 1, delimiter);
+            query[total] = '\0';
+        }
+        return (long)total;
+    }
+
+    radix_sort(params, count, 0, delimiter);
+
+    /* Copy the parameters in order, counting what does not fit */
+    for (i = 0; (size_t)i < count; i++)
+    {
+        if (i > 0)
+        {
+            out_put(out, out_size, &used, &delimiter, 1);
+        }
+        out_put(out, out_size, &used, params[i].key, param_len(&params[i], delimiter));
+    }
+    if (out_size > 0)
+    {
+        out[(used < out_size) ? used : out_size - 1] = '\0';
+    }
+
+    return (long)total;
+}
+
+/* Node flags */
+#define NODE_EXACT 0x01       /* An exact rule ends here */
+#define NODE_EXACT_DROP 0x02  /* ... and drops the parameter */
+#define NODE_PREFIX 0x04      /* A prefix rule ends here */
+#define NODE_PREFIX_DROP 0x08 /* ... and drops the parameter */
+
+/**
+ * @brief Initialize an empty query filter.
+ *
+ * The filter compiles its rules into `nodes`, which is provided by the caller
+ * and must outlive the filter. Each rule takes at most one node per byte of
+ * its pattern. A default action of YUAREL_FILTER_KEEP makes the rules a deny
+ * list, YUAREL_FILTER_DROP an allow list.
+ *
+ * @param[out] filter The filter to initialize.
+ * @param[in] nodes Storage for the trie nodes.
+ * @param[in] max_nodes The number of entries in `nodes`, at least 1.
+ * @param[in] default_action The action for keys that match no rule.
+ *
+ * @return 0 on success, otherwise -1 on error.
+ */
+int yuarel_filter_init(struct yuarel_filter *filter, struct yuarel_filter_node *nodes, size_t max_nodes, int default_action)
+{
+    if (NULL == filter || NULL == nodes || 0 == max_nodes || max_nodes > UINT32_MAX)
+    {
+        return -1;
+    }
+
+    memset(&nodes[0], 0, sizeof(struct yuarel_filter_node));
+    filter->nodes = nodes;
+    filter->node_count = 1;
+    filter->max_nodes = max_nodes;
+    filter->default_action = (YUAREL_FILTER_DROP == default_action) ? YUAREL_FILTER_DROP : YUAREL_FILTER_KEEP;
+    return 0;
+}
+
+/**
+ * @brief Add a rule to a query filter.
+ *
+ * An exact rule takes precedence over prefix rules, and a longer prefix over
+ * a shorter one. Adding the same rule again replaces its action.
+ *
+ * @param[in,out] filter The filter.
+ * @param[in] pattern The key or key prefix, e.g. "utm_".
+ * @param[in] match YUAREL_FILTER_EXACT or YUAREL_FILTER_PREFIX.
+ * @param[in] action YUAREL_FILTER_KEEP or YUAREL_FILTER_DROP.
+ *
+ * @return 0 on success, otherwise -1 if out of nodes or on error.
+ */
+int yuarel_filter_add(struct yuarel_filter *filter, const char *pattern, int match, int action)
+{
+    size_t node = 0;
+    const char *p;
+    int drop = (YUAREL_FILTER_DROP == action);
+
+    if (NULL == filter || NULL == filter->nodes || NULL == pattern)
+    {
+        return -1;
+    }
+
+    /* Make sure the whole path exists before changing anything */
+    for (p = pattern; '\0' != *p; p++)
+    {
+        uint32_t child = filter->nodes[node].child;
+
+        while (0 != child && filter->nodes[child].c != (unsigned char)*p)
+        {
+            child = filter->nodes[child].sibling;
+        }
+
+        if (0 == child)
+        {
+            struct yuarel_filter_node *n;
+
+            if (filter->node_count == filter->max_nodes)
+            {
+                return -1;
+            }
+            child = (uint32_t)filter->node_count++;
+            n = &filter->nodes[child];
+            memset(n, 0, sizeof(struct yuarel_filter_node));
+            n->c = (unsigned char)*p;
+            n->sibling = filter->nodes[node].child;
+            filter->nodes[node].child = child;
+        }
+
+        node = child;
+    }
+
+    if (YUAREL_FILTER_PREFIX == match)
+    {
+        filter->nodes[node].flags &= ~NODE_PREFIX_DROP;
+        filter->nodes[node].flags |= NODE_PREFIX | (drop ? NODE_PREFIX_DROP : 0);
+    }
+    else
+    {
+        filter->nodes[node].flags &= ~NODE_EXACT_DROP;
+        filter->nodes[node].flags |= NODE_EXACT | (drop ? NODE_EXACT_DROP : 0);
+    }
+
+    return 0;
+}
+
+/**
+ * Look up the action for a key in a filter.
+ *
+ * @param filter: The filter.
+ * @param key: The key, ending at '=', the delimiter or the end of the query.
+ * @param delimiter: The parameter delimiter.
+ * @param len: Set to the length of the key.
+ *
+ * @return: YUAREL_FILTER_KEEP or YUAREL_FILTER_DROP.
+ */
+static int filter_lookup(const struct yuarel_filter *filter, const char *key, char delimiter, size_t *len)
+{
+    const struct yuarel_filter_node *nodes = filter->nodes;
+    int action = filter->default_action;
+    uint32_t node = 0;
+    const char *p = key;
+
+    for (;;)
+    {
+        int flags = nodes[node].flags;
+        uint32_t child;
+
+        if (flags & NODE_PREFIX)
+        {
+            action = (flags & NODE_PREFIX_DROP) ? YUAREL_FILTER_DROP : YUAREL_FILTER_KEEP;
+        }
+
+        if ('\0' == *p || '=' == *p || delimiter == *p)
+        {
+            if (flags & NODE_EXACT)
+            {
+                action = (flags & NODE_EXACT_DROP) ? YUAREL_FILTER_DROP : YUAREL_FILTER_KEEP;
+            }
+            break;
+        }
+
+        child = nodes[node].child;
+        while (0 != child && nodes[child].c != (unsigned char)*p)
+        {
+            child = nodes[child].sibling;
+        }
+        if (0 == child)
+        {
+            break;
+        }
+
+        node = child;
+        p++;
+    }
+
+    /* Skip the rest of a key that left the trie */
+    while ('\0' != *p && '=' != *p && delimiter != *p)
+    {
+        p++;
+    }
+
+    *len = p - key;
+    return action;
+}
+
+/**
+ * @brief Remove query parameters according to a filter, in place.
+ *
+ * Each key is looked up with a single walk of the trie, and the parameters
+ * that are kept are moved together in the same pass. Keys are compared as
+ * they appear in the query, without decoding.
+ *
+ * @warning: Modifies the input string.
+ *
+ * @param[in] filter The filter.
+ * @param[in,out] query The null terminated query string. It will be modified.
+ * @param[in] delimiter The character that separates key-value pairs in the query.
+ *
+ * @return The new length of the query, or -1 on error.
+ */
+long yuarel_query_filter(const struct yuarel_filter *filter, char *query, char delimiter)
+{
+    char *read = query;
+    char *write = query;
+    size_t kept = 0;
+
+    if (NULL == filter || NULL == filter->nodes || NULL == query || '\0' == delimiter)
+    {
+        return -1;
+    }
+
+    while ('\0' != *read)
+    {
+        size_t key_len;
+        int action = filter_lookup(filter, read, delimiter, &key_len);
+        char *end = read + key_len;
+
+        if ('=' == *end)
+        {
+            end = strchr(end, delimiter);
+            end = (NULL != end) ? end : read + strlen(read);
+        }
+
+        if (YUAREL_FILTER_KEEP == action)
+        {
+            if (kept++ > 0)
+            {
+                *write++ = delimiter;
+            }
+            if (write != read)
+            {
+                memmove(write, read, end - read);
+            }
+            write += end - read;
+        }
+
+        read = ('\0' != *end) ? end + 1 : end;
+    }
+
+    *write = '\0';
+    return write - query;
+}
+
+/**
+ * Append bytes to the query of a builder, if they fit before the null
+ * terminator. The length grows either way, so once bytes do not fit, no
+ * later bytes are written.
+ *
+ * @param builder: The builder.
+ * @param str: The bytes to append.
+ * @param len: The number of bytes, at most 3.
+ */
+static inline void builder_put(struct yuarel_query_builder *builder, const char *str, size_t len)
+{
+    if (builder->len + len < builder->size)
+    {
+        memcpy(builder->buf + builder->len, str, len);
+    }
+    builder->len += len;
+}
+
+/**
+ * Percent-encode one byte into the query of a builder.
+ *
+ * @param builder: The builder.
+ * @param c: The byte.
+ */
+static inline __attribute__((always_inline)) void encode_byte(struct yuarel_query_builder *builder, unsigned char c)
+{
+    static const char hex[] = "0123456789ABCDEF";
+    char escape[3];
+
+    if (builder->len + 3 < builder->size)
+    {
+        /* Room for an escape, write directly */
+        char *out = builder->buf + builder->len;
+
+        if (is_unreserved(c))
+        {
+            out[0] = (char)c;
+            builder->len++;
+        }
+        else if (' ' == c && (builder->flags & YUAREL_BUILD_PLUS))
+        {
+            out[0] = '+';
+            builder->len++;
+        }
+        else
+        {
+            out[0] = '%';
+            out[1] = hex[c >> 4];
+            out[2] = hex[c & 0xf];
+            builder->len += 3;
+        }
+    }
+    else if (is_unreserved(c))
+    {
+        escape[0] = (char)c;
+        builder_put(builder, escape, 1);
+    }
+    else if (' ' == c && (builder->flags & YUAREL_BUILD_PLUS))
+    {
+        builder_put(builder, "+", 1);
+    }
+    else
+    {
+        escape[0] = '%';
+        escape[1] = hex[c >> 4];
+        escape[2] = hex[c & 0xf];
+        builder_put(builder, escape, 3);
+    }
+}
+
+#ifdef YUAREL_X86
+#define QUERY_SSE2 __attribute__((target("sse2")))
+
+/**
+ * Find the bytes of a block that are not unreserved characters.
+ *
+ * @param v: The block.
+ *
+ * @return: A mask with one bit per byte to encode.
+ */
+static inline QUERY_SSE2 int unsafe_mask(__m128i v)
+{
+    /* Signed compares, so bytes of 0x80 and above are never in range */
+    const __m128i lower = _mm_or_si128(v, _mm_set1_epi8(0x20));
+    __m128i safe = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)),
+                                 _mm_cmplt_epi8(lower, _mm_set1_epi8('z' + 1)));
+
+    safe = _mm_or_si128(safe, _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('0' - 1)),
+                                            _mm_cmplt_epi8(v, _mm_set1_epi8('9' + 1))));
+    /* '-' and '.' are adjacent */
+    safe = _mm_or_si128(safe, _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('-' - 1)),
+                                            _mm_cmplt_epi8(v, _mm_set1_epi8('.' + 1))));
+    safe = _mm_or_si128(safe, _mm_cmpeq_epi8(v, _mm_set1_epi8('_')));
+    safe = _mm_or_si128(safe, _mm_cmpeq_epi8(v, _mm_set1_epi8('~')));
+
+    return ~_mm_movemask_epi8(safe) & 0xffff;
+}
+
+/**
+ * Percent-encode a key or value into the query of a builder, copying the
+ * runs of unreserved characters a block at a time.
+ *
+ * @param builder: The builder.
+ * @param str: The bytes to encode.
+ * @param len: The number of bytes.
+ */
+static QUERY_SSE2 void encode_sse2(struct yuarel_query_builder *builder, const char *str, size_t len)
+{
+    size_t i = 0;
+
+    while (i < len)
+    {
+        /* Copy a whole block when there is room for it, up to its first byte to encode */
+        if (i + 16 <= len && builder->len + 16 < builder->size)
+        {
+            __m128i v = _mm_loadu_si128((const __m128i *)(str + i));
+            int unsafe = unsafe_mask(v);
+            int run = (0 == unsafe) ? 16 : __builtin_ctz(unsafe);
+
+            _mm_storeu_si128((__m128i *)(builder->buf + builder->len), v);
+            builder->len += run;
+            i += run;
+            if (16 == run)
+            {
+                continue;
+            }
+        }
+        encode_byte(builder, (unsigned char)str[i++]);
+    }
+}
+#endif
+
+/**
+ * Percent-encode a key or value into the query of a builder.
+ *
+ * @param builder: The builder.
+ * @param str: The bytes to encode.
+ * @param len: The number of bytes.
+ */
+static void builder_encode(struct yuarel_query_builder *builder, const char *str, size_t len)
+{
+    size_t i;
+
+#ifdef YUAREL_X86
+    /* Most keys and values are shorter than a block, and skip the kernel lookup */
+    if (len >= 16 && yuarel_simd_level() >= YUAREL_ISA_SSE2)
+    {
+        encode_sse2(builder, str, len);
+        return;
+    }
+#endif
+    for (i = 0; i < len; i++)
+    {
+        encode_byte(builder, (unsigned char)str[i]);
+    }
+}
+
+/**
+ * @brief Start building a query string.
+ *
+ * Nothing is allocated. With a `size` of 0, `buf` may be NULL and the builder
+ * only measures the query.
+ *
+ * @param[out] builder The builder to initialize.
+ * @param[out] buf The buffer to write the query to.
+ * @param[in] size The size of `buf`.
+ * @param[in] flags 0 or YUAREL_BUILD_PLUS.
+ *
+ * @return 0 on success, otherwise -1 on error.
+ */
+int yuarel_query_builder_init(struct yuarel_query_builder *builder, char *buf, size_t size, int flags)
+{
+    if (NULL == builder || (NULL == buf && size > 0))
+    {
+        return -1;
+    }
+
+    builder->buf = buf;
+    builder->size = size;
+    builder->len = 0;
+    builder->end = 0;
+    builder->count = 0;
+    builder->flags = flags;
+
+    if (size > 0)
+    {
+        buf[0] = '\0';
+    }
+    return 0;
+}
+
+/**
+ * @brief Append a key-value pair to a query string.
+ *
+ * The key and the value are percent-encoded, except for unreserved characters
+ * (RFC 3986 section 2.3). Runs of those are found and copied 16 bytes at a
+ * time unless yuarel_simd_kernel() is "scalar". The '&' and '=' separators
+ * are added as needed.
+ *
+ * Once a parameter does not fit, this and every later parameter are only
+ * measured, so `buf` never holds part of a parameter.
+ *
+ * @param[in,out] builder The builder.
+ * @param[in] key The key, null terminated.
+ * @param[in] value The value, null terminated, or NULL for a key without '='.
+ *
+ * @return 0 if the parameter fit in the buffer, otherwise -1 if it did not or on error.
+ */
+int yuarel_query_builder_add(struct yuarel_query_builder *builder, const char *key, const char *value)
+{
+    if (NULL == builder || NULL == key)
+    {
+        return -1;
+    }
+
+    if (builder->count++ > 0)
+    {
+        builder_put(builder, "&", 1);
+    }
+    builder_encode(builder, key, strlen(key));
+    if (NULL != value)
+    {
+        builder_put(builder, "=", 1);
+        builder_encode(builder, value, strlen(value));
+    }
+
+    if (builder->len < builder->size)
+    {
+        builder->end = builder->len;
+        return 0;
+    }
+    return -1;
+}
+
+/**
+ * @brief Finish a query string.
+ *
+ * Null terminates the buffer after the last parameter that fit. Like
+ * snprintf(), the return value is the length of the whole query, so a return
+ * value of `size` or more means that it was truncated, and a buffer of the
+ * return value plus one bytes is needed.
+ *
+ * @param[in,out] builder The builder.
+ *
+ * @return The length of the whole query, or -1 on error.
+ */
+long yuarel_query_builder_finish(struct yuarel_query_builder *builder)
+{
+    if (NULL == builder)
+    {
+        return -1;
+    }
+
+    if (builder->size > 0)
+    {
+        builder->buf[builder->end] = '\0';
+    }
+    return (long)builder->len;
+}
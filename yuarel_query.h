@@ -0,0 +1,226 @@
+/**
+ * @file yuarel_query.h
+ * @brief Query string transformations built on yuarel_parse_query().
+ *
+ * Functions that rewrite a whole query string, e.g. into a canonical form for
+ * cache keys or without tracking parameters. Like the rest of the library they work in place or write into a
+ * caller buffer, and never allocate on the heap.
+ *
+ * @copyright Copyright (C) 2016 Jack Engqvist Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef INC_YUAREL_QUERY_H
+#define INC_YUAREL_QUERY_H
+
+#include "yuarel.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief Rewrite a query string into its canonical form.
+ *
+ * The query is split with yuarel_parse_query(), using `params` as scratch
+ * space. In every key and value, escapes of unreserved characters are decoded
+ * (e.g. "%7E" becomes "~") and the hex digits of other escapes are
+ * uppercased. Empty parameters are dropped, and the rest are sorted stably by
+ * key, so parameters with the same key keep their order. When writing to
+ * `out`, small queries are insertion sorted and larger ones radix sorted, then
+ * copied in one pass. In place, the parameters are merge sorted within the
+ * query by swapping runs, which moves every byte O(log^2 n) times.
+ *
+ * When `out` is NULL the canonical query replaces `query` in place. Otherwise
+ * it is written to `out` and, like snprintf(), truncated to fit `out_size`.
+ * In both cases `query` is modified.
+ *
+ * @warning: Modifies the input string as part of the parsing process.
+ *
+ * @param[in,out] query The query string to canonicalize. It will be modified.
+ * @param[in] delimiter The character that separates key-value pairs in the query.
+ * @param[out] params Scratch space for the parsed parameters.
+ * @param[in] max_params The number of entries in `params`.
+ * @param[out] out The buffer to write to, or NULL to rewrite `query`.
+ * @param[in] out_size The size of `out`.
+ *
+ * @return The length of the canonical query, or -1 if it has more than
+ *         `max_params` parameters or on error.
+ */
+extern long yuarel_query_canonicalize(char *query, char delimiter, struct yuarel_param *params, int max_params, char *out, size_t out_size);
+
+/** @brief Filter action: keep the parameter */
+#define YUAREL_FILTER_KEEP 0
+
+/** @brief Filter action: remove the parameter */
+#define YUAREL_FILTER_DROP 1
+
+/** @brief Filter rule match: the key equals the pattern */
+#define YUAREL_FILTER_EXACT 0
+
+/** @brief Filter rule match: the key starts with the pattern */
+#define YUAREL_FILTER_PREFIX 1
+
+/**
+ * @struct yuarel_filter_node
+ * @brief A node of the key trie of a query filter, for one byte of a pattern.
+ */
+struct yuarel_filter_node
+{
+    uint32_t child;   /**< @brief Index of the first child, 0 if none */
+    uint32_t sibling; /**< @brief Index of the next sibling, 0 if none */
+    unsigned char c;  /**< @brief The byte of the pattern */
+    unsigned char flags; /**< @brief Rules that end at this node */
+};
+
+/**
+ * @struct yuarel_filter
+ * @brief A compiled set of query parameter rules.
+ */
+struct yuarel_filter
+{
+    struct yuarel_filter_node *nodes; /**< @brief Trie nodes, the root is the first */
+    size_t node_count;                /**< @brief Number of nodes in use */
+    size_t max_nodes;                 /**< @brief Number of nodes available */
+    int default_action;               /**< @brief Action for keys that match no rule */
+};
+
+/**
+ * @brief Initialize an empty query filter.
+ *
+ * The filter compiles its rules into `nodes`, which is provided by the caller
+ * and must outlive the filter. Each rule takes at most one node per byte of
+ * its pattern. A default action of YUAREL_FILTER_KEEP makes the rules a deny
+ * list, YUAREL_FILTER_DROP an allow list.
+ *
+ * @param[out] filter The filter to initialize.
+ * @param[in] nodes Storage for the trie nodes.
+ * @param[in] max_nodes The number of entries in `nodes`, at least 1.
+ * @param[in] default_action The action for keys that match no rule.
+ *
+ * @return 0 on success, otherwise -1 on error.
+ */
+extern int yuarel_filter_init(struct yuarel_filter *filter, struct yuarel_filter_node *nodes, size_t max_nodes, int default_action);
+
+/**
+ * @brief Add a rule to a query filter.
+ *
+ * An exact rule takes precedence over prefix rules, and a longer prefix over
+ * a shorter one. Adding the same rule again replaces its action.
+ *
+ * @param[in,out] filter The filter.
+ * @param[in] pattern The key or key prefix, e.g. "utm_".
+ * @param[in] match YUAREL_FILTER_EXACT or YUAREL_FILTER_PREFIX.
+ * @param[in] action YUAREL_FILTER_KEEP or YUAREL_FILTER_DROP.
+ *
+ * @return 0 on success, otherwise -1 if out of nodes or on error.
+ */
+extern int yuarel_filter_add(struct yuarel_filter *filter, const char *pattern, int match, int action);
+
+/**
+ * @brief Remove query parameters according to a filter, in place.
+ *
+ * Each key is looked up with a single walk of the trie, and the parameters
+ * that are kept are moved together in the same pass. Keys are compared as
+ * they appear in the query, without decoding.
+ *
+ * @warning: Modifies the input string.
+ *
+ * @param[in] filter The filter.
+ * @param[in,out] query The null terminated query string. It will be modified.
+ * @param[in] delimiter The character that separates key-value pairs in the query.
+ *
+ * @return The new length of the query, or -1 on error.
+ */
+extern long yuarel_query_filter(const struct yuarel_filter *filter, char *query, char delimiter);
+
+/** @brief Builder flag: encode spaces as '+' instead of "%20" */
+#define YUAREL_BUILD_PLUS 0x01
+
+/**
+ * @struct yuarel_query_builder
+ * @brief Builds a query string into a buffer provided by the caller.
+ */
+struct yuarel_query_builder
+{
+    char *buf;   /**< @brief The buffer to write to */
+    size_t size; /**< @brief The size of `buf` */
+    size_t len;  /**< @brief The length of the whole query, also the part that did not fit */
+    size_t end;  /**< @brief The end of the last parameter that fit in `buf` */
+    int count;   /**< @brief The number of parameters added */
+    int flags;   /**< @brief YUAREL_BUILD_* flags */
+};
+
+/**
+ * @brief Start building a query string.
+ *
+ * Nothing is allocated. With a `size` of 0, `buf` may be NULL and the builder
+ * only measures the query.
+ *
+ * @param[out] builder The builder to initialize.
+ * @param[out] buf The buffer to write the query to.
+ * @param[in] size The size of `buf`.
+ * @param[in] flags 0 or YUAREL_BUILD_PLUS.
+ *
+ * @return 0 on success, otherwise -1 on error.
+ */
+extern int yuarel_query_builder_init(struct yuarel_query_builder *builder, char *buf, size_t size, int flags);
+
+/**
+ * @brief Append a key-value pair to a query string.
+ *
+ * The key and the value are percent-encoded, except for unreserved characters
+ * (RFC 3986 section 2.3). Runs of those are found and copied 16 bytes at a
+ * time unless yuarel_simd_kernel() is "scalar". The '&' and '=' separators
+ * are added as needed.
+ *
+ * Once a parameter does not fit, this and every later parameter are only
+ * measured, so `buf` never holds part of a parameter.
+ *
+ * @param[in,out] builder The builder.
+ * @param[in] key The key, null terminated.
+ * @param[in] value The value, null terminated, or NULL for a key without '='.
+ *
+ * @return 0 if the parameter fit in the buffer, otherwise -1 if it did not or on error.
+ */
+extern int yuarel_query_builder_add(struct yuarel_query_builder *builder, const char *key, const char *value);
+
+/**
+ * @brief Finish a query string.
+ *
+ * Null terminates the buffer after the last parameter that fit. Like
+ * snprintf(), the return value is the length of the whole query, so a return
+ * value of `size` or more means that it was truncated, and a buffer of the
+ * return value plus one bytes is needed.
+ *
+ * @param[in,out] builder The builder.
+ *
+ * @return The length of the whole query, or -1 on error.
+ */
+extern long yuarel_query_builder_finish(struct yuarel_query_builder *builder);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_YUAREL_QUERY_H */
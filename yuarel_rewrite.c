@@ -0,0 +1,1429 @@
+/**
+ * Copyright (C) 2016,2017 Jack Engqvist Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "yuarel_rewrite.h"
+#include <stdint.h>
+#include <string.h>
+
+/* Instructions of a compiled pattern */
+enum
+{
+    OP_BYTE,  /* Consume `arg` */
+    OP_SET,   /* Consume a byte of set `arg` */
+    OP_BOL,   /* Assert the start of the text */
+    OP_EOL,   /* Assert the end of the text */
+    OP_SPLIT, /* Continue at `x`, and with lower priority at `y` */
+    OP_JMP,   /* Continue at `x` */
+    OP_SAVE,  /* Record the position in capture slot `arg` */
+    OP_MATCH  /* The pattern matched */
+};
+
+/* Nodes of a parsed pattern */
+enum
+{
+    NODE_EMPTY,
+    NODE_BYTE,
+    NODE_SET,
+    NODE_BOL,
+    NODE_EOL,
+    NODE_CAT,
+    NODE_ALT,
+    NODE_STAR,
+    NODE_PLUS,
+    NODE_QUEST,
+    NODE_GROUP
+};
+
+/* DFA state flags */
+#define STATE_ACCEPT 1     /* A match ends at the current byte */
+#define STATE_ACCEPT_END 2 /* A match ends here if the text does */
+#define STATE_DEAD 4       /* No match is possible any more */
+
+/* Marks a capture group that did not take part in the match */
+#define NONE ((size_t)-1)
+
+#define MAX_NODES 128
+#define MAX_DEPTH 32
+
+/* Limits of the backtracker, beyond them the Pike VM is used */
+#define MAX_VISITED 32768
+#define MAX_JOBS 512
+#define BIT(pc) ((uint64_t)1 << (pc))
+
+struct rewrite_node
+{
+    int type;
+    int lazy;
+    int a;
+    int b;
+    int value;
+};
+
+struct rewrite_parser
+{
+    const char *str;
+    struct yuarel_rewrite_pattern *p;
+    struct rewrite_node nodes[MAX_NODES];
+    int count;
+    int groups;
+    int depth;
+};
+
+/* A component to match, possibly in two parts, as "/" and the path */
+struct rewrite_text
+{
+    const char *str[2];
+    size_t len[2];
+};
+
+struct rewrite_thread
+{
+    int pc;
+    size_t caps[2 * YUAREL_REWRITE_MAX_GROUPS];
+};
+
+struct rewrite_list
+{
+    int count;
+    struct rewrite_thread threads[YUAREL_REWRITE_MAX_INSTS];
+};
+
+/* A branch to try, or a capture slot to restore when `pc` is -1 */
+struct rewrite_job
+{
+    int pc;
+    int slot;
+    size_t pos;
+};
+
+struct rewrite_writer
+{
+    char *buf;
+    size_t size;
+    size_t len;
+};
+
+/**
+ * Check if a byte is in a set.
+ *
+ * @param set: The set, as a 256 bit bitmap.
+ * @param c: The byte.
+ *
+ * @return: 1 if the byte is in the set, otherwise 0.
+ */
+static inline int set_has(const unsigned char *set, unsigned char c)
+{
+    return (set[c >> 3] >> (c & 7)) & 1;
+}
+
+/**
+ * Add a range of bytes to a set.
+ *
+ * @param set: The set, as a 256 bit bitmap.
+ * @param lo: The first byte of the range.
+ * @param hi: The last byte of the range.
+ */
+static void set_range(unsigned char *set, int lo, int hi)
+{
+    for (; lo <= hi; lo++)
+    {
+        set[lo >> 3] |= (unsigned char)(1 << (lo & 7));
+    }
+}
+
+/**
+ * Add the bytes of a class escape such as `\d` to a set.
+ *
+ * @param set: The set, as a 256 bit bitmap.
+ * @param c: The character following the backslash.
+ *
+ * @return: 0 if `c` names a class, otherwise -1.
+ */
+static int set_escape(unsigned char *set, char c)
+{
+    unsigned char bits[32];
+    int i;
+
+    memset(bits, 0, sizeof(bits));
+    switch (c)
+    {
+    case 'd':
+    case 'D':
+        set_range(bits, '0', '9');
+        break;
+    case 'w':
+    case 'W':
+        set_range(bits, '0', '9');
+        set_range(bits, 'A', 'Z');
+        set_range(bits, 'a', 'z');
+        set_range(bits, '_', '_');
+        break;
+    case 's':
+    case 'S':
+        set_range(bits, '\t', '\r');
+        set_range(bits, ' ', ' ');
+        break;
+    default:
+        return -1;
+    }
+
+    for (i = 0; i < 32; i++)
+    {
+        set[i] |= ('a' <= c) ? bits[i] : (unsigned char)~bits[i];
+    }
+    return 0;
+}
+
+/**
+ * Store a set in the pattern, sharing it with an identical one.
+ *
+ * @param p: The pattern.
+ * @param set: The set, as a 256 bit bitmap.
+ *
+ * @return: The index of the set, or -1 if there are too many sets.
+ */
+static int add_set(struct yuarel_rewrite_pattern *p, const unsigned char *set)
+{
+    int i;
+
+    for (i = 0; i < p->set_count; i++)
+    {
+        if (0 == memcmp(p->sets[i], set, 32))
+        {
+            return i;
+        }
+    }
+    if (YUAREL_REWRITE_MAX_SETS == p->set_count)
+    {
+        return -1;
+    }
+    memcpy(p->sets[p->set_count], set, 32);
+    return p->set_count++;
+}
+
+/**
+ * Allocate a node of the parse tree.
+ *
+ * @param ps: The parser.
+ * @param type: The type of the node.
+ * @param a: The first child, or the value of a leaf.
+ * @param b: The second child.
+ *
+ * @return: The index of the node, or -1 if there are too many nodes.
+ */
+static int new_node(struct rewrite_parser *ps, int type, int a, int b)
+{
+    struct rewrite_node *n;
+
+    if (a < 0 || b < 0 || MAX_NODES == ps->count)
+    {
+        return -1;
+    }
+    n = &ps->nodes[ps->count];
+    n->type = type;
+    n->lazy = 0;
+    n->a = a;
+    n->b = b;
+    n->value = a;
+    return ps->count++;
+}
+
+/**
+ * Parse a bracket expression, after the '['.
+ *
+ * @param ps: The parser.
+ *
+ * @return: The index of the node, or -1 on error.
+ */
+static int parse_class(struct rewrite_parser *ps)
+{
+    unsigned char set[32];
+    int negate = 0;
+    int first = 1;
+    int i;
+
+    memset(set, 0, sizeof(set));
+    if ('^' == *ps->str)
+    {
+        negate = 1;
+        ps->str++;
+    }
+
+    while (']' != *ps->str || first)
+    {
+        unsigned char lo, hi;
+
+        first = 0;
+        if ('\0' == *ps->str)
+        {
+            return -1;
+        }
+        if ('\\' == *ps->str)
+        {
+            ps->str++;
+            if ('\0' == *ps->str)
+            {
+                return -1;
+            }
+            if (0 == set_escape(set, *ps->str))
+            {
+                ps->str++;
+                continue;
+            }
+        }
+        lo = (unsigned char)*ps->str++;
+        hi = lo;
+
+        if ('-' == ps->str[0] && ']' != ps->str[1] && '\0' != ps->str[1])
+        {
+            ps->str++;
+            if ('\\' == *ps->str)
+            {
+                ps->str++;
+            }
+            if ('\0' == *ps->str)
+            {
+                return -1;
+            }
+            hi = (unsigned char)*ps->str++;
+            if (hi < lo)
+            {
+                return -1;
+            }
+        }
+        set_range(set, lo, hi);
+    }
+    ps->str++;
+
+    if (negate)
+    {
+        for (i = 0; i < 32; i++)
+        {
+            set[i] = (unsigned char)~set[i];
+        }
+    }
+    return new_node(ps, NODE_SET, add_set(ps->p, set), 0);
+}
+
+static int parse_alt(struct rewrite_parser *ps);
+
+/**
+ * Parse a single atom: a byte, a set, an anchor or a group.
+ *
+ * @param ps: The parser.
+ *
+ * @return: The index of the node, or -1 on error.
+ */
+static int parse_atom(struct rewrite_parser *ps)
+{
+    unsigned char set[32];
+    char c = *ps->str++;
+
+    switch (c)
+    {
+    case '(':
+    {
+        int group = 0;
+        int inner;
+
+        if ('?' == ps->str[0] && ':' == ps->str[1])
+        {
+            ps->str += 2;
+        }
+        else if (YUAREL_REWRITE_MAX_GROUPS == ps->groups)
+        {
+            return -1;
+        }
+        else
+        {
+            group = ps->groups++;
+        }
+
+        if (MAX_DEPTH == ps->depth)
+        {
+            return -1;
+        }
+        ps->depth++;
+        inner = parse_alt(ps);
+        ps->depth--;
+        if (inner < 0 || ')' != *ps->str)
+        {
+            return -1;
+        }
+        ps->str++;
+        if (0 == group)
+        {
+            return inner;
+        }
+        inner = new_node(ps, NODE_GROUP, inner, 0);
+        if (inner >= 0)
+        {
+            ps->nodes[inner].value = group;
+        }
+        return inner;
+    }
+    case '[':
+        return parse_class(ps);
+    case '.':
+        memset(set, 0xff, sizeof(set));
+        return new_node(ps, NODE_SET, add_set(ps->p, set), 0);
+    case '^':
+        return new_node(ps, NODE_BOL, 0, 0);
+    case '$':
+        return new_node(ps, NODE_EOL, 0, 0);
+    case '\\':
+        c = *ps->str++;
+        if ('\0' == c)
+        {
+            return -1;
+        }
+        memset(set, 0, sizeof(set));
+        if (0 == set_escape(set, c))
+        {
+            return new_node(ps, NODE_SET, add_set(ps->p, set), 0);
+        }
+        return new_node(ps, NODE_BYTE, (unsigned char)c, 0);
+    case '*':
+    case '+':
+    case '?':
+        /* Nothing to repeat */
+        return -1;
+    default:
+        return new_node(ps, NODE_BYTE, (unsigned char)c, 0);
+    }
+}
+
+/**
+ * Parse an atom followed by any number of quantifiers.
+ *
+ * @param ps: The parser.
+ *
+ * @return: The index of the node, or -1 on error.
+ */
+static int parse_repeat(struct rewrite_parser *ps)
+{
+    int n = parse_atom(ps);
+
+    while (n >= 0 && ('*' == *ps->str || '+' == *ps->str || '?' == *ps->str))
+    {
+        char q = *ps->str++;
+
+        n = new_node(ps, ('*' == q) ? NODE_STAR : ('+' == q) ? NODE_PLUS : NODE_QUEST, n, 0);
+        if (n >= 0 && '?' == *ps->str)
+        {
+            ps->nodes[n].lazy = 1;
+            ps->str++;
+        }
+    }
+    return n;
+}
+
+/**
+ * Parse a sequence of atoms, up to a '|', a ')' or the end of the pattern.
+ *
+ * @param ps: The parser.
+ *
+ * @return: The index of the node, or -1 on error.
+ */
+static int parse_cat(struct rewrite_parser *ps)
+{
+    int n = -1;
+
+    while ('\0' != *ps->str && '|' != *ps->str && ')' != *ps->str)
+    {
+        int next = parse_repeat(ps);
+
+        if (next < 0)
+        {
+            return -1;
+        }
+        n = (n < 0) ? next : new_node(ps, NODE_CAT, n, next);
+        if (n < 0)
+        {
+            return -1;
+        }
+    }
+    return (n < 0) ? new_node(ps, NODE_EMPTY, 0, 0) : n;
+}
+
+/**
+ * Parse alternatives separated by '|'.
+ *
+ * @param ps: The parser.
+ *
+ * @return: The index of the node, or -1 on error.
+ */
+static int parse_alt(struct rewrite_parser *ps)
+{
+    int n = parse_cat(ps);
+
+    while (n >= 0 && '|' == *ps->str)
+    {
+        ps->str++;
+        n = new_node(ps, NODE_ALT, n, parse_cat(ps));
+    }
+    return n;
+}
+
+/**
+ * Append an instruction to the program.
+ *
+ * @param p: The pattern.
+ * @param op: The instruction.
+ * @param arg: The argument of the instruction.
+ *
+ * @return: The index of the instruction, or -1 if the program is full.
+ */
+static int put_inst(struct yuarel_rewrite_pattern *p, int op, int arg)
+{
+    struct yuarel_rewrite_inst *inst;
+
+    if (YUAREL_REWRITE_MAX_INSTS == p->inst_count)
+    {
+        return -1;
+    }
+    inst = &p->insts[p->inst_count];
+    inst->op = (unsigned char)op;
+    inst->arg = (unsigned char)arg;
+    inst->x = 0;
+    inst->y = 0;
+    return p->inst_count++;
+}
+
+/**
+ * Set the targets of a split, swapping them for a lazy quantifier.
+ *
+ * @param p: The pattern.
+ * @param pc: The index of the split.
+ * @param x: The preferred target of a greedy quantifier.
+ * @param y: The other target.
+ * @param lazy: 1 if the quantifier is lazy.
+ */
+static void set_split(struct yuarel_rewrite_pattern *p, int pc, int x, int y, int lazy)
+{
+    p->insts[pc].x = (unsigned char)(lazy ? y : x);
+    p->insts[pc].y = (unsigned char)(lazy ? x : y);
+}
+
+/**
+ * Emit the instructions of a node of the parse tree.
+ *
+ * @param ps: The parser.
+ * @param n: The index of the node.
+ *
+ * @return: 0 on success, or -1 if the program is full.
+ */
+static int emit(struct rewrite_parser *ps, int n)
+{
+    struct yuarel_rewrite_pattern *p = ps->p;
+    const struct rewrite_node *node = &ps->nodes[n];
+    int pc, jmp;
+
+    switch (node->type)
+    {
+    case NODE_EMPTY:
+        return 0;
+    case NODE_BYTE:
+        return (put_inst(p, OP_BYTE, node->value) < 0) ? -1 : 0;
+    case NODE_SET:
+        return (put_inst(p, OP_SET, node->value) < 0) ? -1 : 0;
+    case NODE_BOL:
+        return (put_inst(p, OP_BOL, 0) < 0) ? -1 : 0;
+    case NODE_EOL:
+        return (put_inst(p, OP_EOL, 0) < 0) ? -1 : 0;
+    case NODE_CAT:
+        return (-1 == emit(ps, node->a) || -1 == emit(ps, node->b)) ? -1 : 0;
+    case NODE_ALT:
+        pc = put_inst(p, OP_SPLIT, 0);
+        if (pc < 0 || -1 == emit(ps, node->a) || (jmp = put_inst(p, OP_JMP, 0)) < 0)
+        {
+            return -1;
+        }
+        set_split(p, pc, pc + 1, p->inst_count, 0);
+        if (-1 == emit(ps, node->b))
+        {
+            return -1;
+        }
+        p->insts[jmp].x = (unsigned char)p->inst_count;
+        return 0;
+    case NODE_STAR:
+        pc = put_inst(p, OP_SPLIT, 0);
+        if (pc < 0 || -1 == emit(ps, node->a) || (jmp = put_inst(p, OP_JMP, 0)) < 0)
+        {
+            return -1;
+        }
+        p->insts[jmp].x = (unsigned char)pc;
+        set_split(p, pc, pc + 1, p->inst_count, node->lazy);
+        return 0;
+    case NODE_PLUS:
+        pc = p->inst_count;
+        if (-1 == emit(ps, node->a) || (jmp = put_inst(p, OP_SPLIT, 0)) < 0)
+        {
+            return -1;
+        }
+        set_split(p, jmp, pc, p->inst_count, node->lazy);
+        return 0;
+    case NODE_QUEST:
+        pc = put_inst(p, OP_SPLIT, 0);
+        if (pc < 0 || -1 == emit(ps, node->a))
+        {
+            return -1;
+        }
+        set_split(p, pc, pc + 1, p->inst_count, node->lazy);
+        return 0;
+    case NODE_GROUP:
+        if (put_inst(p, OP_SAVE, 2 * node->value) < 0 || -1 == emit(ps, node->a) ||
+            put_inst(p, OP_SAVE, 2 * node->value + 1) < 0)
+        {
+            return -1;
+        }
+        return 0;
+    }
+    return -1;
+}
+
+/**
+ * Check if a byte is consumed by an instruction.
+ *
+ * @param p: The pattern.
+ * @param inst: The instruction.
+ * @param c: The byte.
+ *
+ * @return: 1 if the instruction consumes the byte, otherwise 0.
+ */
+static inline int inst_takes(const struct yuarel_rewrite_pattern *p, const struct yuarel_rewrite_inst *inst, unsigned char c)
+{
+    if (OP_BYTE == inst->op)
+    {
+        return inst->arg == c;
+    }
+    return OP_SET == inst->op && set_has(p->sets[inst->arg], c);
+}
+
+/**
+ * Split the bytes into classes that no instruction tells apart.
+ *
+ * @param p: The pattern.
+ *
+ * @return: 0 on success, or -1 if there are too many classes.
+ */
+static int build_classes(struct yuarel_rewrite_pattern *p)
+{
+    int count = 1;
+    int pc, b;
+
+    memset(p->classes, 0, sizeof(p->classes));
+    for (pc = 0; pc < p->inst_count; pc++)
+    {
+        signed char remap[YUAREL_REWRITE_MAX_CLASSES][2];
+        int next = 0;
+
+        if (OP_BYTE != p->insts[pc].op && OP_SET != p->insts[pc].op)
+        {
+            continue;
+        }
+        memset(remap, -1, sizeof(remap));
+        for (b = 0; b < 256; b++)
+        {
+            int in = inst_takes(p, &p->insts[pc], (unsigned char)b);
+            int old = p->classes[b];
+
+            if (remap[old][in] < 0)
+            {
+                if (YUAREL_REWRITE_MAX_CLASSES == next)
+                {
+                    return -1;
+                }
+                remap[old][in] = (signed char)next++;
+            }
+            p->classes[b] = (unsigned char)remap[old][in];
+        }
+        count = next;
+    }
+    p->class_count = count;
+    return 0;
+}
+
+/**
+ * Follow the instructions that do not consume a byte.
+ *
+ * @param p: The pattern.
+ * @param set: The instructions to start from.
+ * @param at_start: 1 if at the start of the text.
+ * @param at_end: 1 if at the end of the text.
+ *
+ * @return: The instructions that consume a byte or match. Unless at the end,
+ *          pending end assertions are included.
+ */
+static uint64_t closure(const struct yuarel_rewrite_pattern *p, uint64_t set, int at_start, int at_end)
+{
+    uint64_t todo = set;
+    uint64_t done = 0;
+    uint64_t result = 0;
+
+    while (0 != todo)
+    {
+        int pc = __builtin_ctzll(todo);
+        const struct yuarel_rewrite_inst *inst = &p->insts[pc];
+
+        todo &= todo - 1;
+        if (done & BIT(pc))
+        {
+            continue;
+        }
+        done |= BIT(pc);
+
+        switch (inst->op)
+        {
+        case OP_SPLIT:
+            todo |= BIT(inst->x) | BIT(inst->y);
+            break;
+        case OP_JMP:
+            todo |= BIT(inst->x);
+            break;
+        case OP_SAVE:
+            todo |= BIT(pc + 1);
+            break;
+        case OP_BOL:
+            if (at_start)
+            {
+                todo |= BIT(pc + 1);
+            }
+            break;
+        case OP_EOL:
+            if (at_end)
+            {
+                todo |= BIT(pc + 1);
+            }
+            else
+            {
+                result |= BIT(pc);
+            }
+            break;
+        default:
+            result |= BIT(pc);
+            break;
+        }
+        todo &= ~done;
+    }
+    return result;
+}
+
+/**
+ * Build the DFA of a pattern by subset construction. Every state is a set of
+ * instructions. Unless the pattern is anchored, each state also holds the
+ * start of a new match at the following byte.
+ *
+ * @param p: The pattern. `state_count` is left 0 if the DFA is too large.
+ */
+static void build_dfa(struct yuarel_rewrite_pattern *p)
+{
+    uint64_t states[YUAREL_REWRITE_MAX_STATES];
+    unsigned char rep[YUAREL_REWRITE_MAX_CLASSES];
+    uint64_t restart, match;
+    int count = 1;
+    int i, c, b;
+
+    p->state_count = 0;
+    if (-1 == build_classes(p))
+    {
+        return;
+    }
+    for (b = 255; b >= 0; b--)
+    {
+        rep[p->classes[b]] = (unsigned char)b;
+    }
+
+    restart = closure(p, BIT(0), 0, 0);
+    match = BIT(p->inst_count - 1);
+    states[0] = closure(p, BIT(0), 1, 0);
+
+    for (i = 0; i < count; i++)
+    {
+        for (c = 0; c < p->class_count; c++)
+        {
+            uint64_t from = states[i];
+            uint64_t to = 0;
+            int j;
+
+            while (0 != from)
+            {
+                int pc = __builtin_ctzll(from);
+
+                from &= from - 1;
+                if (inst_takes(p, &p->insts[pc], rep[c]))
+                {
+                    to |= BIT(pc + 1);
+                }
+            }
+            to = closure(p, to, 0, 0) | restart;
+
+            for (j = 0; j < count && states[j] != to; j++)
+            {
+            }
+            if (j == count)
+            {
+                if (YUAREL_REWRITE_MAX_STATES == count)
+                {
+                    return;
+                }
+                states[count++] = to;
+            }
+            p->next[i][c] = (unsigned char)j;
+        }
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        p->flags[i] = 0;
+        if (states[i] & match)
+        {
+            p->flags[i] |= STATE_ACCEPT;
+        }
+        if (closure(p, states[i], 0, 1) & match)
+        {
+            p->flags[i] |= STATE_ACCEPT_END;
+        }
+        if (0 == states[i])
+        {
+            p->flags[i] |= STATE_DEAD;
+        }
+    }
+    p->state_count = count;
+}
+
+/**
+ * Compile a pattern.
+ *
+ * @param p: The pattern to compile into.
+ * @param pattern: The pattern.
+ *
+ * @return: 0 on success, or -1 if the pattern is invalid or too large.
+ */
+static int compile_pattern(struct yuarel_rewrite_pattern *p, const char *pattern)
+{
+    struct rewrite_parser ps;
+    int root;
+
+    memset(p, 0, sizeof(struct yuarel_rewrite_pattern));
+    ps.str = pattern;
+    ps.p = p;
+    ps.count = 0;
+    ps.groups = 1;
+    ps.depth = 0;
+
+    root = parse_alt(&ps);
+    if (root < 0 || '\0' != *ps.str)
+    {
+        return -1;
+    }
+    p->group_count = ps.groups;
+
+    if (put_inst(p, OP_SAVE, 0) < 0 || -1 == emit(&ps, root) || put_inst(p, OP_SAVE, 1) < 0 ||
+        put_inst(p, OP_MATCH, 0) < 0)
+    {
+        return -1;
+    }
+
+    build_dfa(p);
+    return 0;
+}
+
+/**
+ * Get a byte of the text.
+ *
+ * @param t: The text.
+ * @param pos: The position of the byte.
+ *
+ * @return: The byte.
+ */
+static inline unsigned char text_at(const struct rewrite_text *t, size_t pos)
+{
+    return (unsigned char)((pos < t->len[0]) ? t->str[0][pos] : t->str[1][pos - t->len[0]]);
+}
+
+/**
+ * Run the DFA of a pattern over a text.
+ *
+ * @param p: The pattern, with a DFA.
+ * @param t: The text.
+ *
+ * @return: 1 if the pattern matches somewhere in the text, otherwise 0.
+ */
+static int dfa_match(const struct yuarel_rewrite_pattern *p, const struct rewrite_text *t)
+{
+    int s = 0;
+    int k;
+
+    for (k = 0; k < 2; k++)
+    {
+        const unsigned char *str = (const unsigned char *)t->str[k];
+        size_t i;
+
+        for (i = 0; i < t->len[k]; i++)
+        {
+            if (p->flags[s] & (STATE_ACCEPT | STATE_DEAD))
+            {
+                return p->flags[s] & STATE_ACCEPT;
+            }
+            s = p->next[s][p->classes[str[i]]];
+        }
+    }
+    return 0 != (p->flags[s] & (STATE_ACCEPT | STATE_ACCEPT_END));
+}
+
+/**
+ * Add a thread to the list of the next step of the Pike VM, following the
+ * instructions that do not consume a byte in priority order.
+ *
+ * @param p: The pattern.
+ * @param list: The list to add to.
+ * @param seen: The instructions already in the list.
+ * @param pc: The instruction of the thread.
+ * @param caps: The capture slots of the thread. Restored before returning.
+ * @param pos: The position in the text.
+ * @param len: The length of the text.
+ */
+static void add_thread(const struct yuarel_rewrite_pattern *p, struct rewrite_list *list, uint64_t *seen, int pc,
+                       size_t *caps, size_t pos, size_t len)
+{
+    const struct yuarel_rewrite_inst *inst = &p->insts[pc];
+
+    if (*seen & BIT(pc))
+    {
+        return;
+    }
+    *seen |= BIT(pc);
+
+    switch (inst->op)
+    {
+    case OP_SPLIT:
+        add_thread(p, list, seen, inst->x, caps, pos, len);
+        add_thread(p, list, seen, inst->y, caps, pos, len);
+        break;
+    case OP_JMP:
+        add_thread(p, list, seen, inst->x, caps, pos, len);
+        break;
+    case OP_SAVE:
+    {
+        size_t old = caps[inst->arg];
+
+        caps[inst->arg] = pos;
+        add_thread(p, list, seen, pc + 1, caps, pos, len);
+        caps[inst->arg] = old;
+        break;
+    }
+    case OP_BOL:
+        if (0 == pos)
+        {
+            add_thread(p, list, seen, pc + 1, caps, pos, len);
+        }
+        break;
+    case OP_EOL:
+        if (len == pos)
+        {
+            add_thread(p, list, seen, pc + 1, caps, pos, len);
+        }
+        break;
+    default:
+        list->threads[list->count].pc = pc;
+        memcpy(list->threads[list->count].caps, caps, 2 * p->group_count * sizeof(size_t));
+        list->count++;
+        break;
+    }
+}
+
+/**
+ * Find the leftmost match of a pattern and its capture groups, with a Pike VM.
+ *
+ * @param p: The pattern.
+ * @param t: The text.
+ * @param caps: Set to the start and end of each group, or NONE.
+ *
+ * @return: 1 if the pattern matches, otherwise 0.
+ */
+static int vm_match(const struct yuarel_rewrite_pattern *p, const struct rewrite_text *t, size_t *caps)
+{
+    struct rewrite_list lists[2];
+    struct rewrite_list *clist = &lists[0];
+    struct rewrite_list *nlist = &lists[1];
+    size_t start[2 * YUAREL_REWRITE_MAX_GROUPS];
+    size_t len = t->len[0] + t->len[1];
+    size_t pos;
+    uint64_t seen = 0;
+    int matched = 0;
+    int anchored = (0 == closure(p, BIT(0), 0, 0));
+    int i;
+
+    for (i = 0; i < 2 * p->group_count; i++)
+    {
+        start[i] = NONE;
+    }
+    clist->count = 0;
+    add_thread(p, clist, &seen, 0, start, 0, len);
+
+    for (pos = 0; clist->count > 0; pos++)
+    {
+        unsigned char c = (pos < len) ? text_at(t, pos) : 0;
+
+        nlist->count = 0;
+        seen = 0;
+        for (i = 0; i < clist->count; i++)
+        {
+            struct rewrite_thread *th = &clist->threads[i];
+            const struct yuarel_rewrite_inst *inst = &p->insts[th->pc];
+
+            if (OP_MATCH == inst->op)
+            {
+                /* Threads of lower priority can not win any more */
+                memcpy(caps, th->caps, 2 * p->group_count * sizeof(size_t));
+                matched = 1;
+                break;
+            }
+            if (pos < len && inst_takes(p, inst, c))
+            {
+                add_thread(p, nlist, &seen, th->pc + 1, th->caps, pos + 1, len);
+            }
+        }
+        if (pos == len)
+        {
+            break;
+        }
+        if (!matched && !anchored)
+        {
+            add_thread(p, nlist, &seen, 0, start, pos + 1, len);
+        }
+
+        clist = nlist;
+        nlist = (clist == &lists[0]) ? &lists[1] : &lists[0];
+    }
+    return matched;
+}
+
+/**
+ * Find the leftmost match of a pattern and its capture groups, by backtracking
+ * in priority order. Each split is tried at most once per position, so the
+ * time is linear in the length of the text, like the Pike VM, with less work
+ * per byte. Only used for short texts.
+ *
+ * @param p: The pattern.
+ * @param t: The text.
+ * @param caps: Set to the start and end of each group, or NONE.
+ *
+ * @return: 1 if the pattern matches, 0 if not, or -1 if the text is too long.
+ */
+static int backtrack_match(const struct yuarel_rewrite_pattern *p, const struct rewrite_text *t, size_t *caps)
+{
+    uint64_t visited[MAX_VISITED / 64];
+    struct rewrite_job jobs[MAX_JOBS];
+    size_t len = t->len[0] + t->len[1];
+    size_t start, last;
+    int i;
+
+    if ((len + 1) * (size_t)p->inst_count > MAX_VISITED)
+    {
+        return -1;
+    }
+    memset(visited, 0, ((len + 1) * p->inst_count + 63) / 64 * sizeof(uint64_t));
+
+    last = (0 == closure(p, BIT(0), 0, 0)) ? 0 : len;
+    for (start = 0; start <= last; start++)
+    {
+        int count = 1;
+
+        for (i = 0; i < 2 * p->group_count; i++)
+        {
+            caps[i] = NONE;
+        }
+        jobs[0].pc = 0;
+        jobs[0].pos = start;
+
+        while (count > 0)
+        {
+            struct rewrite_job job = jobs[--count];
+            int pc = job.pc;
+            size_t pos = job.pos;
+
+            if (-1 == pc)
+            {
+                caps[job.slot] = pos;
+                continue;
+            }
+
+            for (;;)
+            {
+                const struct yuarel_rewrite_inst *inst = &p->insts[pc];
+
+                if (OP_SPLIT == inst->op)
+                {
+                    /* Every loop and every branch passes a split */
+                    size_t bit = (size_t)pc * (len + 1) + pos;
+
+                    if (visited[bit / 64] & ((uint64_t)1 << (bit % 64)))
+                    {
+                        break;
+                    }
+                    visited[bit / 64] |= (uint64_t)1 << (bit % 64);
+                }
+
+                if (OP_BYTE == inst->op || OP_SET == inst->op)
+                {
+                    if (pos == len || !inst_takes(p, inst, text_at(t, pos)))
+                    {
+                        break;
+                    }
+                    pc++;
+                    pos++;
+                }
+                else if (OP_SPLIT == inst->op || OP_SAVE == inst->op)
+                {
+                    if (MAX_JOBS == count)
+                    {
+                        return -1;
+                    }
+                    if (OP_SPLIT == inst->op)
+                    {
+                        jobs[count].pc = inst->y;
+                        jobs[count].pos = pos;
+                        pc = inst->x;
+                    }
+                    else
+                    {
+                        jobs[count].pc = -1;
+                        jobs[count].slot = inst->arg;
+                        jobs[count].pos = caps[inst->arg];
+                        caps[inst->arg] = pos;
+                        pc++;
+                    }
+                    count++;
+                }
+                else if (OP_JMP == inst->op)
+                {
+                    pc = inst->x;
+                }
+                else if (OP_BOL == inst->op)
+                {
+                    if (0 != pos)
+                    {
+                        break;
+                    }
+                    pc++;
+                }
+                else if (OP_EOL == inst->op)
+                {
+                    if (len != pos)
+                    {
+                        break;
+                    }
+                    pc++;
+                }
+                else
+                {
+                    /* The first match found is the one of highest priority */
+                    return 1;
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+/**
+ * Find the leftmost match of a pattern and its capture groups.
+ *
+ * @param p: The pattern.
+ * @param t: The text.
+ * @param caps: Set to the start and end of each group, or NONE.
+ *
+ * @return: 1 if the pattern matches, otherwise 0.
+ */
+static int capture_match(const struct yuarel_rewrite_pattern *p, const struct rewrite_text *t, size_t *caps)
+{
+    int matched = backtrack_match(p, t, caps);
+
+    return (-1 != matched) ? matched : vm_match(p, t, caps);
+}
+
+/**
+ * Check if a pattern matches a text.
+ *
+ * @param p: The pattern.
+ * @param t: The text.
+ *
+ * @return: 1 if the pattern matches, otherwise 0.
+ */
+static int pattern_test(const struct yuarel_rewrite_pattern *p, const struct rewrite_text *t)
+{
+    size_t caps[2 * YUAREL_REWRITE_MAX_GROUPS];
+
+    if (0 != p->state_count && 0 != t->len[0] + t->len[1])
+    {
+        return dfa_match(p, t);
+    }
+    return capture_match(p, t, caps);
+}
+
+/**
+ * Append bytes to the output.
+ *
+ * @param w: The writer.
+ * @param str: The bytes to append.
+ * @param len: The number of bytes.
+ */
+static void rewrite_put(struct rewrite_writer *w, const char *str, size_t len)
+{
+    size_t avail = (w->len + 1 < w->size) ? w->size - 1 - w->len : 0;
+    size_t n = (len < avail) ? len : avail;
+
+    if (n > 0)
+    {
+        memcpy(w->buf + w->len, str, n);
+    }
+    w->len += len;
+}
+
+/**
+ * Append a part of the text to the output.
+ *
+ * @param w: The writer.
+ * @param t: The text.
+ * @param start: The position of the first byte.
+ * @param end: The position after the last byte.
+ */
+static void rewrite_put_text(struct rewrite_writer *w, const struct rewrite_text *t, size_t start, size_t end)
+{
+    if (start < t->len[0])
+    {
+        size_t stop = (end < t->len[0]) ? end : t->len[0];
+
+        rewrite_put(w, t->str[0] + start, stop - start);
+        start = stop;
+    }
+    if (start < end)
+    {
+        rewrite_put(w, t->str[1] + (start - t->len[0]), end - start);
+    }
+}
+
+/**
+ * Check a replacement template.
+ *
+ * @param str: The template.
+ * @param groups: The number of groups of the pattern.
+ *
+ * @return: 0 if every '$' names a group or a '$', otherwise -1.
+ */
+static int check_replacement(const char *str, int groups)
+{
+    for (; '\0' != *str; str++)
+    {
+        if ('$' != *str)
+        {
+            continue;
+        }
+        str++;
+        if ('$' != *str && (*str < '0' || *str >= '0' + groups))
+        {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Compile a rewrite rule.
+ *
+ * `pattern` is matched against the path of a URL, with its leading '/'. In
+ * `replacement`, `$0` is replaced by the whole match, `$1` to `$9` by the
+ * capture groups and `$$` by a single '$'. A group that did not take part in
+ * the match is replaced by nothing.
+ *
+ * @param[out] rule The rule to compile into.
+ * @param[in] pattern The pattern to match the path against.
+ * @param[in] replacement The replacement template.
+ *
+ * @return 0 on success, or -1 if the pattern or the replacement is invalid or
+ *         too large.
+ */
+int yuarel_rewrite_compile(struct yuarel_rewrite *rule, const char *pattern, const char *replacement)
+{
+    size_t len;
+
+    if (NULL == rule || NULL == pattern || NULL == replacement)
+    {
+        return -1;
+    }
+
+    memset(rule, 0, sizeof(struct yuarel_rewrite));
+    len = strlen(replacement);
+    if (len >= YUAREL_REWRITE_MAX_REPLACEMENT || -1 == compile_pattern(&rule->path, pattern) ||
+        -1 == check_replacement(replacement, rule->path.group_count))
+    {
+        return -1;
+    }
+    memcpy(rule->replacement, replacement, len + 1);
+    return 0;
+}
+
+/**
+ * @brief Add a condition to a compiled rewrite rule.
+ *
+ * The rule only applies when `pattern` matches the host, or the query, of the
+ * URL. A missing host or query is matched as the empty string. Adding a second
+ * condition on the same component replaces the first.
+ *
+ * @param[in,out] rule The rule to add the condition to.
+ * @param[in] field YUAREL_FIELD_HOST or YUAREL_FIELD_QUERY.
+ * @param[in] pattern The pattern the component must match.
+ *
+ * @return 0 on success, or -1 if the field or the pattern is invalid.
+ */
+int yuarel_rewrite_condition(struct yuarel_rewrite *rule, int field, const char *pattern)
+{
+    struct yuarel_rewrite_pattern p;
+
+    if (NULL == rule || NULL == pattern || (YUAREL_FIELD_HOST != field && YUAREL_FIELD_QUERY != field) ||
+        -1 == compile_pattern(&p, pattern))
+    {
+        return -1;
+    }
+
+    /* The old condition stays in place when the new one does not compile */
+    memcpy((YUAREL_FIELD_HOST == field) ? &rule->host : &rule->query, &p, sizeof(p));
+    rule->conditions |= field;
+    return 0;
+}
+
+/**
+ * @brief Apply a rewrite rule to a parsed URL.
+ *
+ * When the rule applies, the replacement is expanded into `buf` as the new
+ * path and query, starting with the '/' of the path if the replacement does.
+ * The query of the URL is kept as in nginx: it is appended after a '?' when
+ * the replacement has no query of its own, after a '&' when it has, and
+ * dropped when the replacement ends with '?'.
+ *
+ * The result is always null terminated if `size` is not 0. Like snprintf(),
+ * the return value is the length of the full result, so calling with `size`
+ * 0 gives the exact size of the buffer to allocate.
+ *
+ * @param[in] rule The compiled rule.
+ * @param[in] url The parsed URL.
+ * @param[out] buf The buffer to write the result to, or NULL if `size` is 0.
+ * @param[in] size The size of `buf`.
+ *
+ * @return The length of the result, or -1 if the rule does not apply.
+ */
+long yuarel_rewrite_apply(const struct yuarel_rewrite *rule, const struct yuarel *url, char *buf, size_t size)
+{
+    struct rewrite_writer w;
+    struct rewrite_text t;
+    size_t caps[2 * YUAREL_REWRITE_MAX_GROUPS];
+    const char *query;
+    const char *r;
+    int has_query = 0;
+
+    if (NULL == rule || NULL == url || (NULL == buf && 0 != size))
+    {
+        return -1;
+    }
+
+    /* Conditions, the cheaper the earlier */
+    t.str[1] = "";
+    t.len[1] = 0;
+    if (rule->conditions & YUAREL_FIELD_HOST)
+    {
+        t.str[0] = (NULL != url->host) ? url->host : "";
+        t.len[0] = strlen(t.str[0]);
+        if (!pattern_test(&rule->host, &t))
+        {
+            return -1;
+        }
+    }
+    query = (NULL != url->query) ? url->query : "";
+    if (rule->conditions & YUAREL_FIELD_QUERY)
+    {
+        t.str[0] = query;
+        t.len[0] = strlen(query);
+        if (!pattern_test(&rule->query, &t))
+        {
+            return -1;
+        }
+    }
+
+    t.str[0] = "/";
+    t.len[0] = 1;
+    t.str[1] = (NULL != url->path) ? url->path : "";
+    t.len[1] = strlen(t.str[1]);
+    if (0 != rule->path.state_count && !dfa_match(&rule->path, &t))
+    {
+        return -1;
+    }
+    /* The DFA has no captures, find them for the one rule that applies */
+    if (!capture_match(&rule->path, &t, caps))
+    {
+        return -1;
+    }
+
+    w.buf = buf;
+    w.size = size;
+    w.len = 0;
+    for (r = rule->replacement; '\0' != *r; r++)
+    {
+        if ('$' == r[0] && '$' != r[1])
+        {
+            int g = *++r - '0';
+
+            if (NONE != caps[2 * g] && NONE != caps[2 * g + 1])
+            {
+                rewrite_put_text(&w, &t, caps[2 * g], caps[2 * g + 1]);
+            }
+            continue;
+        }
+        if ('$' == r[0])
+        {
+            r++;
+        }
+        else if ('?' == r[0])
+        {
+            has_query = 1;
+            if ('\0' == r[1])
+            {
+                /* A trailing '?' drops the old query */
+                query = "";
+                break;
+            }
+        }
+        rewrite_put(&w, r, 1);
+    }
+
+    if ('\0' != *query)
+    {
+        rewrite_put(&w, has_query ? "&" : "?", 1);
+        rewrite_put(&w, query, strlen(query));
+    }
+
+    if (0 != size)
+    {
+        buf[(w.len < size) ? w.len : size - 1] = '\0';
+    }
+    return (long)w.len;
+}
@@ -0,0 +1,174 @@
+/**
+ * @file yuarel_rewrite.h
+ * @brief nginx style URL rewrite rules with captures.
+ *
+ * A rule such as `^/old/(\d+)/(.*)$ -> /new/$2?id=$1` is compiled once into a
+ * `yuarel_rewrite` struct, optionally with conditions on the host and the
+ * query. Each pattern is compiled both into a DFA over byte classes and into a
+ * small NFA program. Deciding whether a rule applies is one linear scan of the
+ * DFA per component. Only when it does, the NFA is run once more to find the
+ * capture groups, by a backtracker that tries each branch at most once per
+ * position, or by a Pike VM for long paths. Every step is linear in the length
+ * of the component, and none allocates.
+ *
+ * The pattern language is a subset of POSIX extended regular expressions:
+ *
+ *  - literals, `.`, and the escapes `\d`, `\w`, `\s`, `\D`, `\W`, `\S`
+ *  - bracket expressions, `[a-z_]` and `[^/]`
+ *  - the anchors `^` and `$`
+ *  - groups, `(...)` captures and `(?:...)` does not, with alternation `|`
+ *  - the greedy quantifiers `*`, `+`, `?` and the lazy `*?`, `+?`, `??`
+ *
+ * Back-references and counted repetition are not supported.
+ *
+ * @copyright Copyright (C) 2016 Jack Engqvist Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef INC_YUAREL_REWRITE_H
+#define INC_YUAREL_REWRITE_H
+
+#include "yuarel.h"
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** @brief The maximum number of instructions of a compiled pattern. */
+#define YUAREL_REWRITE_MAX_INSTS 64
+/** @brief The maximum number of bracket expressions in a pattern. */
+#define YUAREL_REWRITE_MAX_SETS 16
+/** @brief The maximum number of DFA states of a pattern. */
+#define YUAREL_REWRITE_MAX_STATES 64
+/** @brief The maximum number of byte classes of a pattern. */
+#define YUAREL_REWRITE_MAX_CLASSES 32
+/** @brief The maximum number of capture groups, including the whole match. */
+#define YUAREL_REWRITE_MAX_GROUPS 10
+/** @brief The maximum length of a replacement, including the null byte. */
+#define YUAREL_REWRITE_MAX_REPLACEMENT 256
+
+/**
+ * @struct yuarel_rewrite_inst
+ * @brief An instruction of a compiled pattern.
+ */
+struct yuarel_rewrite_inst
+{
+    unsigned char op;  /**< @brief The kind of instruction */
+    unsigned char arg; /**< @brief A byte, a set or a capture slot */
+    unsigned char x;   /**< @brief The first jump target */
+    unsigned char y;   /**< @brief The second jump target, of lower priority */
+};
+
+/**
+ * @struct yuarel_rewrite_pattern
+ * @brief A compiled pattern.
+ *
+ * When the DFA needs more than YUAREL_REWRITE_MAX_STATES states, or the pattern
+ * more than YUAREL_REWRITE_MAX_CLASSES byte classes, `state_count` is 0 and
+ * the pattern is matched by the NFA alone.
+ */
+struct yuarel_rewrite_pattern
+{
+    struct yuarel_rewrite_inst insts[YUAREL_REWRITE_MAX_INSTS];                  /**< @brief The NFA program */
+    unsigned char sets[YUAREL_REWRITE_MAX_SETS][32];                             /**< @brief Bracket expressions, as bitmaps */
+    unsigned char classes[256];                                                  /**< @brief The byte class of each byte */
+    unsigned char next[YUAREL_REWRITE_MAX_STATES][YUAREL_REWRITE_MAX_CLASSES]; /**< @brief DFA transitions */
+    unsigned char flags[YUAREL_REWRITE_MAX_STATES];                              /**< @brief DFA state flags */
+    int inst_count;                                                              /**< @brief Number of instructions */
+    int set_count;                                                               /**< @brief Number of sets */
+    int class_count;                                                             /**< @brief Number of byte classes */
+    int state_count;                                                             /**< @brief Number of DFA states, or 0 */
+    int group_count;                                                             /**< @brief Number of groups, including the whole match */
+};
+
+/**
+ * @struct yuarel_rewrite
+ * @brief A compiled rewrite rule.
+ */
+struct yuarel_rewrite
+{
+    struct yuarel_rewrite_pattern path;                 /**< @brief Matched against "/" followed by `url->path` */
+    struct yuarel_rewrite_pattern host;                 /**< @brief Condition on `url->host` */
+    struct yuarel_rewrite_pattern query;                /**< @brief Condition on `url->query` */
+    int conditions;                                     /**< @brief YUAREL_FIELD_HOST and YUAREL_FIELD_QUERY, when set */
+    char replacement[YUAREL_REWRITE_MAX_REPLACEMENT]; /**< @brief The replacement template */
+};
+
+/**
+ * @brief Compile a rewrite rule.
+ *
+ * `pattern` is matched against the path of a URL, with its leading '/'. In
+ * `replacement`, `$0` is replaced by the whole match, `$1` to `$9` by the
+ * capture groups and `$$` by a single '$'. A group that did not take part in
+ * the match is replaced by nothing.
+ *
+ * @param[out] rule The rule to compile into.
+ * @param[in] pattern The pattern to match the path against.
+ * @param[in] replacement The replacement template.
+ *
+ * @return 0 on success, or -1 if the pattern or the replacement is invalid or
+ *         too large.
+ */
+extern int yuarel_rewrite_compile(struct yuarel_rewrite *rule, const char *pattern, const char *replacement);
+
+/**
+ * @brief Add a condition to a compiled rewrite rule.
+ *
+ * The rule only applies when `pattern` matches the host, or the query, of the
+ * URL. A missing host or query is matched as the empty string. Adding a second
+ * condition on the same component replaces the first.
+ *
+ * @param[in,out] rule The rule to add the condition to.
+ * @param[in] field YUAREL_FIELD_HOST or YUAREL_FIELD_QUERY.
+ * @param[in] pattern The pattern the component must match.
+ *
+ * @return 0 on success, or -1 if the field or the pattern is invalid.
+ */
+extern int yuarel_rewrite_condition(struct yuarel_rewrite *rule, int field, const char *pattern);
+
+/**
+ * @brief Apply a rewrite rule to a parsed URL.
+ *
+ * When the rule applies, the replacement is expanded into `buf` as the new
+ * path and query, starting with the '/' of the path if the replacement does.
+ * The query of the URL is kept as in nginx: it is appended after a '?' when
+ * the replacement has no query of its own, after a '&' when it has, and
+ * dropped when the replacement ends with '?'.
+ *
+ * The result is always null terminated if `size` is not 0. Like snprintf(),
+ * the return value is the length of the full result, so calling with `size`
+ * 0 gives the exact size of the buffer to allocate.
+ *
+ * @param[in] rule The compiled rule.
+ * @param[in] url The parsed URL.
+ * @param[out] buf The buffer to write the result to, or NULL if `size` is 0.
+ * @param[in] size The size of `buf`.
+ *
+ * @return The length of the result, or -1 if the rule does not apply.
+ */
+extern long yuarel_rewrite_apply(const struct yuarel_rewrite *rule, const struct yuarel *url, char *buf, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_YUAREL_REWRITE_H */
@@ -0,0 +1,477 @@
+/**
+ * Copyright (C) 2016,2017 Jack Engqvist Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "yuarel_stream.h"
+#include <string.h>
+
+/* Marks an offset that has not been seen yet */
+#define NONE ((size_t)-1)
+
+/* Largest port value accumulated, further digits are ignored */
+#define PORT_LIMIT 1000000
+
+enum stream_state
+{
+    ST_START,
+    ST_SCHEME,
+    ST_SLASH1,
+    ST_SLASH2,
+    ST_AUTH_FIRST,
+    ST_AUTH,
+    ST_PATH,
+    ST_QUERY,
+    ST_FRAGMENT,
+    ST_DONE,
+    ST_ERROR
+};
+
+/**
+ * Check if a byte needs the attention of the authority parser.
+ *
+ * @param c: The byte to check.
+ *
+ * @return: 1 for delimiters within or after the authority, otherwise 0.
+ */
+static inline int is_auth_special(char c)
+{
+    return ':' == c || '@' == c || '[' == c || ']' == c || '/' == c || '?' == c || '#' == c;
+}
+
+/**
+ * Set a span from a start and end offset.
+ *
+ * @param span: The span to set.
+ * @param start: Offset of the first byte.
+ * @param end: Offset just past the last byte.
+ */
+static inline void set_span(struct yuarel_span *span, size_t start, size_t end)
+{
+    span->off = start;
+    span->len = end - start;
+}
+
+/**
+ * Complete the authority at the current position, which holds the first
+ * '/', '?' or '#' after it or is the end of the URL.
+ *
+ * Applies the same rules as yuarel_parse_fields() to the positions recorded
+ * while the authority was fed.
+ *
+ * @param s: The parser.
+ *
+ * @return: 0 on success, otherwise -1 on error.
+ */
+static int end_authority(struct yuarel_stream *s)
+{
+    size_t host_end;
+
+    /* Missing hostname? */
+    if (s->pos == s->host_start)
+    {
+        return -1;
+    }
+
+    if (s->ipv6)
+    {
+        /* Must be closed, and only be followed by a port */
+        if (NONE == s->bracket_end || 2 == s->ipv6)
+        {
+            return -1;
+        }
+        set_span(&s->host, s->host_start + 1, s->bracket_end);
+    }
+    else
+    {
+        host_end = (NONE != s->port_colon) ? s->port_colon : s->pos;
+        set_span(&s->host, s->host_start, host_end);
+    }
+
+    if (0 == s->host.len)
+    {
+        return -1;
+    }
+    s->fields |= YUAREL_FIELD_HOST;
+
+    if (NONE != s->port_colon)
+    {
+        if (s->port_colon + 1 == s->pos)
+        {
+            /* Missing port */
+            return -1;
+        }
+        set_span(&s->port, s->port_colon + 1, s->pos);
+        s->fields |= YUAREL_FIELD_PORT;
+    }
+
+    return 0;
+}
+
+/**
+ * Feed one byte of the authority.
+ *
+ * Records the position of the credentials, IPv6 brackets and port, which are
+ * only resolved by end_authority() or at the '@'.
+ *
+ * @param s: The parser.
+ * @param c: The byte at position `s->pos`.
+ *
+ * @return: 0 on success, otherwise -1 on error.
+ */
+static int feed_authority(struct yuarel_stream *s, char c)
+{
+    if ('@' == c && !(s->fields & YUAREL_FIELD_USERNAME))
+    {
+        /* Missing credentials? */
+        if (s->pos == s->mark)
+        {
+            return -1;
+        }
+
+        if (NONE != s->cred_colon)
+        {
+            set_span(&s->username, s->mark, s->cred_colon);
+            set_span(&s->password, s->cred_colon + 1, s->pos);
+            s->fields |= YUAREL_FIELD_PASSWORD;
+        }
+        else
+        {
+            set_span(&s->username, s->mark, s->pos);
+        }
+        s->fields |= YUAREL_FIELD_USERNAME;
+
+        /* Start over on the host */
+        s->host_start = s->pos + 1;
+        s->port_colon = NONE;
+        s->port_digits = 0;
+        s->port_value = 0;
+        s->bracket_end = NONE;
+        s->ipv6 = 0;
+        return 0;
+    }
+
+    if (':' == c && NONE == s->cred_colon && !(s->fields & YUAREL_FIELD_USERNAME))
+    {
+        s->cred_colon = s->pos;
+    }
+
+    if (s->ipv6)
+    {
+        if (NONE == s->bracket_end)
+        {
+            if (']' == c)
+            {
+                s->bracket_end = s->pos;
+            }
+            return 0;
+        }
+
+        if (s->pos == s->bracket_end + 1)
+        {
+            /* Only a port may follow the literal. A later '@' still resets it */
+            if (':' == c)
+            {
+                s->port_colon = s->pos;
+            }
+            else
+            {
+                s->ipv6 = 2;
+            }
+            return 0;
+        }
+    }
+    else if ('[' == c && s->pos == s->host_start)
+    {
+        s->ipv6 = 1;
+        return 0;
+    }
+    else if (':' == c && NONE == s->port_colon)
+    {
+        s->port_colon = s->pos;
+        return 0;
+    }
+
+    /* Port digits, up to the first non-digit */
+    if (NONE != s->port_colon && s->pos == s->port_colon + 1 + s->port_digits && '0' <= c && c <= '9')
+    {
+        if (s->port_value < PORT_LIMIT)
+        {
+            s->port_value = s->port_value * 10 + (c - '0');
+        }
+        s->port_digits++;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Initialize a stream parser for a new URL.
+ *
+ * @param[out] stream The parser to initialize.
+ */
+void yuarel_stream_init(struct yuarel_stream *stream)
+{
+    if (NULL == stream)
+    {
+        return;
+    }
+
+    memset(stream, 0, sizeof(struct yuarel_stream));
+    stream->state = ST_START;
+    stream->cred_colon = NONE;
+    stream->port_colon = NONE;
+    stream->bracket_end = NONE;
+}
+
+/**
+ * @brief Feed the next chunk of a URL to a stream parser.
+ *
+ * The chunk is not modified or kept. Offsets in the spans count from the first
+ * byte of the first chunk.
+ *
+ * @param[in,out] stream The parser.
+ * @param[in] chunk The next bytes of the URL.
+ * @param[in] len The number of bytes in `chunk`.
+ *
+ * @return 0 on success, otherwise -1 if the URL is invalid. After an error
+ *         every further call fails until the parser is initialized again.
+ */
+int yuarel_stream_feed(struct yuarel_stream *stream, const char *chunk, size_t len)
+{
+    struct yuarel_stream *s = stream;
+    const char *end;
+    const char *p;
+
+    if (NULL == s || (NULL == chunk && len > 0) || ST_ERROR == s->state || ST_DONE == s->state)
+    {
+        return -1;
+    }
+
+    p = chunk;
+    end = chunk + len;
+
+    while (p < end)
+    {
+        char c = *p;
+
+        switch (s->state)
+        {
+            case ST_START:
+                if ('/' == c)
+                {
+                    /* Relative URL, path starts after the slash */
+                    s->mark = s->pos + 1;
+                    s->state = ST_PATH;
+                    break;
+                }
+                s->state = ST_SCHEME;
+                continue;
+
+            case ST_SCHEME:
+                while (':' != c && '?' != c && '#' != c)
+                {
+                    p++;
+                    s->pos++;
+                    if (p == end)
+                    {
+                        return 0;
+                    }
+                    c = *p;
+                }
+
+                if (':' == c)
+                {
+                    if (0 == s->pos)
+                    {
+                        s->state = ST_ERROR;
+                        return -1;
+                    }
+                    set_span(&s->scheme, 0, s->pos);
+                    s->fields |= YUAREL_FIELD_SCHEME;
+                    s->state = ST_SLASH1;
+                }
+                else
+                {
+                    /* Query or fragment before the scheme ended */
+                    s->state = ST_ERROR;
+                    return -1;
+                }
+                break;
+
+            case ST_SLASH1:
+            case ST_SLASH2:
+                if ('/' != c)
+                {
+                    s->state = ST_ERROR;
+                    return -1;
+                }
+                s->state = (ST_SLASH1 == s->state) ? ST_SLASH2 : ST_AUTH_FIRST;
+                break;
+
+            case ST_AUTH_FIRST:
+                if ('/' == c)
+                {
+                    /* URI Omits Hostname (e.g. File URI). Path keeps its slash */
+                    s->mark = s->pos;
+                    s->state = ST_PATH;
+                    break;
+                }
+                s->mark = s->pos;
+                s->host_start = s->pos;
+                s->state = ST_AUTH;
+                continue;
+
+            case ST_AUTH:
+                /* Plain host bytes only matter once a port may follow */
+                if (NONE == s->port_colon && !s->ipv6)
+                {
+                    while (!is_auth_special(c))
+                    {
+                        p++;
+                        s->pos++;
+                        if (p == end)
+                        {
+                            return 0;
+                        }
+                        c = *p;
+                    }
+                }
+
+                if ('/' == c || '?' == c || '#' == c)
+                {
+                    if (end_authority(s))
+                    {
+                        s->state = ST_ERROR;
+                        return -1;
+                    }
+                    s->mark = s->pos + 1;
+                    if ('/' == c)
+                    {
+                        s->state = ST_PATH;
+                    }
+                    else
+                    {
+                        s->state = ('?' == c) ? ST_QUERY : ST_FRAGMENT;
+                    }
+                }
+                else if (feed_authority(s, c))
+                {
+                    s->state = ST_ERROR;
+                    return -1;
+                }
+                break;
+
+            case ST_PATH:
+            case ST_QUERY:
+            {
+                /* Skip ahead to the next delimiter within the chunk */
+                const char *stop = memchr(p, '#', end - p);
+
+                if (NULL == stop)
+                {
+                    stop = end;
+                }
+                if (ST_PATH == s->state)
+                {
+                    const char *q = memchr(p, '?', stop - p);
+                    stop = (NULL != q) ? q : stop;
+                }
+                s->pos += stop - p;
+                p = stop;
+                if (p == end)
+                {
+                    return 0;
+                }
+
+                if (ST_PATH == s->state)
+                {
+                    set_span(&s->path, s->mark, s->pos);
+                    s->fields |= YUAREL_FIELD_PATH;
+                }
+                else
+                {
+                    set_span(&s->query, s->mark, s->pos);
+                    s->fields |= YUAREL_FIELD_QUERY;
+                }
+                s->mark = s->pos + 1;
+                s->state = ('?' == *p) ? ST_QUERY : ST_FRAGMENT;
+                break;
+            }
+
+            case ST_FRAGMENT:
+                /* Everything up to the end belongs to the fragment */
+                s->pos += end - p;
+                return 0;
+        }
+
+        p++;
+        s->pos++;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Signal the end of a URL and complete the last component.
+ *
+ * @param[in,out] stream The parser.
+ *
+ * @return 0 on success, otherwise -1 if the URL is invalid or incomplete.
+ */
+int yuarel_stream_finish(struct yuarel_stream *stream)
+{
+    struct yuarel_stream *s = stream;
+    int rc = 0;
+
+    if (NULL == s)
+    {
+        return -1;
+    }
+
+    switch (s->state)
+    {
+        case ST_AUTH:
+            rc = end_authority(s);
+            break;
+
+        case ST_PATH:
+            set_span(&s->path, s->mark, s->pos);
+            s->fields |= YUAREL_FIELD_PATH;
+            break;
+
+        case ST_QUERY:
+            set_span(&s->query, s->mark, s->pos);
+            s->fields |= YUAREL_FIELD_QUERY;
+            break;
+
+        case ST_FRAGMENT:
+            set_span(&s->fragment, s->mark, s->pos);
+            s->fields |= YUAREL_FIELD_FRAGMENT;
+            break;
+
+        default:
+            /* Empty, or ends within the scheme or before the host */
+            rc = -1;
+            break;
+    }
+
+    s->state = rc ? ST_ERROR : ST_DONE;
+    return rc;
+}
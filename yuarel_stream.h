@@ -0,0 +1,112 @@
+/**
+ * @file yuarel_stream.h
+ * @brief Resumable URL parser for input that arrives in chunks.
+ *
+ * yuarel_parse() needs the whole null terminated URL. The stream parser
+ * instead keeps its state between calls, so a URL can be fed in arbitrary
+ * chunks (e.g. TCP segments) without reassembling it first. Components are
+ * reported as spans of absolute offsets from the first byte fed, and become
+ * available as soon as their end has been seen.
+ *
+ * The accepted formats are the same as for yuarel_parse_fields().
+ *
+ * @copyright Copyright (C) 2016 Jack Engqvist Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef INC_YUAREL_STREAM_H
+#define INC_YUAREL_STREAM_H
+
+#include "yuarel.h"
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @struct yuarel_stream
+ * @brief State of a resumable URL parser.
+ *
+ * The public members may be read at any time. A span is only valid once its
+ * bit is set in `fields`.
+ */
+struct yuarel_stream
+{
+    int fields;                  /**< @brief YUAREL_FIELD_* bits of the components found so far */
+    struct yuarel_span scheme;   /**< @brief Scheme, without ":" and "//" */
+    struct yuarel_span username; /**< @brief Username */
+    struct yuarel_span password; /**< @brief Password */
+    struct yuarel_span host;     /**< @brief Hostname or IP address, without "[" and "]" */
+    struct yuarel_span port;     /**< @brief Port digits, without ":" */
+    struct yuarel_span path;     /**< @brief Path, without leading "/" */
+    struct yuarel_span query;    /**< @brief Query string, without "?" */
+    struct yuarel_span fragment; /**< @brief Fragment, without "#" */
+    int port_value;              /**< @brief Port, default: 0 */
+
+    /* Private parser state */
+    int state;
+    size_t pos;
+    size_t mark;
+    size_t host_start;
+    size_t cred_colon;
+    size_t port_colon;
+    size_t port_digits;
+    size_t bracket_end;
+    int ipv6;
+};
+
+/**
+ * @brief Initialize a stream parser for a new URL.
+ *
+ * @param[out] stream The parser to initialize.
+ */
+extern void yuarel_stream_init(struct yuarel_stream *stream);
+
+/**
+ * @brief Feed the next chunk of a URL to a stream parser.
+ *
+ * The chunk is not modified or kept. Offsets in the spans count from the first
+ * byte of the first chunk.
+ *
+ * @param[in,out] stream The parser.
+ * @param[in] chunk The next bytes of the URL.
+ * @param[in] len The number of bytes in `chunk`.
+ *
+ * @return 0 on success, otherwise -1 if the URL is invalid. After an error
+ *         every further call fails until the parser is initialized again.
+ */
+extern int yuarel_stream_feed(struct yuarel_stream *stream, const char *chunk, size_t len);
+
+/**
+ * @brief Signal the end of a URL and complete the last component.
+ *
+ * @param[in,out] stream The parser.
+ *
+ * @return 0 on success, otherwise -1 if the URL is invalid or incomplete.
+ */
+extern int yuarel_stream_finish(struct yuarel_stream *stream);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_YUAREL_STREAM_H */
@@ -0,0 +1,856 @@
+/**
+ * Copyright (C) 2016,2017 Jack Engqvist Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "yuarel_template.h"
+#include <string.h>
+
+/* Longest head that is parsed when compiling */
+#define HEAD_MAX 512
+
+/* Largest prefix modifier, RFC 6570 section 2.4.1 */
+#define PREFIX_MAX 9999
+
+/**
+ * @struct template_operator
+ * @brief How the values of an expression are joined and encoded (RFC 6570 appendix A).
+ */
+struct template_operator
+{
+    char op;       /* The operator, '\0' for simple expansion */
+    char first;    /* Written before the first defined value, '\0' for none */
+    char sep;      /* Written between values */
+    char named;    /* Values are written as name=value */
+    char ifemp;    /* Write '=' after the name of an empty value */
+    char reserved; /* Reserved characters and percent escapes are kept */
+};
+
+static const struct template_operator operators[] = {
+    {'\0', '\0', ',', 0, 0, 0},
+    {'+', '\0', ',', 0, 0, 1},
+    {'.', '.', '.', 0, 0, 0},
+    {'/', '/', '/', 0, 0, 0},
+    {';', ';', ';', 1, 0, 0},
+    {'?', '?', '&', 1, 1, 0},
+    {'&', '&', '&', 1, 1, 0},
+    {'#', '#', ',', 0, 0, 1},
+};
+
+/* Unreserved characters as a bit set, 64 bytes per word */
+static const uint64_t unreserved_bits[4] = {
+    /* '-', '.' and '0' to '9' */
+    (1ull << '-') | (1ull << '.') | (0x3ffull << '0'),
+    /* 'A' to 'Z', '_', 'a' to 'z' and '~' */
+    (0x3ffffffull << ('A' - 64)) | (1ull << ('_' - 64)) | (0x3ffffffull << ('a' - 64)) | (1ull << ('~' - 64)),
+    0,
+    0};
+
+/* Reserved characters (RFC 3986 section 2.2) as a bit set */
+static const uint64_t reserved_bits[4] = {
+    /* '!', '#', '$', '&', '\'', '(', ')', '*', '+', ',', '/', ':', ';', '=' and '?' */
+    (1ull << '!') | (1ull << '#') | (1ull << '$') | (1ull << '&') | (1ull << '\'') | (1ull << '(') | (1ull << ')') |
+        (1ull << '*') | (1ull << '+') | (1ull << ',') | (1ull << '/') | (1ull << ':') | (1ull << ';') | (1ull << '=') |
+        (1ull << '?'),
+    /* '@', '[' and ']' */
+    (1ull << ('@' - 64)) | (1ull << ('[' - 64)) | (1ull << (']' - 64)),
+    0,
+    0};
+
+/**
+ * @struct template_writer
+ * @brief Output of an expansion, truncated like snprintf().
+ */
+struct template_writer
+{
+    char *buf;     /* The buffer */
+    size_t size;   /* The size of the buffer */
+    size_t len;    /* The length of the full expansion so far */
+    long query;    /* Offset of the first '?' before any '#', or -1 */
+    long fragment; /* Offset of the first '#', or -1 */
+};
+
+/**
+ * Check if a byte is in a character bit set.
+ *
+ * @param bits: The bit set.
+ * @param c: The byte.
+ *
+ * @return: Non-zero if in the set, otherwise 0.
+ */
+static inline uint64_t in_set(const uint64_t *bits, unsigned char c)
+{
+    return (bits[c >> 6] >> (c & 63)) & 1;
+}
+
+/**
+ * Check if a byte is a hex digit.
+ *
+ * @param c: The byte.
+ *
+ * @return: 1 if a hex digit, otherwise 0.
+ */
+static inline int is_hex(char c)
+{
+    return ('0' <= c && c <= '9') || ('a' <= c && c <= 'f') || ('A' <= c && c <= 'F');
+}
+
+/**
+ * Check if a percent escape starts at a position.
+ *
+ * @param str: The string.
+ * @param i: The position of the '%'.
+ * @param len: The length of the string.
+ *
+ * @return: 1 if "%XX" starts at `i`, otherwise 0.
+ */
+static inline int is_escape(const char *str, size_t i, size_t len)
+{
+    return '%' == str[i] && i + 2 < len && is_hex(str[i + 1]) && is_hex(str[i + 2]);
+}
+
+/**
+ * Append bytes to the output, as far as they fit before the null terminator.
+ *
+ * @param w: The writer.
+ * @param str: The bytes.
+ * @param len: The number of bytes.
+ */
+static inline void put(struct template_writer *w, const char *str, size_t len)
+{
+    if (w->len + len < w->size)
+    {
+        /* Most pieces are short, where a call to memcpy() costs more than the copy */
+        char *out = w->buf + w->len;
+        size_t i;
+
+        if (len > 16)
+        {
+            memcpy(out, str, len);
+        }
+        else
+        {
+            for (i = 0; i < len; i++)
+            {
+                out[i] = str[i];
+            }
+        }
+    }
+    else if (w->len + 1 < w->size)
+    {
+        memcpy(w->buf + w->len, str, w->size - 1 - w->len);
+    }
+    w->len += len;
+}
+
+/**
+ * Append one byte to the output, noting where the query and fragment start.
+ *
+ * @param w: The writer.
+ * @param c: The byte.
+ */
+static inline void put_char(struct template_writer *w, char c)
+{
+    if ('#' == c && w->fragment < 0)
+    {
+        w->fragment = (long)w->len;
+    }
+    else if ('?' == c && w->query < 0 && w->fragment < 0)
+    {
+        w->query = (long)w->len;
+    }
+    put(w, &c, 1);
+}
+
+/**
+ * Append bytes to the output, percent-encoding those that are not allowed.
+ *
+ * @param w: The writer.
+ * @param str: The bytes.
+ * @param len: The number of bytes.
+ * @param reserved: 1 to also keep reserved characters and percent escapes.
+ */
+static void put_encoded(struct template_writer *w, const char *str, size_t len, int reserved)
+{
+    static const char hex[] = "0123456789ABCDEF";
+    size_t i = 0;
+
+    while (i < len)
+    {
+        size_t run = i;
+        unsigned char c;
+
+        /* Copy runs of unreserved characters at once */
+        while (run < len && in_set(unreserved_bits, (unsigned char)str[run]))
+        {
+            run++;
+        }
+        if (run > i)
+        {
+            put(w, str + i, run - i);
+            i = run;
+            if (i == len)
+            {
+                break;
+            }
+        }
+
+        c = (unsigned char)str[i];
+        if (reserved && in_set(reserved_bits, c))
+        {
+            put_char(w, (char)c);
+            i++;
+        }
+        else if (reserved && is_escape(str, i, len))
+        {
+            put(w, str + i, 3);
+            i += 3;
+        }
+        else
+        {
+            char escape[3];
+
+            escape[0] = '%';
+            escape[1] = hex[c >> 4];
+            escape[2] = hex[c & 0xf];
+            put(w, escape, 3);
+            i++;
+        }
+    }
+}
+
+/**
+ * Append a literal that needs no encoding, noting where the query and
+ * fragment start.
+ *
+ * @param w: The writer.
+ * @param str: The literal.
+ * @param len: The length of the literal.
+ */
+static void put_literal(struct template_writer *w, const char *str, size_t len)
+{
+    if (w->fragment < 0)
+    {
+        const char *hash = memchr(str, '#', len);
+        size_t before = hash ? (size_t)(hash - str) : len;
+
+        if (w->query < 0)
+        {
+            const char *mark = memchr(str, '?', before);
+
+            if (mark)
+            {
+                w->query = (long)(w->len + (size_t)(mark - str));
+            }
+        }
+        if (hash)
+        {
+            w->fragment = (long)(w->len + before);
+        }
+    }
+    put(w, str, len);
+}
+
+/**
+ * Get the length of the first characters of a UTF-8 string.
+ *
+ * @param str: The string.
+ * @param len: The length of the string in bytes.
+ * @param chars: The number of characters.
+ *
+ * @return: The length in bytes of the first `chars` characters.
+ */
+static size_t utf8_prefix(const char *str, size_t len, size_t chars)
+{
+    size_t i;
+
+    for (i = 0; i < len; i++)
+    {
+        /* Continuation bytes do not start a character */
+        if (0x80 != ((unsigned char)str[i] & 0xc0) && 0 == chars--)
+        {
+            break;
+        }
+    }
+
+    return i;
+}
+
+/**
+ * Find the value of a variable.
+ *
+ * @param vars: The variable values.
+ * @param var_count: The number of entries in `vars`.
+ * @param name: The variable name, not null terminated.
+ * @param len: The length of the name.
+ *
+ * @return: The variable, or NULL if not found or undefined.
+ */
+static const struct yuarel_template_var *lookup(const struct yuarel_template_var *vars, size_t var_count,
+                                                const char *name, size_t len)
+{
+    size_t i;
+
+    for (i = 0; i < var_count; i++)
+    {
+        const struct yuarel_template_var *var = &vars[i];
+        size_t j;
+
+        if (NULL == var->name)
+        {
+            continue;
+        }
+        /* Names are short, compare them in place rather than with strncmp() */
+        for (j = 0; j < len && var->name[j] == name[j]; j++)
+        {
+        }
+        if (j == len && '\0' == var->name[len])
+        {
+            if (YUAREL_TEMPLATE_STRING == var->type ? NULL == var->value : 0 == var->count || NULL == var->items)
+            {
+                return NULL;
+            }
+            return var;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Append the '=' after the name of a named value, unless the value is empty
+ * and the operator leaves it out.
+ *
+ * @param w: The writer.
+ * @param oper: The operator of the expression.
+ * @param value: The value, or NULL for a composite value.
+ */
+static inline void put_equals(struct template_writer *w, const struct template_operator *oper, const char *value)
+{
+    if (NULL == value || '\0' != value[0] || oper->ifemp)
+    {
+        put(w, "=", 1);
+    }
+}
+
+/**
+ * Expand one variable of an expression.
+ *
+ * @param w: The writer.
+ * @param oper: The operator of the expression.
+ * @param spec: The variable operation.
+ * @param name: The variable name.
+ * @param var: The value of the variable.
+ */
+static void expand_var(struct template_writer *w, const struct template_operator *oper,
+                       const struct yuarel_template_op *spec, const char *name, const struct yuarel_template_var *var)
+{
+    size_t i;
+
+    if (YUAREL_TEMPLATE_STRING == var->type)
+    {
+        size_t len = strlen(var->value);
+
+        if (oper->named)
+        {
+            put(w, name, spec->len);
+            put_equals(w, oper, var->value);
+        }
+        if (spec->prefix)
+        {
+            len = utf8_prefix(var->value, len, spec->prefix);
+        }
+        put_encoded(w, var->value, len, oper->reserved);
+        return;
+    }
+
+    if (!spec->explode)
+    {
+        /* Items, or keys and values, joined by ',' */
+        size_t count = YUAREL_TEMPLATE_MAP == var->type ? var->count * 2 : var->count;
+
+        if (oper->named)
+        {
+            put(w, name, spec->len);
+            put_equals(w, oper, NULL);
+        }
+        for (i = 0; i < count; i++)
+        {
+            if (i)
+            {
+                put(w, ",", 1);
+            }
+            put_encoded(w, var->items[i], strlen(var->items[i]), oper->reserved);
+        }
+        return;
+    }
+
+    for (i = 0; i < var->count; i++)
+    {
+        if (i)
+        {
+            put_char(w, oper->sep);
+        }
+        if (YUAREL_TEMPLATE_MAP == var->type)
+        {
+            const char *key = var->items[i * 2];
+            const char *value = var->items[i * 2 + 1];
+
+            put_encoded(w, key, strlen(key), oper->reserved);
+            if (oper->named)
+            {
+                put_equals(w, oper, value);
+            }
+            else
+            {
+                put(w, "=", 1);
+            }
+            put_encoded(w, value, strlen(value), oper->reserved);
+        }
+        else
+        {
+            if (oper->named)
+            {
+                put(w, name, spec->len);
+                put_equals(w, oper, var->items[i]);
+            }
+            put_encoded(w, var->items[i], strlen(var->items[i]), oper->reserved);
+        }
+    }
+}
+
+/**
+ * Get the operator of an expression.
+ *
+ * @param op: The operator character, '\0' for simple expansion.
+ *
+ * @return: The operator, or NULL if not supported.
+ */
+static const struct template_operator *find_operator(char op)
+{
+    size_t i;
+
+    for (i = 0; i < sizeof(operators) / sizeof(operators[0]); i++)
+    {
+        if (op == operators[i].op)
+        {
+            return &operators[i];
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Check if a byte may appear in a variable name.
+ *
+ * @param c: The byte.
+ *
+ * @return: 1 if ALPHA, DIGIT or '_', otherwise 0.
+ */
+static inline int is_varchar(char c)
+{
+    return ('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z') || ('0' <= c && c <= '9') || '_' == c;
+}
+
+/**
+ * Parse the variable name and modifier of a variable.
+ *
+ * @param str: The template.
+ * @param pos: The position of the name, updated to just past the modifier.
+ * @param spec: The variable operation to fill in.
+ *
+ * @return: 0 on success, otherwise -1 if invalid.
+ */
+static int compile_var(const char *str, size_t *pos, struct yuarel_template_op *spec)
+{
+    size_t i = *pos;
+
+    memset(spec, 0, sizeof(struct yuarel_template_op));
+    spec->off = (uint32_t)i;
+    spec->kind = YUAREL_TEMPLATE_OP_VARIABLE;
+
+    /* varchar *( ["."] varchar ), where a varchar may be percent-encoded */
+    for (;;)
+    {
+        if (is_varchar(str[i]))
+        {
+            i++;
+        }
+        else if ('%' == str[i] && is_hex(str[i + 1]) && is_hex(str[i + 2]))
+        {
+            i += 3;
+        }
+        else
+        {
+            return -1;
+        }
+
+        if ('.' == str[i])
+        {
+            i++;
+        }
+        else if (!is_varchar(str[i]) && '%' != str[i])
+        {
+            break;
+        }
+    }
+    spec->len = (uint32_t)(i - spec->off);
+
+    if ('*' == str[i])
+    {
+        spec->explode = 1;
+        i++;
+    }
+    else if (':' == str[i])
+    {
+        unsigned prefix = 0;
+        size_t digits = 0;
+
+        for (i++; '0' <= str[i] && str[i] <= '9'; i++, digits++)
+        {
+            prefix = prefix * 10 + (unsigned)(str[i] - '0');
+            if (prefix > PREFIX_MAX)
+            {
+                return -1;
+            }
+        }
+        if (0 == digits || 0 == prefix || '0' == str[i - digits])
+        {
+            return -1;
+        }
+        spec->prefix = (uint16_t)prefix;
+    }
+
+    *pos = i;
+    return 0;
+}
+
+/**
+ * Parse the literal head of a template, so that it need not be parsed again
+ * for every expansion.
+ *
+ * @param tpl: The compiled template. `head_len` is left at 0 if the template
+ *             does not start with a head that parses on its own.
+ */
+static void compile_head(struct yuarel_template *tpl)
+{
+    const struct yuarel_template_op *lit = &tpl->ops[0];
+    const char *str = tpl->str;
+    char copy[HEAD_MAX];
+    struct yuarel url;
+    size_t len, i;
+
+    if (0 == tpl->op_count || YUAREL_TEMPLATE_OP_LITERAL != lit->kind || lit->encode)
+    {
+        return;
+    }
+
+    if ('/' == str[0])
+    {
+        len = 1;
+    }
+    else
+    {
+        const char *end = str + lit->len;
+        const char *p = strstr(str, "://");
+        const char *slash;
+
+        if (NULL == p || p >= end || NULL == (slash = memchr(p + 3, '/', (size_t)(end - p - 3))))
+        {
+            return;
+        }
+        len = (size_t)(slash - str) + 1;
+        if (NULL != memchr(str, '?', len) || NULL != memchr(str, '#', len))
+        {
+            return;
+        }
+    }
+
+    if (len >= HEAD_MAX)
+    {
+        return;
+    }
+    memcpy(copy, str, len);
+    copy[len] = '\0';
+
+    if (-1 == yuarel_parse(&url, copy) || url.path != copy + len || -1 == yuarel_compact_pack(&tpl->head, &url, copy))
+    {
+        return;
+    }
+
+    for (i = 0; i < len; i++)
+    {
+        if ('\0' == copy[i])
+        {
+            if (tpl->head_nul_count == (int)(sizeof(tpl->head_nul) / sizeof(tpl->head_nul[0])))
+            {
+                tpl->head_nul_count = 0;
+                return;
+            }
+            tpl->head_nul[tpl->head_nul_count++] = (uint16_t)i;
+        }
+    }
+    tpl->head_len = len;
+}
+
+/**
+ * @brief Compile a URI template.
+ *
+ * The operations are stored in `ops`, which is provided by the caller and must
+ * outlive the template, as must `str`. A template takes one operation per
+ * literal, per expression and per variable.
+ *
+ * When the template starts with a literal scheme, authority and '/', or with
+ * '/', that head is parsed with yuarel_parse() here, so that expanding to a
+ * `struct yuarel` does not parse it again.
+ *
+ * @param[out] tpl The template to compile into.
+ * @param[in] str The template, e.g. "/users/{id}/items{?limit,offset}".
+ * @param[out] ops Storage for the operations.
+ * @param[in] max_ops The number of entries in `ops`.
+ *
+ * @return 0 on success, otherwise -1 if the template is invalid, has too many
+ *         operations or on error.
+ */
+int yuarel_template_compile(struct yuarel_template *tpl, const char *str, struct yuarel_template_op *ops,
+                            size_t max_ops)
+{
+    size_t i = 0;
+
+    if (NULL == tpl || NULL == str || NULL == ops)
+    {
+        return -1;
+    }
+
+    memset(tpl, 0, sizeof(struct yuarel_template));
+    tpl->str = str;
+    tpl->ops = ops;
+
+    while ('\0' != str[i])
+    {
+        struct yuarel_template_op *op;
+
+        if (tpl->op_count == max_ops || i > UINT32_MAX)
+        {
+            return -1;
+        }
+        op = &ops[tpl->op_count++];
+        memset(op, 0, sizeof(struct yuarel_template_op));
+        op->off = (uint32_t)i;
+
+        if ('{' != str[i])
+        {
+            /* Literal up to the next expression */
+            op->kind = YUAREL_TEMPLATE_OP_LITERAL;
+            for (; '\0' != str[i] && '{' != str[i]; i++)
+            {
+                unsigned char c = (unsigned char)str[i];
+
+                if ('}' == c)
+                {
+                    return -1;
+                }
+                if ('?' == c || '#' == c)
+                {
+                    op->mark = 1;
+                }
+                if (!in_set(unreserved_bits, c) && !in_set(reserved_bits, c) && !is_escape(str, i, i + 3))
+                {
+                    op->encode = 1;
+                }
+            }
+            op->len = (uint32_t)(i - op->off);
+            continue;
+        }
+
+        op->kind = YUAREL_TEMPLATE_OP_EXPRESSION;
+        i++;
+        if ('\0' != str[i] && NULL != strchr("+#./;?&", str[i]))
+        {
+            op->op = str[i++];
+        }
+        else if ('\0' != str[i] && NULL != strchr("=,!@|", str[i]))
+        {
+            /* Reserved for future extensions */
+            return -1;
+        }
+
+        for (;;)
+        {
+            if (tpl->op_count == max_ops)
+            {
+                return -1;
+            }
+            if (-1 == compile_var(str, &i, &ops[tpl->op_count]))
+            {
+                return -1;
+            }
+            tpl->op_count++;
+            op->len++;
+
+            if ('}' == str[i])
+            {
+                i++;
+                break;
+            }
+            if (',' != str[i])
+            {
+                return -1;
+            }
+            i++;
+        }
+    }
+
+    compile_head(tpl);
+    return 0;
+}
+
+/**
+ * @brief Expand a compiled URI template.
+ *
+ * Variables are looked up by name in `vars`. Values are encoded as required
+ * by the operator of their expression: only unreserved characters are kept,
+ * except for the '+' and '#' operators, which also keep reserved characters
+ * and percent escapes. Prefix modifiers count characters, not bytes, of UTF-8
+ * values.
+ *
+ * Like snprintf(), the result is truncated to fit `size` and always null
+ * terminated when `size` is not 0.
+ *
+ * When `url` is not NULL and the result fits, its components are also stored
+ * in `url` as yuarel_parse() would, by null terminating them in `buf`. The
+ * query and fragment are located while expanding, and the head from the
+ * compiled template is reused, so the result is only parsed if the template
+ * did not start with a literal head. If the result does not fit, `url` is
+ * cleared.
+ *
+ * @param[in] tpl The compiled template.
+ * @param[in] vars The variable values.
+ * @param[in] var_count The number of entries in `vars`.
+ * @param[out] buf The buffer to write the expansion to.
+ * @param[in] size The size of `buf`.
+ * @param[out] url Where to store the components of the result, or NULL.
+ *
+ * @return The length of the full expansion, or -1 on error, or if `url` is
+ *         given and the result is not a valid URL.
+ */
+long yuarel_template_expand(const struct yuarel_template *tpl, const struct yuarel_template_var *vars,
+                            size_t var_count, char *buf, size_t size, struct yuarel *url)
+{
+    struct template_writer w;
+    size_t i, j;
+
+    if (NULL == tpl || (NULL == vars && var_count) || (NULL == buf && size))
+    {
+        return -1;
+    }
+
+    w.buf = buf;
+    w.size = size;
+    w.len = 0;
+    w.query = -1;
+    w.fragment = -1;
+
+    for (i = 0; i < tpl->op_count; i++)
+    {
+        const struct yuarel_template_op *op = &tpl->ops[i];
+        const struct template_operator *oper;
+        int first = 1;
+
+        if (YUAREL_TEMPLATE_OP_LITERAL == op->kind)
+        {
+            if (op->encode)
+            {
+                put_encoded(&w, tpl->str + op->off, op->len, 1);
+            }
+            else if (op->mark)
+            {
+                put_literal(&w, tpl->str + op->off, op->len);
+            }
+            else
+            {
+                put(&w, tpl->str + op->off, op->len);
+            }
+            continue;
+        }
+
+        oper = find_operator(op->op);
+        for (j = 0; j < op->len; j++)
+        {
+            const struct yuarel_template_op *spec = &tpl->ops[i + 1 + j];
+            const char *name = tpl->str + spec->off;
+            const struct yuarel_template_var *var = lookup(vars, var_count, name, spec->len);
+
+            if (NULL == var)
+            {
+                continue;
+            }
+            if (!first)
+            {
+                put_char(&w, oper->sep);
+            }
+            else if ('\0' != oper->first)
+            {
+                put_char(&w, oper->first);
+            }
+            first = 0;
+            expand_var(&w, oper, spec, name, var);
+        }
+        i += op->len;
+    }
+
+    if (size)
+    {
+        buf[w.len < size ? w.len : size - 1] = '\0';
+    }
+
+    if (NULL == url)
+    {
+        return (long)w.len;
+    }
+    if (w.len >= size)
+    {
+        memset(url, 0, sizeof(struct yuarel));
+        return (long)w.len;
+    }
+    if (0 == tpl->head_len)
+    {
+        return -1 == yuarel_parse(url, buf) ? -1 : (long)w.len;
+    }
+
+    /* Null terminate as parsing the head did, and the query and fragment */
+    for (j = 0; j < (size_t)tpl->head_nul_count; j++)
+    {
+        buf[tpl->head_nul[j]] = '\0';
+    }
+    if (w.query >= 0)
+    {
+        buf[w.query] = '\0';
+    }
+    if (w.fragment >= 0)
+    {
+        buf[w.fragment] = '\0';
+    }
+    yuarel_compact_unpack(url, &tpl->head, buf);
+    url->query = w.query >= 0 ? buf + w.query + 1 : NULL;
+    url->fragment = w.fragment >= 0 ? buf + w.fragment + 1 : NULL;
+
+    return (long)w.len;
+}
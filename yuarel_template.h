@@ -0,0 +1,165 @@
+/**
+ * @file yuarel_template.h
+ * @brief RFC 6570 URI templates, compiled once and expanded into a caller buffer.
+ *
+ * A template such as "/users/{id}/items{?limit,offset}" is split into a list
+ * of literal and expression operations once. Expanding it walks that list and
+ * encodes each value as its operator requires, levels 1 to 4 of RFC 6570.
+ *
+ * @copyright Copyright (C) 2016 Jack Engqvist Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef INC_YUAREL_TEMPLATE_H
+#define INC_YUAREL_TEMPLATE_H
+
+#include "yuarel.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** @brief Template value type: a single string */
+#define YUAREL_TEMPLATE_STRING 0
+
+/** @brief Template value type: a list of strings */
+#define YUAREL_TEMPLATE_LIST 1
+
+/** @brief Template value type: an associative array of key-value pairs */
+#define YUAREL_TEMPLATE_MAP 2
+
+/** @brief Template operation: literal text */
+#define YUAREL_TEMPLATE_OP_LITERAL 0
+
+/** @brief Template operation: an expression, followed by its variables */
+#define YUAREL_TEMPLATE_OP_EXPRESSION 1
+
+/** @brief Template operation: a variable of the preceding expression */
+#define YUAREL_TEMPLATE_OP_VARIABLE 2
+
+/**
+ * @struct yuarel_template_op
+ * @brief One operation of a compiled template.
+ */
+struct yuarel_template_op
+{
+    uint32_t off;    /**< @brief Offset of the literal or variable name in the template */
+    uint32_t len;    /**< @brief Length of the literal or name, number of variables of an expression */
+    uint16_t prefix; /**< @brief Prefix length of a variable, 0 for the whole value */
+    uint8_t kind;    /**< @brief One of the YUAREL_TEMPLATE_OP_* values */
+    char op;         /**< @brief Operator of an expression, '\0' for simple expansion */
+    uint8_t explode; /**< @brief 1 if a variable has the explode modifier '*' */
+    uint8_t encode;  /**< @brief 1 if a literal has characters to encode */
+    uint8_t mark;    /**< @brief 1 if a literal has a '?' or '#' */
+};
+
+/**
+ * @struct yuarel_template
+ * @brief A compiled URI template.
+ */
+struct yuarel_template
+{
+    const char *str;                /**< @brief The template, must outlive the compiled form */
+    struct yuarel_template_op *ops; /**< @brief Operations, provided by the caller */
+    size_t op_count;                /**< @brief Number of operations in use */
+    size_t head_len;                /**< @brief Length of the literal scheme, authority and first '/', or 0 */
+    struct yuarel_compact head;     /**< @brief The parsed head, when `head_len` is not 0 */
+    uint16_t head_nul[8];           /**< @brief Offsets where parsing the head inserts null terminators */
+    int head_nul_count;             /**< @brief Number of entries in `head_nul` */
+};
+
+/**
+ * @struct yuarel_template_var
+ * @brief The value of a template variable.
+ *
+ * A variable with a NULL string value, or a list or map with no items, is
+ * undefined and expands to nothing.
+ */
+struct yuarel_template_var
+{
+    const char *name;         /**< @brief The variable name */
+    int type;                 /**< @brief One of the YUAREL_TEMPLATE_STRING, _LIST and _MAP values */
+    const char *value;        /**< @brief The value of a string */
+    const char *const *items; /**< @brief The items of a list, or keys and values alternating for a map */
+    size_t count;             /**< @brief The number of items of a list, or pairs of a map */
+};
+
+/**
+ * @brief Compile a URI template.
+ *
+ * The operations are stored in `ops`, which is provided by the caller and must
+ * outlive the template, as must `str`. A template takes one operation per
+ * literal, per expression and per variable.
+ *
+ * When the template starts with a literal scheme, authority and '/', or with
+ * '/', that head is parsed with yuarel_parse() here, so that expanding to a
+ * `struct yuarel` does not parse it again.
+ *
+ * @param[out] tpl The template to compile into.
+ * @param[in] str The template, e.g. "/users/{id}/items{?limit,offset}".
+ * @param[out] ops Storage for the operations.
+ * @param[in] max_ops The number of entries in `ops`.
+ *
+ * @return 0 on success, otherwise -1 if the template is invalid, has too many
+ *         operations or on error.
+ */
+extern int yuarel_template_compile(struct yuarel_template *tpl, const char *str, struct yuarel_template_op *ops,
+                                   size_t max_ops);
+
+/**
+ * @brief Expand a compiled URI template.
+ *
+ * Variables are looked up by name in `vars`. Values are encoded as required
+ * by the operator of their expression: only unreserved characters are kept,
+ * except for the '+' and '#' operators, which also keep reserved characters
+ * and percent escapes. Prefix modifiers count characters, not bytes, of UTF-8
+ * values.
+ *
+ * Like snprintf(), the result is truncated to fit `size` and always null
+ * terminated when `size` is not 0.
+ *
+ * When `url` is not NULL and the result fits, its components are also stored
+ * in `url` as yuarel_parse() would, by null terminating them in `buf`. The
+ * query and fragment are located while expanding, and the head from the
+ * compiled template is reused, so the result is only parsed if the template
+ * did not start with a literal head. If the result does not fit, `url` is
+ * cleared.
+ *
+ * @param[in] tpl The compiled template.
+ * @param[in] vars The variable values.
+ * @param[in] var_count The number of entries in `vars`.
+ * @param[out] buf The buffer to write the expansion to.
+ * @param[in] size The size of `buf`.
+ * @param[out] url Where to store the components of the result, or NULL.
+ *
+ * @return The length of the full expansion, or -1 on error, or if `url` is
+ *         given and the result is not a valid URL.
+ */
+extern long yuarel_template_expand(const struct yuarel_template *tpl, const struct yuarel_template_var *vars,
+                                   size_t var_count, char *buf, size_t size, struct yuarel *url);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_YUAREL_TEMPLATE_H */
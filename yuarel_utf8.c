@@ -0,0 +1,541 @@
+/**
+ * Copyright (C) 2016,2017 Jack Engqvist Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "yuarel_utf8.h"
+#include "yuarel_internal.h"
+#include <stdint.h>
+#include <string.h>
+
+#ifdef YUAREL_X86
+#include <immintrin.h>
+#endif
+
+/**
+ * Check if a byte is a UTF-8 continuation byte (10xxxxxx).
+ *
+ * @param c: The byte to check.
+ *
+ * @return: 1 if it is a continuation byte, otherwise 0.
+ */
+static inline int is_continuation(unsigned char c) { return 0x80 == (c & 0xc0); }
+
+/**
+ * Decode the next character of a percent-encoded string, like
+ * yuarel_url_decode().
+ *
+ * @param read: The next byte to read, moved past the character.
+ * @param write: Where the decoded byte goes, moved past it.
+ */
+static inline __attribute__((always_inline)) void decode_one(const char **read, char **write)
+{
+    const char *r = *read;
+    int hi, lo;
+
+    if ('+' == *r)
+    {
+        *(*write)++ = ' ';
+        *read = r + 1;
+    }
+    else if ('%' == *r && (hi = hex_value(r[1])) >= 0 && (lo = hex_value(r[2])) >= 0)
+    {
+        *(*write)++ = (char)(hi << 4 | lo);
+        *read = r + 3;
+    }
+    else
+    {
+        *(*write)++ = *r;
+        *read = r + 1;
+    }
+}
+
+/**
+ * Validate UTF-8 one sequence at a time, following the table of well-formed
+ * byte sequences in RFC 3629. Runs of ASCII are skipped 8 bytes at a time.
+ *
+ * @param s: The bytes to check.
+ * @param len: The number of bytes in `s`.
+ * @param i: Where to start, must be the first byte of a sequence.
+ *
+ * @return: The offset of the first byte of the first invalid sequence, or `len`.
+ */
+static size_t validate_scalar(const unsigned char *s, size_t len, size_t i)
+{
+    for (;;)
+    {
+        unsigned char c;
+        unsigned char lo = 0x80;
+        unsigned char hi = 0xbf;
+        size_t n;
+        size_t k;
+
+        while (i + 8 <= len)
+        {
+            uint64_t word;
+
+            memcpy(&word, s + i, 8);
+            if (word & 0x8080808080808080ULL)
+            {
+                break;
+            }
+            i += 8;
+        }
+
+        if (i >= len)
+        {
+            return len;
+        }
+
+        c = s[i];
+        if (c < 0x80)
+        {
+            i++;
+            continue;
+        }
+
+        /* Number of continuation bytes, and the range of the first one */
+        if (c < 0xc2)
+        {
+            /* Continuation byte, or overlong two byte sequence */
+            return i;
+        }
+        else if (c < 0xe0)
+        {
+            n = 1;
+        }
+        else if (c < 0xf0)
+        {
+            n = 2;
+            lo = (0xe0 == c) ? 0xa0 : 0x80; /* Overlong */
+            hi = (0xed == c) ? 0x9f : 0xbf; /* Surrogates */
+        }
+        else if (c < 0xf5)
+        {
+            n = 3;
+            lo = (0xf0 == c) ? 0x90 : 0x80; /* Overlong */
+            hi = (0xf4 == c) ? 0x8f : 0xbf; /* Above U+10FFFF */
+        }
+        else
+        {
+            return i;
+        }
+
+        if (n >= len - i || s[i + 1] < lo || s[i + 1] > hi)
+        {
+            return i;
+        }
+        for (k = 2; k <= n; k++)
+        {
+            if (!is_continuation(s[i + k]))
+            {
+                return i;
+            }
+        }
+        i += n + 1;
+    }
+}
+
+#ifdef YUAREL_X86
+/*
+ * Lookup-table validation as described by Keiser and Lemire, "Validating
+ * UTF-8 In Less Than One Instruction Per Byte", and used by simdutf. Each
+ * pair of consecutive bytes is classified by the high nibble of the first
+ * byte, its low nibble and the high nibble of the second byte. The three
+ * table lookups are ANDed, and any bit left set is an error, except that two
+ * continuation bytes in a row must match the third and fourth bytes of a
+ * sequence. It needs SSSE3, and is used with the avx2 and avx512bw kernels
+ * of yuarel_simd_kernel(), whose CPUs all have it, and with the sse2 kernel
+ * on CPUs that have it, unless that kernel was asked for by name.
+ */
+#define UTF8_SSSE3 __attribute__((target("ssse3")))
+#define TOO_SHORT (1 << 0)      /* Lead byte followed by a lead byte or ASCII */
+#define TOO_LONG (1 << 1)       /* ASCII followed by a continuation byte */
+#define OVERLONG_3 (1 << 2)     /* E0 80..9F */
+#define TOO_LARGE (1 << 3)      /* F4 90..BF, F5..FF */
+#define SURROGATE (1 << 4)      /* ED A0..BF */
+#define OVERLONG_2 (1 << 5)     /* C0..C1 */
+#define TOO_LARGE_1000 (1 << 6) /* F5..FF 80..8F */
+#define OVERLONG_4 (1 << 6)     /* F0 80..8F */
+#define TWO_CONTS (1 << 7)      /* Two continuation bytes */
+#define CARRY (TOO_SHORT | TOO_LONG | TWO_CONTS)
+
+/**
+ * Find the first invalid sequence once the block starting at `block` is known
+ * to contain an error, or to end within a sequence. Everything before the
+ * block was checked already, so validation restarts at the last sequence that
+ * begins before it.
+ *
+ * @param s: The bytes to check.
+ * @param len: The number of bytes in `s`.
+ * @param block: The offset of the block with the error.
+ *
+ * @return: The offset of the first byte of the first invalid sequence.
+ */
+static size_t locate_error(const unsigned char *s, size_t len, size_t block)
+{
+    size_t start = block;
+
+    while (start > 0 && block - start < 3 && is_continuation(s[start - 1]))
+    {
+        start--;
+    }
+    if (start > 0 && block - start < 4 && s[start - 1] >= 0xc0)
+    {
+        start--;
+    }
+
+    return validate_scalar(s, len, start);
+}
+
+/* Errors by the high nibble of the first byte of a pair */
+static const unsigned char byte_1_high_table[16] = {
+    TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+    TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS,
+    TOO_SHORT | OVERLONG_2,
+    TOO_SHORT,
+    TOO_SHORT | OVERLONG_3 | SURROGATE,
+    TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4};
+
+/* Errors by the low nibble of the first byte of a pair */
+static const unsigned char byte_1_low_table[16] = {
+    CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4,
+    CARRY | OVERLONG_2,
+    CARRY,
+    CARRY,
+    CARRY | TOO_LARGE,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000};
+
+/* Errors by the high nibble of the second byte of a pair */
+static const unsigned char byte_2_high_table[16] = {
+    TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4,
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE,
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+    TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT};
+
+/* Bytes at the end of a block that leave a sequence open */
+static const unsigned char max_value_table[16] = {
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf0 - 1, 0xe0 - 1, 0xc0 - 1};
+
+/**
+ * @brief The state of the vector validator between blocks.
+ */
+struct utf8_checker
+{
+    __m128i error;           /* Non-zero once an error has been seen */
+    __m128i prev_input;      /* The previous block */
+    __m128i prev_incomplete; /* Non-zero if the previous block ends within a sequence */
+};
+
+/**
+ * Shift every byte right by four bits.
+ *
+ * @param v: The bytes to shift.
+ *
+ * @return: The high nibble of every byte.
+ */
+static inline UTF8_SSSE3 __m128i high_nibbles(__m128i v)
+{
+    return _mm_and_si128(_mm_srli_epi16(v, 4), _mm_set1_epi8(0x0f));
+}
+
+/**
+ * Check the next 16 bytes.
+ *
+ * @param c: The validator.
+ * @param input: The next block.
+ */
+static inline UTF8_SSSE3 void check_block(struct utf8_checker *c, __m128i input)
+{
+    const __m128i byte_1_high = _mm_loadu_si128((const __m128i *)byte_1_high_table);
+    const __m128i byte_1_low = _mm_loadu_si128((const __m128i *)byte_1_low_table);
+    const __m128i byte_2_high = _mm_loadu_si128((const __m128i *)byte_2_high_table);
+    __m128i prev1, prev2, prev3, special, must23;
+
+    if (0 == _mm_movemask_epi8(input))
+    {
+        /* ASCII, only a sequence left open by the previous block is an error */
+        c->error = _mm_or_si128(c->error, c->prev_incomplete);
+        c->prev_incomplete = _mm_setzero_si128();
+        c->prev_input = input;
+        return;
+    }
+
+    prev1 = _mm_alignr_epi8(input, c->prev_input, 15);
+    special = _mm_and_si128(_mm_and_si128(_mm_shuffle_epi8(byte_1_high, high_nibbles(prev1)),
+                                          _mm_shuffle_epi8(byte_1_low, _mm_and_si128(prev1, _mm_set1_epi8(0x0f)))),
+                            _mm_shuffle_epi8(byte_2_high, high_nibbles(input)));
+
+    /* Only 111xxxxx two bytes back and 1111xxxx three bytes back stay >= 0x80 */
+    prev2 = _mm_alignr_epi8(input, c->prev_input, 14);
+    prev3 = _mm_alignr_epi8(input, c->prev_input, 13);
+    must23 = _mm_or_si128(_mm_subs_epu8(prev2, _mm_set1_epi8(0xe0 - 0x80)), _mm_subs_epu8(prev3, _mm_set1_epi8((char)(0xf0 - 0x80))));
+    must23 = _mm_and_si128(must23, _mm_set1_epi8((char)0x80));
+
+    c->error = _mm_or_si128(c->error, _mm_xor_si128(must23, special));
+    c->prev_incomplete = _mm_subs_epu8(input, _mm_loadu_si128((const __m128i *)max_value_table));
+    c->prev_input = input;
+}
+
+/**
+ * Check a block of fewer than 16 bytes, padded with NUL bytes.
+ *
+ * @param c: The validator.
+ * @param str: The bytes to check.
+ * @param len: The number of bytes, less than 16.
+ */
+static inline UTF8_SSSE3 void check_tail(struct utf8_checker *c, const char *str, size_t len)
+{
+    char buf[16] = {0};
+
+    memcpy(buf, str, len);
+    check_block(c, _mm_loadu_si128((const __m128i *)buf));
+}
+
+/**
+ * Check if the validator has seen an error.
+ *
+ * @param c: The validator.
+ *
+ * @return: 1 if there was an error, otherwise 0.
+ */
+static inline UTF8_SSSE3 int has_error(const struct utf8_checker *c)
+{
+    return 0xffff != _mm_movemask_epi8(_mm_cmpeq_epi8(c->error, _mm_setzero_si128()));
+}
+
+/**
+ * Validate UTF-8 16 bytes at a time.
+ *
+ * @param str: The bytes to check.
+ * @param len: The number of bytes in `str`.
+ *
+ * @return: The offset of the first byte of the first invalid sequence, or `len`.
+ */
+static UTF8_SSSE3 size_t validate_ssse3(const char *str, size_t len)
+{
+    struct utf8_checker c;
+    size_t block = 0;
+
+    memset(&c, 0, sizeof(c));
+    for (; block + 16 <= len; block += 16)
+    {
+        check_block(&c, _mm_loadu_si128((const __m128i *)(str + block)));
+        if (has_error(&c))
+        {
+            break;
+        }
+    }
+
+    if (block + 16 > len)
+    {
+        if (block < len)
+        {
+            check_tail(&c, str + block, len - block);
+        }
+        c.error = _mm_or_si128(c.error, c.prev_incomplete);
+    }
+
+    if (!has_error(&c))
+    {
+        return len;
+    }
+    return locate_error((const unsigned char *)str, len, (block < len || 0 == block) ? block : block - 16);
+}
+
+/**
+ * Percent-decode a string in place, and validate the decoded bytes 16 at a
+ * time as they are written.
+ *
+ * @param str: The string to decode.
+ * @param len: Set to the length of the decoded string.
+ *
+ * @return: The offset of the first byte of the first invalid sequence in the
+ *          decoded string, or its length.
+ */
+static UTF8_SSSE3 size_t decode_ssse3(char *str, size_t *len)
+{
+    struct utf8_checker c;
+    const char *read = str;
+    char *write = str;
+    char *checked = str; /* Decoded bytes before this are checked */
+    int failed = 0;
+
+    memset(&c, 0, sizeof(c));
+    while ('\0' != *read)
+    {
+        decode_one(&read, &write);
+
+        if (16 == write - checked && !failed)
+        {
+            check_block(&c, _mm_loadu_si128((const __m128i *)checked));
+            failed = has_error(&c);
+            if (!failed)
+            {
+                checked += 16;
+            }
+        }
+    }
+    *write = '\0';
+    *len = write - str;
+
+    if (!failed)
+    {
+        if (checked < write)
+        {
+            check_tail(&c, checked, write - checked);
+        }
+        c.error = _mm_or_si128(c.error, c.prev_incomplete);
+        if (!has_error(&c))
+        {
+            return *len;
+        }
+    }
+    return locate_error((const unsigned char *)str, *len,
+                        (checked < write || checked == str) ? checked - str : checked - str - 16);
+}
+#endif
+
+/**
+ * Check if the lookup-table validator can be used.
+ *
+ * @return: 1 if SSSE3 may run along with the SIMD kernel in use, otherwise 0.
+ */
+static inline int use_ssse3(void)
+{
+#ifdef YUAREL_X86
+    return yuarel_simd_ssse3();
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @brief Check if a string is well-formed UTF-8.
+ *
+ * For components that contain no escapes, or that were already decoded. NUL
+ * bytes are valid and do not end the string.
+ *
+ * @param[in] str The bytes to check.
+ * @param[in] len The number of bytes in `str`.
+ * @param[out] error_offset Set to the offset of the first byte of the first
+ *             invalid sequence when the string is invalid. May be NULL.
+ *
+ * @return 1 if `str` is valid UTF-8, otherwise 0.
+ */
+int yuarel_utf8_valid(const char *str, size_t len, size_t *error_offset)
+{
+    size_t offset;
+
+    if (NULL == str)
+    {
+        return 0 == len;
+    }
+
+#ifdef YUAREL_X86
+    if (use_ssse3())
+    {
+        offset = validate_ssse3(str, len);
+    }
+    else
+#endif
+    {
+        offset = validate_scalar((const unsigned char *)str, len, 0);
+    }
+
+    if (offset == len)
+    {
+        return 1;
+    }
+    if (NULL != error_offset)
+    {
+        *error_offset = offset;
+    }
+    return 0;
+}
+
+/**
+ * @brief Decode a percent-encoded string in place and check that the result
+ *        is well-formed UTF-8.
+ *
+ * Decodes like yuarel_url_decode(), and checks the decoded bytes 16 at a time
+ * as they are written, instead of in a second pass.
+ *
+ * @warning: Modifies the input string as part of the parsing process.
+ *
+ * @param[in,out] str The string to decode. The string will be modified.
+ * @param[out] error_offset Set to the offset in the decoded string of the first
+ *             byte of the first invalid sequence when the result is invalid.
+ *             May be NULL.
+ *
+ * @return `str` if the decoded string is valid UTF-8, otherwise NULL. The
+ *         string is decoded completely in both cases.
+ */
+char *yuarel_url_decode_utf8(char *str, size_t *error_offset)
+{
+    size_t offset;
+    size_t len;
+
+    if (NULL == str)
+    {
+        return NULL;
+    }
+
+#ifdef YUAREL_X86
+    if (use_ssse3())
+    {
+        offset = decode_ssse3(str, &len);
+    }
+    else
+#endif
+    {
+        const char *read = str;
+        char *write = str;
+
+        while ('\0' != *read)
+        {
+            decode_one(&read, &write);
+        }
+        *write = '\0';
+        len = write - str;
+        offset = validate_scalar((const unsigned char *)str, len, 0);
+    }
+
+    if (offset == len)
+    {
+        return str;
+    }
+    if (NULL != error_offset)
+    {
+        *error_offset = offset;
+    }
+    return NULL;
+}
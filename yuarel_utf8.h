@@ -0,0 +1,82 @@
+/**
+ * @file yuarel_utf8.h
+ * @brief UTF-8 validation of URL components.
+ *
+ * Checks that a component, or the bytes produced by percent-decoding it, are
+ * well-formed UTF-8: no stray continuation bytes, truncated or overlong
+ * sequences, surrogates or code points above U+10FFFF. When the CPU has
+ * SSSE3 and yuarel_simd_kernel() is not "scalar", or "sse2" forced with
+ * YUAREL_FORCE_ISA or yuarel_simd_select(), 16 bytes are checked at a time
+ * with the lookup-table method of simdutf, compiled for SSSE3.
+ *
+ * @copyright Copyright (C) 2016 Jack Engqvist Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef INC_YUAREL_UTF8_H
+#define INC_YUAREL_UTF8_H
+
+#include "yuarel.h"
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief Check if a string is well-formed UTF-8.
+ *
+ * For components that contain no escapes, or that were already decoded. NUL
+ * bytes are valid and do not end the string.
+ *
+ * @param[in] str The bytes to check.
+ * @param[in] len The number of bytes in `str`.
+ * @param[out] error_offset Set to the offset of the first byte of the first
+ *             invalid sequence when the string is invalid. May be NULL.
+ *
+ * @return 1 if `str` is valid UTF-8, otherwise 0.
+ */
+extern int yuarel_utf8_valid(const char *str, size_t len, size_t *error_offset);
+
+/**
+ * @brief Decode a percent-encoded string in place and check that the result
+ *        is well-formed UTF-8.
+ *
+ * Decodes like yuarel_url_decode(), and checks the decoded bytes 16 at a time
+ * as they are written, instead of in a second pass.
+ *
+ * @warning: Modifies the input string as part of the parsing process.
+ *
+ * @param[in,out] str The string to decode. The string will be modified.
+ * @param[out] error_offset Set to the offset in the decoded string of the first
+ *             byte of the first invalid sequence when the result is invalid.
+ *             May be NULL.
+ *
+ * @return `str` if the decoded string is valid UTF-8, otherwise NULL. The
+ *         string is decoded completely in both cases.
+ */
+extern char *yuarel_url_decode_utf8(char *str, size_t *error_offset);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_YUAREL_UTF8_H */